@@ -2,12 +2,17 @@
 #define INGA_H
 
 #include "core/log.h"
+#include "core/allocator.h"
+#include "core/job.h"
+#include "core/profiler.h"
+#include "core/time.h"
 #include <exception>
 
 namespace Inga
 {
 #ifndef _WIN32
     inline void signalHandler(int sig) {
+        Log::flush();
         INGA_LOG(eFATAL, "PANIC", "Signal %d received (Hard Crash). Flushing logs...", sig);
         Log::terminate();
         Allocator::stop();
@@ -22,6 +27,14 @@ namespace Inga
         LogLevel logLevel ;
         LogOutput logOutput ;
         const char* logFile ;
+        LogMode logMode ;
+        LogOverflow logOverflow ;
+        U32 logQueueSize ;      // Nombre de messages en attente en mode async
+        U32 workerCount ;       // 0 = nombre de coeurs - 1
+        U32 maxJobsPerThread ;
+        U32 profilerEventsPerThread ; // 0 = profiler désactivé
+        bool profilerHardwareCounters ; // compteurs matériels par zone (Linux)
+        U32 profilerCaptureSignalFrames ; // SIGUSR1 capture N frames (POSIX) ; 0 = pas de handler
     };
 
     EngineConfig INGA_API getDefaultEngineConfig();
@@ -63,11 +76,17 @@ namespace Inga
 
 #define INGA_BEGIN(conf) \
     if (!Inga::Allocator::start(conf.maxPageCount, conf.pageSize)) return -1; \
-    Inga::Log::init(conf.logLevel, conf.logOutput, conf.logFile); \
+    Inga::Log::init(conf.logLevel, conf.logOutput, conf.logFile, conf.logMode, conf.logOverflow, conf.logQueueSize); \
+    Inga::Profiler::setHardwareCounters(conf.profilerHardwareCounters); \
+    if (conf.profilerEventsPerThread > 0) Inga::Profiler::start(conf.profilerEventsPerThread); \
+    if (conf.profilerEventsPerThread > 0 && conf.profilerCaptureSignalFrames > 0) Inga::Profiler::installCaptureSignal(conf.profilerCaptureSignalFrames); \
+    Inga::JobSystem::start(conf.workerCount, conf.maxJobsPerThread); \
     INGA_PLATFORM_BEGIN
 
 #define INGA_END() \
     INGA_PLATFORM_END \
+    Inga::JobSystem::stop(); \
+    Inga::Profiler::stop(); \
     Inga::Log::terminate(); \
     Inga::Allocator::stop(); \
     return _inga_result;
@@ -14,6 +14,28 @@ namespace Inga
         U64 PageSize;
     };
 
+    enum AllocationEventType : U8
+    {
+        eALLOCATION_ALLOC,
+        eALLOCATION_FREE,
+        eALLOCATION_REALLOC
+    };
+
+    // Un appel externe à alloc/free/realloc (durées en ticks de Inga::Time)
+    struct AllocationEvent
+    {
+        U64 startTicks;
+        U64 durationTicks;
+        U64 lockWaitTicks;   // attente des verrous de groupe, incluse dans durationTicks
+        U64 size;            // taille demandée, ou taille du bloc libéré
+        void* ptr;           // bloc obtenu (nullptr si échec), ou bloc libéré
+        void* oldPtr;        // realloc : ancien bloc
+        U16 groupId;
+        AllocationEventType type;
+    };
+
+    typedef void (*AllocationEventHook)(const AllocationEvent& event, void* userData);
+
     class INGA_API Allocator
     {
     public:
@@ -24,14 +46,28 @@ namespace Inga
         // Gestion des groupes
         static U16 addGroup(const AllocationGroupInfo& info);
         static U16 setGroupIdByName(const char* name);
+        // Comme setGroupIdByName, sans message d'erreur : pour tester l'existence d'un groupe
+        static U16 findGroupId(const char* name);
 
         // Fonctions d'allocation de base (Le moteur utilise celles-ci)
         static void* alloc(U64 size, U32 align, U16 groupId, const char* file, I32 line);
         static void* realloc(void* ptr, U64 size, U32 align, const char* file, I32 line);
         static void  free(void* ptr);
 
+        // Nom du groupe (nullptr si l'id est invalide)
+        static const char* getGroupName(U16 groupId);
+
         // Monitoring et Debug
         static void printStats();
+
+        /*
+         * Hook appelé après chaque alloc/free/realloc (un seul à la fois,
+         * nullptr pour le retirer). Sans hook, le coût est un test par appel.
+         * Les appels internes (realloc, nouvelle page) et les allocations
+         * faites depuis le hook lui-même ne sont pas rapportés.
+         * Après un retrait, un appel déjà en cours peut encore utiliser l'ancien hook.
+         */
+        static void setEventHook(AllocationEventHook hook, void* userData = nullptr);
     };
 }
 
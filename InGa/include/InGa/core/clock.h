@@ -2,7 +2,8 @@
 #define INGA_CLOCK_H
 
 #include <InGa/core/export.h>
-#include <chrono>
+#include <InGa/core/inga_platform.h>
+#include <InGa/core/frame_stats.h>
 
 namespace Inga
 {
@@ -20,20 +21,92 @@ namespace Inga
         // Temps total depuis le démarrage du moteur
         double getTotalTime() const { return m_totalTime; }
 
+        // Durées réelles des frames (sans timeScale) alimentées par tick()
+        FrameStats& getFrameStats() { return m_frameStats; }
+        const FrameStats& getFrameStats() const { return m_frameStats; }
+
         // Permet de ralentir ou d'accélérer le temps (ex: 0.5f pour un bullet time)
         void setTimeScale(float scale) { m_timeScale = scale; }
         float getTimeScale() const { return m_timeScale; }
 
-    private:
-        using HighResClock = std::chrono::high_resolution_clock;
-        using TimePoint = std::chrono::time_point<HighResClock>;
+        /*
+         * Pas fixe : tick() accumule le temps (avec timeScale), la simulation
+         * consomme des pas constants, le rendu interpole entre les deux derniers.
+         *
+         *   clock.tick();
+         *   while (clock.consumeFixedStep()) simulate(clock.getFixedTimeStep());
+         *   render(clock.getInterpolationAlpha());
+         *
+         * Au-delà de maxStepsPerFrame pas dans une frame, le retard est abandonné
+         * (la simulation ralentit au lieu de partir en "spiral of death").
+         */
+        void setFixedTimeStep(double step, U32 maxStepsPerFrame = 5);
+        double getFixedTimeStep() const { return m_fixedStep; }
+
+        bool consumeFixedStep();
 
-        TimePoint m_startTime;
-        TimePoint m_lastTime;
+        // Position entre le dernier état simulé et le suivant, dans [0, 1)
+        float getInterpolationAlpha() const;
+
+        U64 getFixedStepIndex() const { return m_fixedStepIndex; }   // pas simulés depuis le départ
+        U32 getFixedStepsThisFrame() const { return m_fixedStepsThisFrame; }
+        double getDroppedTime() const { return m_droppedTime; }     // retard abandonné (s)
+
+    private:
+        // Ticks de Time::now() (voir core/time.h)
+        U64 m_startTicks;
+        U64 m_lastTicks;
 
         float m_deltaTime;
         double m_totalTime;
         float m_timeScale;
+
+        double m_fixedStep;
+        double m_accumulator;
+        double m_droppedTime;
+        U64 m_fixedStepIndex;
+        U32 m_maxFixedSteps;
+        U32 m_fixedStepsThisFrame;
+
+        FrameStats m_frameStats;
+    };
+
+    /*
+     * FrameLimiter : cadence la boucle sur une durée de frame cible.
+     * wait() dort par tranches de 1 ms tant que l'échéance est loin, puis finit
+     * en attente active. La marge d'attente active est la durée moyenne d'une
+     * tranche + 2 écarts-types, mesurés en continu : peu de CPU brûlé et
+     * échéance tenue à quelques µs, même quand le sommeil de l'OS est bruité.
+     *
+     *   FrameLimiter limiter(144.0);
+     *   for (;;) { clock.tick(); ...; limiter.wait(); }
+     */
+    class INGA_API FrameLimiter
+    {
+    public:
+        explicit FrameLimiter(double targetFrameRate = 0.0);
+
+        // 0 = pas de limite
+        void setTargetFrameRate(double framesPerSecond);
+        double getTargetFrameRate() const { return m_targetFrameRate; }
+
+        // Attente active minimale avant l'échéance (secondes)
+        void setMinSpinTime(double seconds);
+
+        // Fin de frame : attend l'échéance suivante
+        void wait();
+
+        double getLastWaitTime() const { return m_lastWait; }   // secondes attendues
+        double getSpinTime() const;                             // marge d'attente active actuelle
+
+    private:
+        double m_targetFrameRate;
+        U64 m_periodTicks;
+        U64 m_deadline;
+        U64 m_minSpinTicks;
+        double m_sleepMeanNs;       // durée réelle d'une tranche de sommeil (moyenne glissante)
+        double m_sleepVarianceNs;
+        double m_lastWait;
     };
 }
 
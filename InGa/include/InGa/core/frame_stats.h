@@ -0,0 +1,95 @@
+#ifndef INGA_FRAME_STATS_H
+#define INGA_FRAME_STATS_H
+
+#include "export.h"
+#include "inga_platform.h"
+
+namespace Inga
+{
+    // Résumé de la fenêtre glissante (temps en ms)
+    struct FrameStatsSummary
+    {
+        U32 frameCount;      // frames dans la fenêtre
+        F64 averageMs;
+        F64 minMs;
+        F64 maxMs;
+        F64 p50Ms;
+        F64 p95Ms;
+        F64 p99Ms;
+        F64 averageFps;
+        F64 low1PercentFps;  // FPS moyen des 1 % de frames les plus lentes
+        U64 hitchCount;      // depuis le départ
+    };
+
+    struct FrameHitch
+    {
+        U64 frameIndex;
+        F64 frameMs;
+        F64 medianMs;        // médiane de la fenêtre au moment du hitch
+    };
+
+    typedef void (*FrameHitchCallback)(const FrameHitch& hitch, void* userData);
+
+    /*
+     * FrameStats : durées des WINDOW_SIZE dernières frames + histogramme
+     * log-linéaire (1 µs de résolution sous 256 µs, puis 128 classes par
+     * octave, < 1 % d'erreur, jusqu'à ~16 s). addFrame() est O(1) : la
+     * frame qui sort de la fenêtre est retirée de l'histogramme ; les
+     * percentiles y sont lus à la demande (interpolés dans la classe).
+     *
+     * Un hitch est une frame plus longue que hitchFactor x médiane et que
+     * le seuil absolu. Avec setLogInterval(), un résumé part dans les logs.
+     */
+    class INGA_API FrameStats
+    {
+    public:
+        static const U32 WINDOW_SIZE = 1024;
+        static const U32 BUCKET_COUNT = 2304;
+
+        FrameStats();
+
+        void addFrame(U64 frameNs);
+        void reset();
+
+        FrameStatsSummary getSummary() const;
+
+        // Percentile (0..100) de la fenêtre, en ms
+        F64 getPercentile(F64 percent) const;
+
+        // Classe i de l'histogramme : bornes en ms et nombre de frames de la fenêtre
+        U32 getHistogramBucket(U32 index, F64* lowerMs, F64* upperMs) const;
+
+        void setHitchThreshold(F64 factorOfMedian, F64 minimumMs = 0.0);
+        void setHitchCallback(FrameHitchCallback callback, void* userData = nullptr);
+
+        // 0 = pas de log périodique
+        void setLogInterval(F64 seconds) { m_logIntervalNs = (U64)(seconds > 0.0 ? seconds * 1e9 : 0.0); }
+
+    private:
+        static U32 bucketOf(U32 us);
+        static U32 bucketLower(U32 bucket);
+        static U32 bucketUpper(U32 bucket);
+
+        U32 percentileUs(F64 percent) const;
+        void logSummary() const;
+
+        U32 m_samples[WINDOW_SIZE];   // µs
+        U32 m_histogram[BUCKET_COUNT];
+        U32 m_cursor;
+        U32 m_count;
+        U64 m_sumUs;
+        U64 m_frameIndex;
+
+        F64 m_hitchFactor;
+        F64 m_hitchMinimumMs;
+        U32 m_medianUs;               // rafraîchie toutes les 32 frames
+        U64 m_hitchCount;
+        FrameHitchCallback m_hitchCallback;
+        void* m_hitchUserData;
+
+        U64 m_logIntervalNs;
+        U64 m_sinceLogNs;
+    };
+}
+
+#endif
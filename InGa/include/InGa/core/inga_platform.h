@@ -48,6 +48,18 @@ typedef uint8_t  B8;
     #endif
 #endif
 
+// --- CACHE ---
+// Taille d'une ligne de cache : sert au padding des structures partagées entre threads
+// (évite le false sharing dans les queues et le job system)
+#ifndef INGA_CACHE_LINE_SIZE
+    #define INGA_CACHE_LINE_SIZE 64
+#endif
+
+// --- CONCATÉNATION ---
+// Indirection nécessaire pour que __LINE__ / __COUNTER__ soient développés avant le ##
+#define INGA_CONCAT_IMPL(a, b) a##b
+#define INGA_CONCAT(a, b) INGA_CONCAT_IMPL(a, b)
+
 // --- MACROS DE CRASH (HALT) ---
 #if defined(_MSC_VER) // Microsoft Visual Studio
     #define INGA_HALT() __debugbreak()
@@ -0,0 +1,80 @@
+#ifndef INGA_JOB_H
+#define INGA_JOB_H
+
+#include "export.h"
+#include "inga_platform.h"
+#include <atomic>
+#include <type_traits>
+
+namespace Inga
+{
+    typedef void (*JobFunction)(void* userData);
+    typedef void (*JobRangeFunction)(U32 begin, U32 end, void* userData);
+
+    // Description d'un job à lancer (copiée dans le pool interne au lancement)
+    struct JobDecl
+    {
+        JobFunction function;
+        void* userData;
+    };
+
+    /*
+     * JobCounter : incrémenté à chaque job lancé, décrémenté à chaque job terminé.
+     * JobSystem::wait() revient quand il retombe à zéro : c'est notre mécanisme
+     * de dépendance (lancer B après avoir attendu le compteur de A).
+     */
+    struct JobCounter
+    {
+        std::atomic<U32> value{0};
+
+        bool isDone() const { return value.load(std::memory_order_acquire) == 0; }
+    };
+
+    /*
+     * JobSystem : un thread worker par coeur (moins le thread principal),
+     * chacun avec sa deque Chase-Lev. Le propriétaire pousse/dépile en LIFO
+     * (cache chaud), les autres volent en FIFO quand leur deque est vide.
+     * Les threads non enregistrés passent par une queue d'injection MPMC.
+     * Le stockage des jobs et des deques vit dans le groupe mémoire "Jobs".
+     */
+    class INGA_API JobSystem
+    {
+    public:
+        // workerCount = 0 : nombre de coeurs - 1
+        static B8 start(U32 workerCount, U32 maxJobsPerThread = 4096);
+        static void stop();
+        static B8 isRunning();
+
+        static void run(const JobDecl& job, JobCounter* counter = nullptr);
+        static void run(const JobDecl* jobs, U32 count, JobCounter* counter = nullptr);
+
+        // Découpe [0, count) en lots de batchSize et les répartit sur les workers
+        static void runRange(U32 count, U32 batchSize, JobRangeFunction function, void* userData, JobCounter* counter);
+
+        // Exécute d'autres jobs en attendant (jamais de blocage passif)
+        static void wait(JobCounter* counter);
+
+        // Version bloquante de runRange (lance puis attend)
+        static void parallelFor(U32 count, U32 batchSize, JobRangeFunction function, void* userData);
+
+        // Confort : func(U32 index) appelé pour chaque index
+        template<typename F>
+        static void parallelFor(U32 count, U32 batchSize, F&& func)
+        {
+            using Func = std::remove_reference_t<F>;
+            parallelFor(count, batchSize, [](U32 begin, U32 end, void* userData)
+            {
+                Func* f = static_cast<Func*>(userData);
+                for (U32 i = begin; i < end; ++i) (*f)(i);
+            }, (void*)&func);
+        }
+
+        // Nombre de threads qui exécutent des jobs (workers + thread principal)
+        static U32 getThreadCount();
+
+        // 0 = thread principal, 1..N = workers, 0xFFFFFFFF = thread externe
+        static U32 getCurrentThreadIndex();
+    };
+}
+
+#endif
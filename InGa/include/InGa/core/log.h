@@ -3,33 +3,246 @@
 
 #include "export.h"
 #include "inga_platform.h"
+#include "log_format.h"
+#include <atomic>
+#include <cstring>
+#include <type_traits>
 
 namespace Inga {
 
 enum LogLevel { eVERBOSE, eDEBUG, eINFO, eWARNING, eERROR, eFATAL };
 enum LogOutput { eTERMOUT = 1, eFILEOUT = 2, eALLOUT = 3 };
 
+// Seuil de compilation : les INGA_LOG sous ce niveau disparaissent du binaire
+// (arguments non évalués, aucun appel). Surchargeable avec -DINGA_LOG_MIN_LEVEL=N.
+#ifndef INGA_LOG_MIN_LEVEL
+    #ifdef INGA_DEBUG
+        #define INGA_LOG_MIN_LEVEL 0 // eVERBOSE
+    #else
+        #define INGA_LOG_MIN_LEVEL 2 // eINFO
+    #endif
+#endif
+
+// eLOG_ASYNC  : l'appelant formate dans une queue lock-free et repart,
+//               un thread dédié écrit les lots vers le terminal et le fichier.
+// eLOG_BINARY : INGA_LOG n'écrit que l'id du site + les arguments bruts dans un
+//               buffer par thread (fichier .ilog, relu par inga_logdecode).
+//               Les messages >= eWARNING restent aussi écrits en texte.
+enum LogMode { eLOG_SYNC, eLOG_ASYNC, eLOG_BINARY };
+
+/*
+ * LogSite : description statique d'un appel INGA_LOG (une instance "static"
+ * par site). En mode binaire, elle est enregistrée une seule fois dans le
+ * fichier et les messages ne portent plus que son id.
+ */
+struct LogSite
+{
+    const char* tag;
+    const char* color;
+    const char* file;
+    const char* func;
+    I32 line;
+    const char* fmt;
+    std::atomic<U32> id{0};      // valide seulement dans la session "session"
+    std::atomic<U32> session{0}; // session binaire où id a été enregistré (0 = jamais)
+
+    // Limitation de débit (INGA_LOG_EVERY_N / INGA_LOG_RATE)
+    std::atomic<U64> hitCount{0};
+    std::atomic<U64> rateNextNs{0};   // "theoretical arrival time" du token bucket
+    std::atomic<U32> suppressed{0};   // messages jetés depuis le dernier passage
+};
+
+class LogSink; // core/log_sink.h
+
+// Comportement quand la queue async est pleine
+enum LogOverflow
+{
+    eLOG_BLOCK,      // L'appelant attend qu'une place se libère (aucune perte)
+    eLOG_DROP,       // Le message est jeté silencieusement (compté, voir getDroppedCount)
+    eLOG_DROP_COUNT  // Le message est jeté, le writer signale "N messages dropped"
+};
+
 class INGA_API Log
 {
 public:
-    static bool init(LogLevel level, LogOutput output, const char* folder = "logs");
+    static bool init(LogLevel level, LogOutput output, const char* folder = "logs",
+                     LogMode mode = eLOG_SYNC, LogOverflow overflow = eLOG_BLOCK,
+                     U32 asyncQueueSize = 4096);
     static void terminate();
 
+    // Attend que tous les messages en attente soient écrits et vide le buffer fichier
+    static void flush();
+
+    static U64 getDroppedCount();
+
+    // Horloge monotone des messages (ns) : même base que les timestamps des
+    // fichiers texte / binaires, pour recouper logs et captures du profiler
+    static U64 getTimestampNs();
+
+    // "HH:MM:SS.mmm" (heure locale) pour un timestamp de getTimestampNs()
+    static const char* formatTimestamp(U64 timestampNs, char* dst, U32 size);
+    static const char* getLevelName(LogLevel level);
+
+    // Sorties supplémentaires (en plus de eTERMOUT / eFILEOUT), max 8.
+    // Le Log ne prend pas possession du sink : removeSink avant de le détruire.
+    static bool addSink(LogSink* sink);
+    static void removeSink(LogSink* sink);
+
+    // Filtres par site : vrai pour le 1er appel puis un sur n
+    static bool everyN(LogSite& site, U32 n)
+    {
+        return n <= 1 || site.hitCount.fetch_add(1, std::memory_order_relaxed) % n == 0;
+    }
+
+    // Token bucket par site : maxPerSecond messages/s, rafale d'une seconde.
+    // Au premier message autorisé après une coupure, "N similar messages
+    // suppressed" est écrit avant lui.
+    static bool allowRate(LogSite& site, LogLevel level, U32 maxPerSecond);
+
+    // Fusionne les messages identiques consécutifs en "repeated N times" (actif par défaut)
+    static void setDeduplication(bool enabled);
+
+    // Niveau minimum à l'exécution (testé inline par les macros avant tout appel)
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel() { return s_minLevel; }
+    static bool isEnabled(LogLevel level) { return level >= s_minLevel; }
+
     // La fonction de base
     static void message(LogLevel level, const char* tag, const char* color, 
                         const char* file, const char* func, int line, 
                         const char* fmt, ...);
 
+    // Point d'entrée des macros INGA_LOG : texte ou binaire selon le mode
+    template<typename ... Args>
+    static void write(LogSite& site, LogLevel level, const Args& ... args)
+    {
+        if (s_mode == eLOG_BINARY && level < eWARNING)
+        {
+            writeBinary(site, level, args...);
+            return;
+        }
+        message(level, site.tag, site.color, site.file, site.func, site.line, site.fmt, args...);
+    }
+
+    // --- Mode binaire (utilisé par write) ---
+    // Réserve la place d'un message dans le buffer du thread : nullptr si filtré
+    static U8* beginBinary(LogSite& site, LogLevel level, U32 payloadSize, U8 argCount);
+    static void endBinary();
+
+    // Lus inline par les macros (ne pas modifier directement)
+    static LogMode s_mode;
+    static LogLevel s_minLevel;
+
+    // Rotation du fichier de log (0 = illimité). Le fichier courant devient
+    // <nom>.log.1, les plus anciens sont décalés jusqu'à maxRotatedFiles.
     static void setMaxFileSize(U32 size);
+    static void setMaxFileMessages(U32 count);
+    static void setMaxRotatedFiles(U32 count);
+
+    // Le fichier est bufferisé : flush immédiat à partir de flushLevel,
+    // sinon au plus tard toutes les intervalMs millisecondes
+    static void setFlushPolicy(LogLevel flushLevel, U32 intervalMs);
 
 private:
     static const char* getFileName(const char* path);
+
+    template<typename ... Args>
+    static void writeBinary(LogSite& site, LogLevel level, const Args& ... args)
+    {
+        const U32 payloadSize = (binaryArgSize(args) + ... + 0u);
+        U8* cursor = beginBinary(site, level, payloadSize, (U8)sizeof...(Args));
+        if (!cursor) return;
+        (encodeBinaryArg(cursor, args), ...);
+        endBinary();
+    }
+
+    // --- Encodage des arguments : un octet de type + la valeur brute ---
+    template<typename T>
+    static constexpr U32 binaryArgSize(const T&) { return 1 + 8; }
+
+    static U32 binaryArgSize(const char* str)
+    {
+        size_t length = str ? strlen(str) : 6;
+        return 1 + 2 + (U32)(length > 0xFFFF ? 0xFFFF : length);
+    }
+    static U32 binaryArgSize(char* str) { return binaryArgSize((const char*)str); }
+
+    template<typename T>
+    static void encodeBinaryArg(U8*& cursor, const T& value)
+    {
+        U8 type;
+        U64 raw = 0;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            type = eBINARG_FLOAT;
+            F64 v = (F64)value;
+            memcpy(&raw, &v, 8);
+        }
+        else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+        {
+            type = eBINARG_POINTER;
+            raw = (U64)(uintptr_t)value;
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            type = eBINARG_INT;
+            raw = (U64)(I64)value;
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            type = eBINARG_INT;
+            raw = (U64)(I64)value;
+        }
+        else
+        {
+            static_assert(std::is_integral_v<T>, "INGA_LOG binary mode: unsupported argument type");
+            type = eBINARG_UINT;
+            raw = (U64)value;
+        }
+        *cursor++ = type;
+        memcpy(cursor, &raw, 8);
+        cursor += 8;
+    }
+
+    static void encodeBinaryArg(U8*& cursor, const char* str)
+    {
+        if (!str) str = "(null)";
+        size_t length = strlen(str);
+        U16 length16 = (U16)(length > 0xFFFF ? 0xFFFF : length);
+        *cursor++ = eBINARG_STRING;
+        memcpy(cursor, &length16, 2);
+        memcpy(cursor + 2, str, length16);
+        cursor += 2 + length16;
+    }
+    static void encodeBinaryArg(U8*& cursor, char* str) { encodeBinaryArg(cursor, (const char*)str); }
 };
 
 } // namespace Inga
 
-// Macros de confort
-#define INGA_LOG(level, tag, ...) Inga::Log::message(level, tag, nullptr, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
-#define INGA_LOG_COLOR(level, tag, color, ...) Inga::Log::message(level, tag, color, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+// Macros de confort : chaque appel possède son LogSite statique
+// (tag et format sont capturés au premier passage : "" tag / "" fmt n'acceptent
+// que des littéraux, une variable est refusée à la compilation).
+// Le niveau est testé avant d'évaluer les arguments : sous INGA_LOG_MIN_LEVEL
+// le test est constant et le compilateur supprime tout le bloc.
+// "filter" est évalué après le test de niveau, avec _inga_log_site visible.
+#define INGA_LOG_SITE_IF(level, tag, color, filter, fmt, ...) \
+    do { \
+        if ((level) >= INGA_LOG_MIN_LEVEL && Inga::Log::isEnabled(level)) \
+        { \
+            static Inga::LogSite _inga_log_site = { "" tag, color, __FILE__, __FUNCTION__, __LINE__, "" fmt }; \
+            if (filter) Inga::Log::write(_inga_log_site, level __VA_OPT__(,) __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define INGA_LOG_SITE(level, tag, color, ...) INGA_LOG_SITE_IF(level, tag, color, true, __VA_ARGS__)
+
+#define INGA_LOG(level, tag, ...) INGA_LOG_SITE(level, tag, nullptr, __VA_ARGS__)
+#define INGA_LOG_COLOR(level, tag, color, ...) INGA_LOG_SITE(level, tag, color, __VA_ARGS__)
+
+// Limitation par site (pour les logs dans les boucles / callbacks bavards)
+#define INGA_LOG_EVERY_N(level, tag, n, ...) \
+    INGA_LOG_SITE_IF(level, tag, nullptr, Inga::Log::everyN(_inga_log_site, n), __VA_ARGS__)
+#define INGA_LOG_RATE(level, tag, maxPerSecond, ...) \
+    INGA_LOG_SITE_IF(level, tag, nullptr, Inga::Log::allowRate(_inga_log_site, level, maxPerSecond), __VA_ARGS__)
 
 #endif
@@ -0,0 +1,91 @@
+#ifndef INGA_LOG_FORMAT_H
+#define INGA_LOG_FORMAT_H
+
+#include "inga_platform.h"
+
+/*
+ * Format du log binaire (mode eLOG_BINARY), partagé entre le moteur et l'outil
+ * inga_logdecode. Tout est little-endian, sans padding.
+ *
+ *   BinLogFileHeader
+ *   { BinLogSiteHeader  + tag + file + func + fmt }   (une fois par site INGA_LOG)
+ *   { BinLogMessageHeader + arguments encodés }        (un par message)
+ *
+ * Un site est toujours écrit avant le premier message qui le référence.
+ * Chaque argument est précédé d'un octet de type (BinLogArgType) :
+ *   eBINARG_INT / eBINARG_UINT / eBINARG_FLOAT / eBINARG_POINTER : 8 octets
+ *   eBINARG_STRING : U16 longueur + octets (sans zéro final)
+ */
+
+#define INGA_BINLOG_MAGIC   "INGALOG1"
+#define INGA_BINLOG_VERSION 1
+
+// Fichier texte circulaire (MappedRingFileSink) : RingFileHeader + données
+#define INGA_RINGLOG_MAGIC   "INGARING"
+#define INGA_RINGLOG_VERSION 1
+
+namespace Inga
+{
+    enum BinLogRecordKind : U8
+    {
+        eBINLOG_SITE    = 1,
+        eBINLOG_MESSAGE = 2
+    };
+
+    enum BinLogArgType : U8
+    {
+        eBINARG_INT     = 'i',
+        eBINARG_UINT    = 'u',
+        eBINARG_FLOAT   = 'f',
+        eBINARG_STRING  = 's',
+        eBINARG_POINTER = 'p'
+    };
+
+#pragma pack(push, 1)
+    struct BinLogFileHeader
+    {
+        char magic[8];
+        U32  version;
+        U32  reserved;
+        I64  startWallTimeSec;   // time() au démarrage
+        U64  startTimestampNs;   // horloge monotone au même instant
+    };
+
+    struct BinLogSiteHeader
+    {
+        U8  kind;                // eBINLOG_SITE
+        U32 siteId;
+        I32 line;
+        U16 tagLength;
+        U16 fileLength;
+        U16 funcLength;
+        U16 fmtLength;
+    };
+
+    struct BinLogMessageHeader
+    {
+        U8  kind;                // eBINLOG_MESSAGE
+        U8  level;
+        U8  argCount;
+        U8  reserved;
+        U32 siteId;
+        U32 threadId;
+        U32 payloadSize;
+        U64 timestampNs;
+    };
+#pragma pack(pop)
+
+    // 64 octets, aligné : writeOffset est mis à jour atomiquement après la copie
+    struct RingFileHeader
+    {
+        char magic[8];
+        U32  version;
+        U32  headerSize;         // offset des données dans le fichier
+        U64  capacity;           // taille de la zone circulaire
+        U64  writeOffset;        // total d'octets écrits depuis l'ouverture
+        U8   reserved[32];
+    };
+    static_assert(sizeof(RingFileHeader) == 64, "RingFileHeader must stay 64 bytes");
+}
+
+#endif // INGA_LOG_FORMAT_H
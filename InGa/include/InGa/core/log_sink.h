@@ -0,0 +1,103 @@
+#ifndef INGA_LOG_SINK_H
+#define INGA_LOG_SINK_H
+
+#include "export.h"
+#include "inga_platform.h"
+#include "log.h"
+
+namespace Inga
+{
+    // Un message texte tel que le voient les sinks (pointeurs valides pendant l'appel)
+    struct LogEntry
+    {
+        LogLevel level;
+        const char* tag;
+        const char* color;
+        const char* file;
+        const char* func;
+        I32 line;
+        U32 threadId;
+        U64 timestampNs;     // Log::getTimestampNs()
+        const char* text;
+        U32 length;
+    };
+
+    // Écrit la ligne complète (avec '\n') dans dst, retourne sa longueur comme snprintf
+    typedef int (*LogFormatter)(char* dst, size_t size, const LogEntry& entry);
+
+    /*
+     * LogSink : sortie supplémentaire enregistrée avec Log::addSink.
+     * Chaque sink a son niveau et son formateur ; le Log appelle submit() depuis
+     * un seul thread à la fois (appelant en mode sync, writer en mode async).
+     * Le sink reste la propriété de l'appelant (retiré avant destruction).
+     */
+    class INGA_API LogSink
+    {
+    public:
+        explicit LogSink(LogLevel level = eVERBOSE) : m_level(level) {}
+        virtual ~LogSink() = default;
+
+        void setLevel(LogLevel level) { m_level = level; }
+        LogLevel getLevel() const { return m_level; }
+
+        // nullptr = formateur par défaut
+        void setFormatter(LogFormatter formatter) { m_formatter = formatter ? formatter : &LogSink::formatDefault; }
+
+        // Filtre par niveau, formate puis appelle write()
+        void submit(const LogEntry& entry);
+
+        virtual void flush() {}
+
+        // [HH:MM:SS.mmm][LEVEL][T<id>][TAG] (func | file:line) texte
+        static int formatDefault(char* dst, size_t size, const LogEntry& entry);
+
+    protected:
+        virtual void write(const LogEntry& entry, const char* line, U32 length) = 0;
+
+    private:
+        LogLevel m_level;
+        LogFormatter m_formatter = &LogSink::formatDefault;
+    };
+
+    /*
+     * MappedRingFileSink : fichier circulaire de taille fixe mappé en mémoire.
+     * Chaque ligne est copiée avec de simples stores dans le mapping (aucun
+     * appel système par message) ; les pages sales restent dans le page cache
+     * de l'OS, donc le contenu survit à un crash du process.
+     *
+     * Le fichier commence par un RingFileHeader ; writeOffset est le nombre
+     * total d'octets écrits : les données valides sont les min(writeOffset,
+     * capacity) derniers octets, à partir de writeOffset % capacity.
+     * inga_logdecode sait remettre le fichier dans l'ordre.
+     */
+    class INGA_API MappedRingFileSink : public LogSink
+    {
+    public:
+        MappedRingFileSink() = default;
+        ~MappedRingFileSink() override;
+
+        MappedRingFileSink(const MappedRingFileSink&) = delete;
+        MappedRingFileSink& operator=(const MappedRingFileSink&) = delete;
+
+        // Crée (ou écrase) le fichier à la taille donnée et le mappe
+        bool open(const char* path, U32 capacity = 8 * 1024 * 1024);
+        void close();
+        bool isOpen() const { return m_header != nullptr; }
+
+        // msync asynchrone : uniquement utile contre une panne machine
+        void flush() override;
+
+    protected:
+        void write(const LogEntry& entry, const char* line, U32 length) override;
+
+    private:
+        RingFileHeader* m_header = nullptr;
+        U8* m_data = nullptr;
+        U64 m_capacity = 0;
+        U64 m_mappedSize = 0;
+        void* m_mapping = nullptr;   // HANDLE de mapping (Windows)
+        intptr_t m_file = -1;        // descripteur / HANDLE du fichier
+    };
+}
+
+#endif
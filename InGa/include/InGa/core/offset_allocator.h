@@ -0,0 +1,105 @@
+#ifndef INGA_OFFSET_ALLOCATOR_H
+#define INGA_OFFSET_ALLOCATOR_H
+
+#include "export.h"
+#include "inga_platform.h"
+
+namespace Inga
+{
+    // offset == NO_SPACE : échec ; metadata et generation sont rendus tels quels à free()
+    struct OffsetAllocation
+    {
+        static const U32 NO_SPACE = 0xFFFFFFFF;
+
+        U32 offset = NO_SPACE;
+        U32 metadata = NO_SPACE;
+        U32 generation = 0;     // détecte un handle périmé (double free, free après reset)
+
+        bool isValid() const { return offset != NO_SPACE; }
+    };
+
+    struct OffsetAllocatorStats
+    {
+        U32 totalFree;
+        U32 largestFree;       // plus grande région libre (allocation sûre jusqu'à cette taille)
+        U32 allocationCount;
+        U32 freeRegionCount;
+    };
+
+    /*
+     * OffsetAllocator : sous-allocateur TLSF d'un espace [0, size) dont il ne
+     * touche jamais la mémoire (tas GPU, descripteurs, plages d'un buffer).
+     * Toutes les métadonnées sont côté CPU, dans des tableaux fixes.
+     *
+     * Les régions libres sont rangées dans 256 classes (taille encodée en
+     * "flottant" 5 bits d'exposant / 3 bits de mantisse, < 12.5 % de perte) ;
+     * deux masques de bits trouvent la première classe assez grande.
+     * allocate() et free() sont O(1), free() fusionne avec les voisins libres.
+     *
+     * L'unité est libre (octets, blocs de 256 octets, slots...) : l'alignement
+     * est à la charge de l'appelant. Pas thread-safe.
+     */
+    class INGA_API OffsetAllocator
+    {
+    public:
+        static const U32 TOP_BIN_COUNT = 32;
+        static const U32 LEAF_BIN_COUNT = 8;
+        static const U32 BIN_COUNT = TOP_BIN_COUNT * LEAF_BIN_COUNT;
+
+        OffsetAllocator() = default;
+        ~OffsetAllocator() { shutdown(); }
+
+        OffsetAllocator(const OffsetAllocator&) = delete;
+        OffsetAllocator& operator=(const OffsetAllocator&) = delete;
+
+        // maxAllocations borne les régions (allouées + libres) : métadonnées allouées dans groupId
+        bool init(U32 size, U32 maxAllocations = 128 * 1024, U16 groupId = 0);
+        void shutdown();
+
+        // Remet tout l'espace en une seule région libre
+        void reset();
+
+        OffsetAllocation allocate(U32 size);
+        void free(OffsetAllocation allocation);
+
+        U32 getAllocationSize(OffsetAllocation allocation) const;
+        U32 getSize() const { return m_size; }
+        U32 getFreeSize() const { return m_freeStorage; }
+        bool isEmpty() const { return m_freeStorage == m_size; }
+
+        OffsetAllocatorStats getStats() const;
+
+    private:
+        struct Node
+        {
+            static const U32 UNUSED = 0xFFFFFFFF;
+
+            U32 offset;
+            U32 size;
+            U32 binPrev;        // liste de la classe (régions libres)
+            U32 binNext;
+            U32 neighborPrev;   // voisins physiques
+            U32 neighborNext;
+            U32 generation;     // +1 à chaque allocation du noeud, jamais remis à zéro
+            bool used;
+        };
+
+        U32 insertNodeIntoBin(U32 size, U32 offset);
+        void removeNodeFromBin(U32 nodeIndex);
+
+        U32 m_size = 0;
+        U32 m_maxNodes = 0;
+        U32 m_freeStorage = 0;
+        U32 m_allocationCount = 0;
+
+        U32 m_usedBinsTop = 0;
+        U8 m_usedBins[TOP_BIN_COUNT] = {};
+        U32 m_binHeads[BIN_COUNT] = {};
+
+        Node* m_nodes = nullptr;
+        U32* m_freeNodes = nullptr;     // pile des noeuds disponibles
+        U32 m_freeOffset = 0;           // sommet de la pile
+    };
+}
+
+#endif
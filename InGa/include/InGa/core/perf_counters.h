@@ -0,0 +1,70 @@
+#ifndef INGA_PERF_COUNTERS_H
+#define INGA_PERF_COUNTERS_H
+
+#include "export.h"
+#include "inga_platform.h"
+
+namespace Inga
+{
+    enum PerfCounter
+    {
+        ePERF_CYCLES,
+        ePERF_INSTRUCTIONS,
+        ePERF_L1D_MISSES,      // lectures L1 données ratées
+        ePERF_LLC_MISSES,      // défauts du dernier niveau de cache
+        ePERF_BRANCH_MISSES,
+        ePERF_COUNTER_COUNT
+    };
+
+    // Valeurs cumulées des compteurs (0 pour ceux qui n'ont pas pu être ouverts)
+    struct PerfCounterSample
+    {
+        U64 values[ePERF_COUNTER_COUNT];
+    };
+
+    /*
+     * PerfCounterGroup : compteurs matériels du thread courant (Linux,
+     * perf_event_open), ouverts en un seul groupe pour être programmés
+     * ensemble sur le PMU. Espace utilisateur uniquement (exclude_kernel),
+     * donc utilisable avec perf_event_paranoid <= 2.
+     *
+     * read() passe par rdpmc quand le noyau l'autorise (quelques dizaines de
+     * cycles, sans appel système), sinon par un read() du groupe.
+     * Sur les autres plateformes, ou sans PMU (VM), open() échoue.
+     */
+    class INGA_API PerfCounterGroup
+    {
+    public:
+        PerfCounterGroup();
+        ~PerfCounterGroup();
+
+        PerfCounterGroup(const PerfCounterGroup&) = delete;
+        PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+        // À appeler depuis le thread à mesurer
+        bool open();
+        void close();
+
+        bool isOpen() const { return m_fds[0] >= 0; }
+        bool usesRdpmc() const { return m_rdpmc; }
+
+        // Bit i : compteur i disponible
+        U32 getAvailableMask() const { return m_mask; }
+
+        void read(PerfCounterSample& sample) const;
+
+        static const char* getName(PerfCounter counter);
+
+    private:
+        void readGroup(PerfCounterSample& sample) const;
+
+        int m_fds[ePERF_COUNTER_COUNT];
+        void* m_pages[ePERF_COUNTER_COUNT];   // perf_event_mmap_page (rdpmc)
+        U32 m_slots[ePERF_COUNTER_COUNT];     // position de chaque compteur dans la lecture du groupe
+        U32 m_mask;
+        U32 m_openCount;
+        bool m_rdpmc;
+    };
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef INGA_PROFILER_H
+#define INGA_PROFILER_H
+
+#include "export.h"
+#include "inga_platform.h"
+#include "perf_counters.h"
+#include <atomic>
+
+namespace Inga
+{
+    /*
+     * Noeud de l'arbre d'appels d'une frame : un noeud par chemin (thread,
+     * zone parente, nom). Les racines (depth 0) représentent les threads.
+     * Les index parent / firstChild / nextSibling pointent dans ProfileFrame::nodes
+     * (0xFFFFFFFF = aucun).
+     */
+    struct ProfileNode
+    {
+        const char* name;
+        U32 parent;
+        U32 firstChild;
+        U32 nextSibling;
+        U16 depth;
+        U16 threadIndex;
+        U32 calls;
+        U64 inclusiveNs;   // temps total passé dans la zone
+        U64 exclusiveNs;   // inclusif moins le temps des zones enfants
+        U64 counters[ePERF_COUNTER_COUNT]; // compteurs matériels, inclusifs (0 sans setHardwareCounters)
+    };
+
+    // Résultat agrégé d'une frame, valide jusqu'au prochain endFrame()
+    struct ProfileFrame
+    {
+        U64 frameIndex;
+        U64 startNs;       // Log::getTimestampNs() au début de la frame
+        U64 durationNs;
+        U32 nodeCount;
+        const ProfileNode* nodes;
+        U32 droppedEvents; // buffers pleins pendant la frame (zones ignorées)
+    };
+
+    /*
+     * Profiler : zones imbriquées mesurées avec Time::now(), enregistrées dans un buffer
+     * lock-free (SpscRing) par thread, puis agrégées par frame dans endFrame()
+     * (temps inclusif / exclusif, nombre d'appels). Une zone est comptée dans
+     * la frame où elle se termine.
+     *
+     *   void update() { INGA_PROFILE_ZONE("Update"); ... }
+     *   ...
+     *   Profiler::endFrame();                        // une fois par frame (thread principal)
+     *   const ProfileFrame& f = Profiler::getLastFrame();
+     */
+    class INGA_API Profiler
+    {
+    public:
+        // eventsPerThread : taille du buffer de chaque thread (arrondie à une puissance de 2)
+        static B8 start(U32 eventsPerThread = 64 * 1024, U32 maxNodesPerFrame = 4096);
+        static void stop();
+
+        static void setEnabled(bool enabled);
+        static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+        // "name" doit rester valide (littéral) : seul le pointeur est enregistré
+        static void beginZone(const char* name);
+        static void endZone();
+
+        // Nom affiché pour la racine du thread courant
+        static void setThreadName(const char* name);
+
+        // Clôt la frame courante : vide les buffers et publie l'agrégat
+        static void endFrame();
+
+        static const ProfileFrame& getLastFrame();
+
+        // Somme sur tous les threads des noeuds portant ce nom (frame précédente)
+        static U64 getZoneTime(const char* name, U32* calls = nullptr);
+        static bool getZoneCounters(const char* name, PerfCounterSample& counters);
+
+        /*
+         * Compteurs matériels par zone (Linux, voir core/perf_counters.h) :
+         * chaque thread enregistré après l'appel ouvre son groupe perf_event
+         * et lit les compteurs au début et à la fin de chaque zone.
+         * Appeler avant start() pour couvrir tous les threads.
+         */
+        static void setHardwareCounters(bool enabled);
+        static bool hasHardwareCounters();
+
+        // Arbre de la frame précédente dans les logs (temps, appels, IPC, défauts de cache)
+        static void logLastFrame(U32 maxDepth = 4);
+
+        // Horloge des zones (Time::now, voir core/time.h) et conversion en nanosecondes
+        static U64 getTicks();
+        static U64 ticksToNs(U64 ticks);
+
+        /*
+         * Capture : enregistre les zones brutes (et les messages de log, en
+         * événements instantanés) des "frameCount" prochaines frames, puis les
+         * écrit au format Chrome Trace Event JSON (chrome://tracing, ui.perfetto.dev).
+         * Les buffers sont alloués à la demande ; pendant la capture, les zones
+         * sont copiées par endFrame() et les logs vont dans un tableau préalloué.
+         * path == nullptr : inga_capture_AAAA_MM_JJ_HH_MM_SS.json
+         */
+        static B8 requestCapture(U32 frameCount, const char* path = nullptr);
+
+        // Appels à l'allocateur (taille, groupe, durée, attente du verrou) dans les
+        // captures suivantes : tranches sous les zones + compteur par frame (oui par défaut)
+        static void setCaptureAllocations(bool enabled);
+        static bool isCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+
+        // SIGUSR1 déclenche une capture de frameCount frames (POSIX uniquement)
+        static B8 installCaptureSignal(U32 frameCount = 120);
+
+        // Appelé par Log quand s_capturing est vrai (texte copié, tronqué si besoin)
+        static void captureLog(U8 level, const char* tag, const char* text, U32 length);
+
+        // Lu inline (relaxed) pour court-circuiter les zones quand le profiler est coupé
+        static std::atomic<bool> s_enabled;
+        static std::atomic<bool> s_capturing;
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name)
+            : m_active(Profiler::s_enabled.load(std::memory_order_relaxed))
+        {
+            if (m_active) Profiler::beginZone(name);
+        }
+
+        ~ProfileScope()
+        {
+            if (m_active) Profiler::endZone();
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        bool m_active;
+    };
+}
+
+#define INGA_PROFILE_ZONE(name) Inga::ProfileScope INGA_CONCAT(_inga_profile_zone_, __COUNTER__)(name)
+#define INGA_PROFILE_FRAME() Inga::Profiler::endFrame()
+
+#endif
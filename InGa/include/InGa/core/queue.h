@@ -0,0 +1,296 @@
+#ifndef INGA_QUEUE_H
+#define INGA_QUEUE_H
+
+#include <InGa/core/inga_platform.h>
+#include <InGa/core/allocator.h>
+#include <atomic>
+#include <new>
+#include <utility>
+
+namespace Inga
+{
+    // Arrondi à la puissance de deux supérieure (les index sont masqués, pas de modulo)
+    inline U32 queueRoundCapacity(U32 capacity)
+    {
+        // Au-delà de 2^31, le décalage déborderait et la boucle ne finirait pas
+        INGA_ASSERT_RAW(capacity <= (1u << 31), "queue capacity above 2^31");
+        if (capacity > (1u << 31)) capacity = 1u << 31;
+
+        U32 result = 2;
+        while (result < capacity) result <<= 1;
+        return result;
+    }
+
+    /**
+     * SpscRing : ring buffer borné, lock-free, UN producteur / UN consommateur.
+     * Head et tail vivent sur des lignes de cache séparées, et chaque côté garde
+     * une copie locale de l'index de l'autre pour ne toucher la ligne partagée
+     * que lorsque le ring semble plein (producteur) ou vide (consommateur).
+     * Le stockage vient de l'allocateur InGa (aligné sur une ligne de cache).
+     */
+    template<typename T>
+    class SpscRing
+    {
+    public:
+        SpscRing() = default;
+        ~SpscRing() { shutdown(); }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // La capacité est arrondie à la puissance de deux supérieure
+        bool init(U32 capacity, U16 groupId = 0)
+        {
+            if (m_buffer) return false;
+
+            m_capacity = queueRoundCapacity(capacity);
+            m_mask = m_capacity - 1;
+            m_buffer = static_cast<T*>(Allocator::alloc((U64)sizeof(T) * m_capacity, storageAlign(), groupId, __FILE__, __LINE__));
+            if (!m_buffer) return false;
+
+            m_head.store(0, std::memory_order_relaxed);
+            m_tail.store(0, std::memory_order_relaxed);
+            m_cachedHead = 0;
+            m_cachedTail = 0;
+            return true;
+        }
+
+        void shutdown()
+        {
+            if (!m_buffer) return;
+
+            // Plus aucun producteur/consommateur actif : on détruit ce qui reste
+            const U64 tail = m_tail.load(std::memory_order_acquire);
+            for (U64 i = m_head.load(std::memory_order_acquire); i != tail; ++i)
+            {
+                m_buffer[i & m_mask].~T();
+            }
+
+            Allocator::free(m_buffer);
+            m_buffer = nullptr;
+        }
+
+        // --- Côté producteur ---
+        template<typename ... Args>
+        bool emplace(Args&& ... args)
+        {
+            const U64 tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_cachedHead >= m_capacity)
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (tail - m_cachedHead >= m_capacity) return false;
+            }
+
+            new (&m_buffer[tail & m_mask]) T(std::forward<Args>(args)...);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool push(const T& value) { return emplace(value); }
+        bool push(T&& value) { return emplace(std::move(value)); }
+
+        // --- Côté consommateur ---
+        bool pop(T& out)
+        {
+            const U64 head = m_head.load(std::memory_order_relaxed);
+            if (head == m_cachedTail)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail) return false;
+            }
+
+            T* slot = &m_buffer[head & m_mask];
+            out = std::move(*slot);
+            slot->~T();
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Accès à l'élément en tête sans le retirer (consommateur uniquement)
+        T* front()
+        {
+            const U64 head = m_head.load(std::memory_order_relaxed);
+            if (head == m_cachedTail)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail) return nullptr;
+            }
+            return &m_buffer[head & m_mask];
+        }
+
+        // Approximatif si appelé pendant que l'autre côté travaille
+        U32 size() const
+        {
+            return (U32)(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+        }
+
+        bool empty() const { return size() == 0; }
+        U32 capacity() const { return m_capacity; }
+
+    private:
+        static constexpr U32 storageAlign()
+        {
+            return alignof(T) > INGA_CACHE_LINE_SIZE ? (U32)alignof(T) : (U32)INGA_CACHE_LINE_SIZE;
+        }
+
+        // Ligne du consommateur
+        alignas(INGA_CACHE_LINE_SIZE) std::atomic<U64> m_head{0};
+        U64 m_cachedTail = 0;
+
+        // Ligne du producteur
+        alignas(INGA_CACHE_LINE_SIZE) std::atomic<U64> m_tail{0};
+        U64 m_cachedHead = 0;
+
+        // Données en lecture seule après init()
+        alignas(INGA_CACHE_LINE_SIZE) T* m_buffer = nullptr;
+        U64 m_mask = 0;
+        U32 m_capacity = 0;
+    };
+
+    /**
+     * MpmcQueue : queue bornée, lock-free, multi-producteurs / multi-consommateurs
+     * (algorithme de Dmitry Vyukov). Chaque cellule porte un numéro de séquence
+     * qui indique si elle est prête à être écrite ou lue pour un tour donné :
+     * un seul CAS par opération, pas d'ABA.
+     */
+    template<typename T>
+    class MpmcQueue
+    {
+    public:
+        MpmcQueue() = default;
+        ~MpmcQueue() { shutdown(); }
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        // La capacité est arrondie à la puissance de deux supérieure
+        bool init(U32 capacity, U16 groupId = 0)
+        {
+            if (m_cells) return false;
+
+            m_capacity = queueRoundCapacity(capacity);
+            m_mask = m_capacity - 1;
+            m_cells = static_cast<Cell*>(Allocator::alloc((U64)sizeof(Cell) * m_capacity, storageAlign(), groupId, __FILE__, __LINE__));
+            if (!m_cells) return false;
+
+            for (U32 i = 0; i < m_capacity; ++i)
+            {
+                new (&m_cells[i].sequence) std::atomic<U64>(i);
+            }
+
+            m_enqueuePos.store(0, std::memory_order_relaxed);
+            m_dequeuePos.store(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        void shutdown()
+        {
+            if (!m_cells) return;
+
+            // Plus aucun producteur/consommateur actif : on détruit ce qui reste
+            const U64 enq = m_enqueuePos.load(std::memory_order_acquire);
+            for (U64 i = m_dequeuePos.load(std::memory_order_acquire); i != enq; ++i)
+            {
+                reinterpret_cast<T*>(m_cells[i & m_mask].storage)->~T();
+            }
+
+            Allocator::free(m_cells);
+            m_cells = nullptr;
+        }
+
+        template<typename ... Args>
+        bool emplace(Args&& ... args)
+        {
+            Cell* cell;
+            U64 pos = m_enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &m_cells[pos & m_mask];
+                const U64 seq = cell->sequence.load(std::memory_order_acquire);
+                const I64 diff = (I64)seq - (I64)pos;
+
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // Pleine
+                }
+                else
+                {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (cell->storage) T(std::forward<Args>(args)...);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool push(const T& value) { return emplace(value); }
+        bool push(T&& value) { return emplace(std::move(value)); }
+
+        bool pop(T& out)
+        {
+            Cell* cell;
+            U64 pos = m_dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &m_cells[pos & m_mask];
+                const U64 seq = cell->sequence.load(std::memory_order_acquire);
+                const I64 diff = (I64)seq - (I64)(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // Vide
+                }
+                else
+                {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            T* value = reinterpret_cast<T*>(cell->storage);
+            out = std::move(*value);
+            value->~T();
+            cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Approximatif : uniquement indicatif quand d'autres threads travaillent
+        U32 size() const
+        {
+            const U64 enq = m_enqueuePos.load(std::memory_order_acquire);
+            const U64 deq = m_dequeuePos.load(std::memory_order_acquire);
+            return enq > deq ? (U32)(enq - deq) : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+        U32 capacity() const { return m_capacity; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<U64> sequence;
+            alignas(T) U8 storage[sizeof(T)];
+        };
+
+        static constexpr U32 storageAlign()
+        {
+            return alignof(Cell) > INGA_CACHE_LINE_SIZE ? (U32)alignof(Cell) : (U32)INGA_CACHE_LINE_SIZE;
+        }
+
+        alignas(INGA_CACHE_LINE_SIZE) std::atomic<U64> m_enqueuePos{0};
+        alignas(INGA_CACHE_LINE_SIZE) std::atomic<U64> m_dequeuePos{0};
+        alignas(INGA_CACHE_LINE_SIZE) Cell* m_cells = nullptr;
+        U64 m_mask = 0;
+        U32 m_capacity = 0;
+    };
+}
+
+#endif // INGA_QUEUE_H
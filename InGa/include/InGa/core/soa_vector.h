@@ -0,0 +1,385 @@
+#ifndef INGA_SOA_VECTOR_H
+#define INGA_SOA_VECTOR_H
+
+#include "allocator.h"
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Inga {
+
+/**
+ * SoARow : ligne d'un SoAVector, tuple de références vers chaque colonne.
+ * L'affectation écrit dans les colonnes et swap() échange les lignes entières,
+ * ce qui permet aux algorithmes de <algorithm> (sort, rotate...) de permuter le conteneur.
+ */
+template<typename ... Rs>
+class SoARow : public std::tuple<Rs...>
+{
+    using Base = std::tuple<Rs...>;
+    using Sequence = std::index_sequence_for<Rs...>;
+
+public:
+    using Base::Base;
+
+    SoARow(const SoARow&) = default;
+
+    SoARow& operator=(const SoARow& other) { copyFrom(other, Sequence{}); return *this; }
+    SoARow& operator=(SoARow&& other) { moveFrom(other, Sequence{}); return *this; }
+
+    template<typename ... Us>
+    SoARow& operator=(const std::tuple<Us...>& values) { copyFrom(values, Sequence{}); return *this; }
+
+    template<typename ... Us>
+    SoARow& operator=(std::tuple<Us...>&& values) { moveFrom(values, Sequence{}); return *this; }
+
+    // Les lignes sont des temporaires : swap par valeur, les références pointent dans les colonnes
+    friend void swap(SoARow a, SoARow b) { a.swapWith(b, Sequence{}); }
+
+private:
+    template<typename Tuple, size_t ... Is>
+    void copyFrom(const Tuple& values, std::index_sequence<Is...>)
+    {
+        ((std::get<Is>(*this) = std::get<Is>(values)), ...);
+    }
+
+    template<typename Tuple, size_t ... Is>
+    void moveFrom(Tuple& values, std::index_sequence<Is...>)
+    {
+        ((std::get<Is>(*this) = std::move(std::get<Is>(values))), ...);
+    }
+
+    template<size_t ... Is>
+    void swapWith(SoARow& other, std::index_sequence<Is...>)
+    {
+        using std::swap;
+        (swap(std::get<Is>(*this), std::get<Is>(other)), ...);
+    }
+};
+
+/**
+ * SoAVector : conteneur "Structure of Arrays".
+ * Une seule allocation InGa par capacité, découpée en colonnes (une par type)
+ * alignées sur 64 octets : chaque colonne est contiguë et prête pour le SIMD.
+ *
+ *   SoAVector<Vec3, Vec3, F32> particles;          // position, vitesse, vie
+ *   particles.push_back(pos, vel, 1.0f);
+ *   std::span<F32> life = particles.column<2>();   // boucle vectorisable
+ *   for (auto [p, v, l] : particles) p += v;        // itérateur zippé (scalaire)
+ */
+template<typename ... Ts>
+class SoAVector
+{
+    static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one column");
+
+public:
+    static constexpr U32 ColumnCount = sizeof...(Ts);
+    static constexpr U32 ColumnAlignment = 64;
+
+    template<size_t I>
+    using ColumnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    using Reference = SoARow<Ts&...>;
+    using ConstReference = SoARow<const Ts&...>;
+
+    // --- Itérateur zippé : déréférencé en tuple de références ---
+    // Accès aléatoire, utilisable avec <algorithm> (std::sort permute les lignes entières)
+    template<bool Const>
+    class ZipIterator
+    {
+    public:
+        using Owner = std::conditional_t<Const, const SoAVector, SoAVector>;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<Ts...>;
+        using reference = std::conditional_t<Const, ConstReference, Reference>;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+
+        ZipIterator() = default;
+        ZipIterator(Owner* owner, U32 index) : m_owner(owner), m_index(index) {}
+
+        reference operator*() const { return (*m_owner)[m_index]; }
+        reference operator[](difference_type n) const { return (*m_owner)[(U32)(m_index + n)]; }
+
+        ZipIterator& operator++() { ++m_index; return *this; }
+        ZipIterator operator++(int) { ZipIterator tmp = *this; ++m_index; return tmp; }
+        ZipIterator& operator--() { --m_index; return *this; }
+        ZipIterator operator--(int) { ZipIterator tmp = *this; --m_index; return tmp; }
+        ZipIterator& operator+=(difference_type n) { m_index = (U32)(m_index + n); return *this; }
+        ZipIterator& operator-=(difference_type n) { m_index = (U32)(m_index - n); return *this; }
+        ZipIterator operator+(difference_type n) const { return ZipIterator(m_owner, (U32)(m_index + n)); }
+        ZipIterator operator-(difference_type n) const { return ZipIterator(m_owner, (U32)(m_index - n)); }
+        friend ZipIterator operator+(difference_type n, const ZipIterator& it) { return it + n; }
+        difference_type operator-(const ZipIterator& other) const { return (difference_type)m_index - (difference_type)other.m_index; }
+
+        bool operator==(const ZipIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const ZipIterator& other) const { return m_index != other.m_index; }
+        bool operator<(const ZipIterator& other) const { return m_index < other.m_index; }
+        bool operator>(const ZipIterator& other) const { return m_index > other.m_index; }
+        bool operator<=(const ZipIterator& other) const { return m_index <= other.m_index; }
+        bool operator>=(const ZipIterator& other) const { return m_index >= other.m_index; }
+
+        U32 index() const { return m_index; }
+
+    private:
+        Owner* m_owner = nullptr;
+        U32 m_index = 0;
+    };
+
+    using Iterator = ZipIterator<false>;
+    using ConstIterator = ZipIterator<true>;
+
+    explicit SoAVector(U16 groupId = 0) : m_groupId(groupId) {}
+
+    ~SoAVector()
+    {
+        clear();
+        Allocator::free(m_block);
+    }
+
+    SoAVector(const SoAVector&) = delete;
+    SoAVector& operator=(const SoAVector&) = delete;
+
+    SoAVector(SoAVector&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    SoAVector& operator=(SoAVector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            Allocator::free(m_block);
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    // --- Capacité ---
+    U32 size() const { return m_size; }
+    U32 capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+
+    void reserve(U32 newCapacity)
+    {
+        if (newCapacity <= m_capacity) return;
+        reallocate(newCapacity, std::index_sequence_for<Ts...>{});
+    }
+
+    // --- Modification (sur toutes les colonnes à la fois) ---
+    template<typename ... Args>
+    void push_back(Args&& ... values)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "push_back needs one value per column");
+        if (m_size == m_capacity)
+        {
+            // Les valeurs peuvent référencer nos propres colonnes (v.push_back(v[0]...)) :
+            // on les copie avant que la réallocation ne libère l'ancien bloc
+            std::tuple<Ts...> staged(std::forward<Args>(values)...);
+            reserve(grownCapacity());
+            constructFrom(m_size, std::move(staged), std::index_sequence_for<Ts...>{});
+            ++m_size;
+            return;
+        }
+        constructAt(m_size, std::index_sequence_for<Ts...>{}, std::forward<Args>(values)...);
+        ++m_size;
+    }
+
+    void pop_back()
+    {
+        if (m_size == 0) return;
+        --m_size;
+        destroyAt(m_size, std::index_sequence_for<Ts...>{});
+    }
+
+    // Conserve l'ordre : décale toutes les colonnes (O(n))
+    void erase(U32 index)
+    {
+        if (index >= m_size) return;
+        shiftDown(index, std::index_sequence_for<Ts...>{});
+        pop_back();
+    }
+
+    // Ne conserve pas l'ordre : le dernier élément prend la place (O(1))
+    void swapRemove(U32 index)
+    {
+        if (index >= m_size) return;
+        if (index != m_size - 1)
+        {
+            moveAssign(index, m_size - 1, std::index_sequence_for<Ts...>{});
+        }
+        pop_back();
+    }
+
+    void clear()
+    {
+        while (m_size > 0) pop_back();
+    }
+
+    // --- Accès colonne (pour les boucles vectorisées) ---
+    template<size_t I>
+    std::span<ColumnType<I>> column()
+    {
+        return std::span<ColumnType<I>>(std::get<I>(m_columns), m_size);
+    }
+
+    template<size_t I>
+    std::span<const ColumnType<I>> column() const
+    {
+        return std::span<const ColumnType<I>>(std::get<I>(m_columns), m_size);
+    }
+
+    template<size_t I>
+    ColumnType<I>* data() { return std::get<I>(m_columns); }
+
+    template<size_t I>
+    const ColumnType<I>* data() const { return std::get<I>(m_columns); }
+
+    // --- Accès ligne (scalaire) ---
+    Reference operator[](U32 index)
+    {
+        return rowAt(index, std::index_sequence_for<Ts...>{});
+    }
+
+    ConstReference operator[](U32 index) const
+    {
+        return rowAt(index, std::index_sequence_for<Ts...>{});
+    }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, m_size); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, m_size); }
+
+private:
+    static constexpr U64 alignUp(U64 value)
+    {
+        return (value + (ColumnAlignment - 1)) & ~(U64)(ColumnAlignment - 1);
+    }
+
+    // Doublement saturé : au-delà de 2^31 on plafonne à U32 max au lieu de reboucler
+    U32 grownCapacity() const
+    {
+        if (m_capacity == 0) return 16;
+        INGA_ASSERT_RAW(m_capacity < 0xFFFFFFFFu, "SoAVector capacity exhausted");
+        if (m_capacity == 0xFFFFFFFFu) throw std::bad_alloc();
+        if (m_capacity > 0x7FFFFFFFu) return 0xFFFFFFFFu;
+        return m_capacity * 2;
+    }
+
+    template<size_t ... Is>
+    void reallocate(U32 newCapacity, std::index_sequence<Is...>)
+    {
+        // Une colonne par type, chacune commence sur une frontière de 64 octets
+        U64 offsets[ColumnCount];
+        U64 total = 0;
+        ((offsets[Is] = total, total = alignUp(total + (U64)sizeof(Ts) * newCapacity)), ...);
+
+        U8* block = (U8*)Allocator::alloc(total, ColumnAlignment, m_groupId, __FILE__, __LINE__);
+        if (!block) throw std::bad_alloc();
+
+        std::tuple<Ts*...> columns(reinterpret_cast<Ts*>(block + offsets[Is])...);
+
+        // Déplacement colonne par colonne puis destruction des anciens éléments
+        (relocateColumn<Is>(std::get<Is>(columns)), ...);
+
+        Allocator::free(m_block);
+        m_block = block;
+        m_columns = columns;
+        m_capacity = newCapacity;
+    }
+
+    template<size_t I>
+    void relocateColumn(ColumnType<I>* destination)
+    {
+        using T = ColumnType<I>;
+        T* source = std::get<I>(m_columns);
+        for (U32 i = 0; i < m_size; ++i)
+        {
+            new (&destination[i]) T(std::move(source[i]));
+            source[i].~T();
+        }
+    }
+
+    template<size_t ... Is, typename ... Args>
+    void constructAt(U32 index, std::index_sequence<Is...>, Args&& ... values)
+    {
+        (new (&std::get<Is>(m_columns)[index]) Ts(std::forward<Args>(values)), ...);
+    }
+
+    template<size_t ... Is>
+    void constructFrom(U32 index, std::tuple<Ts...>&& values, std::index_sequence<Is...>)
+    {
+        (new (&std::get<Is>(m_columns)[index]) Ts(std::move(std::get<Is>(values))), ...);
+    }
+
+    template<size_t ... Is>
+    void destroyAt(U32 index, std::index_sequence<Is...>)
+    {
+        (std::get<Is>(m_columns)[index].~Ts(), ...);
+    }
+
+    template<size_t ... Is>
+    void moveAssign(U32 destination, U32 source, std::index_sequence<Is...>)
+    {
+        ((std::get<Is>(m_columns)[destination] = std::move(std::get<Is>(m_columns)[source])), ...);
+    }
+
+    template<size_t ... Is>
+    void shiftDown(U32 index, std::index_sequence<Is...> seq)
+    {
+        for (U32 i = index; i + 1 < m_size; ++i)
+        {
+            moveAssign(i, i + 1, seq);
+        }
+    }
+
+    template<size_t ... Is>
+    Reference rowAt(U32 index, std::index_sequence<Is...>)
+    {
+        return Reference(std::get<Is>(m_columns)[index]...);
+    }
+
+    template<size_t ... Is>
+    ConstReference rowAt(U32 index, std::index_sequence<Is...>) const
+    {
+        return ConstReference(std::get<Is>(m_columns)[index]...);
+    }
+
+    void moveFrom(SoAVector& other)
+    {
+        m_block = other.m_block;
+        m_columns = other.m_columns;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        m_groupId = other.m_groupId;
+
+        other.m_block = nullptr;
+        other.m_columns = std::tuple<Ts*...>();
+        other.m_size = 0;
+        other.m_capacity = 0;
+    }
+
+private:
+    void* m_block = nullptr;
+    std::tuple<Ts*...> m_columns{};
+    U32 m_size = 0;
+    U32 m_capacity = 0;
+    U16 m_groupId = 0;
+};
+
+} // namespace Inga
+
+// Décomposition structurée : for (auto [p, v, l] : particles)
+template<typename ... Rs>
+struct std::tuple_size<Inga::SoARow<Rs...>> : std::integral_constant<size_t, sizeof...(Rs)> {};
+
+template<size_t I, typename ... Rs>
+struct std::tuple_element<I, Inga::SoARow<Rs...>> : std::tuple_element<I, std::tuple<Rs...>> {};
+
+#endif // INGA_SOA_VECTOR_H
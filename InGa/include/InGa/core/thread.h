@@ -0,0 +1,41 @@
+#ifndef INGA_THREAD_H
+#define INGA_THREAD_H
+
+#include "export.h"
+#include "inga_platform.h"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace Inga
+{
+    class INGA_API Thread
+    {
+    public:
+        // Identifiant compact (1, 2, 3...) attribué au premier appel sur chaque thread.
+        // Bien moins cher qu'un appel système et lisible dans les logs / captures.
+        static U32 getCurrentId();
+
+        // Nom visible dans les debuggers / profilers (tronqué à 15 caractères sous Linux)
+        static void setCurrentName(const char* name);
+
+        static U32 getHardwareThreadCount();
+
+        // Pause CPU pour les boucles d'attente active
+        static inline void spinPause()
+        {
+#if defined(_MSC_VER)
+            _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            __asm__ __volatile__("yield");
+#endif
+        }
+
+        static void yield();
+    };
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef INGA_TIME_H
+#define INGA_TIME_H
+
+#include "export.h"
+#include "inga_platform.h"
+#include <atomic>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace Inga
+{
+    /*
+     * Time : horloge haute résolution commune au moteur (Clock, profiler,
+     * timestamps des logs, stats de l'allocateur).
+     *
+     * now() renvoie des ticks : le TSC (rdtsc, quelques ns) quand il est
+     * invariant et accepté par l'OS, sinon l'horloge monotone de l'OS en ns.
+     * La fréquence est calibrée contre CLOCK_MONOTONIC au premier usage,
+     * puis affinée par recalibrate() sur une fenêtre de plus en plus longue.
+     *
+     * nowNs() est dans la base de CLOCK_MONOTONIC (steady_clock) : les
+     * timestamps restent comparables à ceux de l'OS et des autres outils.
+     */
+    class INGA_API Time
+    {
+    public:
+        enum Source : U8 { eSOURCE_NONE, eSOURCE_TSC, eSOURCE_MONOTONIC };
+
+        // Détection + calibration initiale (~5 ms) ; implicite au premier appel
+        static void init();
+
+        // Ticks bruts : seules les différences ont un sens
+        static inline U64 now()
+        {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            if (s_source.load(std::memory_order_relaxed) == eSOURCE_TSC) return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            if (s_source.load(std::memory_order_relaxed) == eSOURCE_TSC) return __builtin_ia32_rdtsc();
+#endif
+            return nowFallback();
+        }
+
+        // Durées en ticks -> unités
+        static inline U64 toNs(U64 ticks) { return (U64)((F64)ticks * nsPerTick()); }
+        static inline F64 toMicroseconds(U64 ticks) { return (F64)ticks * nsPerTick() * 1e-3; }
+        static inline F64 toSeconds(U64 ticks) { return (F64)ticks * nsPerTick() * 1e-9; }
+        static inline U64 fromNs(U64 ns) { return (U64)((F64)ns / nsPerTick()); }
+
+        // Instant en ticks -> ns dans la base de CLOCK_MONOTONIC
+        static U64 ticksToTimestampNs(U64 ticks);
+        static U64 nowNs() { return ticksToTimestampNs(now()); }
+
+        // Lecture directe de l'horloge de l'OS (référence de calibration)
+        static U64 monotonicNs();
+
+        // Affine la fréquence (au plus une fois par seconde, appel bon marché sinon)
+        static void recalibrate();
+
+        static Source getSource();
+        static U64 getFrequency();   // ticks par seconde
+
+    private:
+        static U64 nowFallback();
+        static F64 nsPerTick();
+
+        static std::atomic<Source> s_source;
+    };
+}
+
+#endif
@@ -3,23 +3,24 @@
 
 #include "export.h"
 #include "inga_platform.h"
+#include "profiler.h"
 
 namespace Inga
 {
-    class INGA_API ScopedTimer
+    // Zone du profiler (voir core/profiler.h) : plus aucun log par scope,
+    // le temps est agrégé par frame et lisible via Profiler::getLastFrame()
+    class ScopedTimer
     {
     public:
-        ScopedTimer(const char* name);
-        ~ScopedTimer();
+        explicit ScopedTimer(const char* name) : m_scope(name) {}
 
     private:
-        const char* m_name;
-        U64 m_startTime; // Stocké en microsecondes
+        ProfileScope m_scope;
     };
 }
 
 // Macros pour l'utilisation
-#define INGA_PROFILE_BLOCK(name) Inga::ScopedTimer timer_##__LINE__(name)
+#define INGA_PROFILE_BLOCK(name) INGA_PROFILE_ZONE(name)
 #define INGA_PROFILE_FUNC() INGA_PROFILE_BLOCK(__FUNCTION__)
 
 #endif
@@ -0,0 +1,174 @@
+#ifndef INGA_BINDLESS_TABLE_H
+#define INGA_BINDLESS_TABLE_H
+
+#include <InGa/core/export.h>
+#include <InGa/core/inga_platform.h>
+#include <InGa/core/container.h>
+#include <InGa/gfx/vulkan/vk_types.h>
+#include <mutex>
+
+namespace Inga
+{
+    class CRenderDevice;
+
+    // Un tableau de descripteurs par type ; le numéro de binding est celui du type
+    enum EBindlessType : U8
+    {
+        eBINDLESS_TEXTURE,          // binding 0 : texture2D    textures[]
+        eBINDLESS_SAMPLER,          // binding 1 : sampler      samplers[]
+        eBINDLESS_STORAGE_IMAGE,    // binding 2 : image2D      storageImages[]
+        eBINDLESS_BUFFER,           // binding 3 : buffer { } buffers[]
+        eBINDLESS_TYPE_COUNT
+    };
+
+    // Index dans le tableau + type + génération du slot : un handle libéré ne résout plus
+    struct SBindlessHandle
+    {
+        static const U32 INDEX_BITS = 20;
+        static const U32 TYPE_BITS = 2;
+        static const U32 GENERATION_BITS = 10;
+
+        U32 value = 0;              // 0 = invalide : la génération 0 n'est jamais distribuée
+
+        // Ce que le shader reçoit (push constants, buffer de matériaux...)
+        U32 index() const { return value & ((1u << INDEX_BITS) - 1); }
+        EBindlessType type() const { return (EBindlessType)((value >> INDEX_BITS) & ((1u << TYPE_BITS) - 1)); }
+        U32 generation() const { return value >> (INDEX_BITS + TYPE_BITS); }
+        bool isValid() const { return value != 0; }
+    };
+
+    // Capacités demandées ; réduites aux limites UPDATE_AFTER_BIND du GPU
+    struct SBindlessLimits
+    {
+        U32 textures = 65536;
+        U32 samplers = 1024;
+        U32 storageImages = 8192;
+        U32 buffers = 65536;
+    };
+
+    struct SBindlessStats
+    {
+        U32 capacity[eBINDLESS_TYPE_COUNT];
+        U32 used[eBINDLESS_TYPE_COUNT];
+        U32 pendingReleases;        // slots libérés, en attente de la fin des frames qui les lisent
+        U64 descriptorWrites;
+        U64 staleHandles;           // release() d'un handle périmé ou déjà libéré
+    };
+
+    /*
+     * CBindlessTable : table de ressources indexées par entier.
+     *
+     * Un seul descriptor set, alloué une fois, avec un grand tableau par type
+     * (UPDATE_AFTER_BIND | PARTIALLY_BOUND | UPDATE_UNUSED_WHILE_PENDING) :
+     * add*() écrit le descripteur dans un slot libre et rend un handle, même
+     * si le set est lié à des command buffers en vol. Le set est lié une fois
+     * par command buffer (bind()) ; les draws passent leurs index par push
+     * constants, sans aucune mise à jour de descripteur par draw.
+     *
+     * Les pipelines utilisent getPipelineLayout() (le set en 0, PUSH_CONSTANT_SIZE
+     * octets de push constants pour tous les stages) : un bind reste valide
+     * d'un pipeline à l'autre.
+     *
+     * release() invalide le handle tout de suite, mais le slot n'est réutilisé
+     * que lorsque chaque source de frames (un CContext, avec son nombre de
+     * vols) a soumis autant de frames que de vols : les frames en vol de tous
+     * les contextes peuvent encore le lire. Chaque source avance son propre
+     * compteur (nextFrame(source)) ; une source qui ne soumet plus rien
+     * retient le recyclage jusqu'à removeFrameSource().
+     *
+     * Thread-safe (un mutex) ; possédé par CRenderDevice.
+     */
+    class INGA_API CBindlessTable
+    {
+    public:
+        static const U32 PUSH_CONSTANT_SIZE = 128;  // minimum garanti par Vulkan
+        static const U32 MAX_FRAME_SOURCES = 8;
+        static const U32 INVALID_FRAME_SOURCE = 0xFFFFFFFF;
+
+        CBindlessTable() = default;
+        ~CBindlessTable();
+
+        CBindlessTable(const CBindlessTable&) = delete;
+        CBindlessTable& operator=(const CBindlessTable&) = delete;
+
+        bool initialize(CRenderDevice* device, const SBindlessLimits& limits = SBindlessLimits());
+        void shutdown();                    // GPU au repos
+
+        // Renvoient un handle invalide si le tableau est plein
+        SBindlessHandle addTexture(VkImageView view, VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        SBindlessHandle addSampler(VkSampler sampler);
+        SBindlessHandle addStorageImage(VkImageView view);
+        SBindlessHandle addBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+        void release(SBindlessHandle handle);
+        bool isValid(SBindlessHandle handle) const;
+
+        // Un contexte qui lie la table s'inscrit avec son nombre de vols (INVALID_FRAME_SOURCE si plein)
+        U32  addFrameSource(U32 flightCount);
+        void removeFrameSource(U32 source);     // ses frames sont terminées (GPU au repos)
+
+        // Après chaque frame soumise par la source ; recycle les slots que plus aucun vol ne lit
+        void nextFrame(U32 source);
+
+        // Lie le set 0 ; à refaire dans chaque secondaire (l'état lié n'est pas hérité)
+        void bind(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint) const;
+        void pushConstants(VkCommandBuffer cmd, const void* data, U32 size, U32 offset = 0) const;
+
+        VkDescriptorSetLayout getSetLayout() const { return m_setLayout; }
+        VkPipelineLayout getPipelineLayout() const { return m_pipelineLayout; }
+        VkDescriptorSet getSet() const { return m_set; }
+
+        SBindlessStats getStats() const;
+
+        inline bool isInitialized() const { return m_device != VK_NULL_HANDLE; }
+
+    private:
+        static const U16 LIVE_BIT = 0x8000;
+
+        struct SSlots
+        {
+            VkDescriptorType descriptorType;
+            U32              capacity = 0;
+            U32              highWater = 0;     // slots jamais distribués au-delà
+            U32              used = 0;
+            Vector<U16>      generations;       // génération courante | LIVE_BIT
+            Vector<U32>      freeSlots;
+        };
+
+        struct SFrameSource
+        {
+            bool active;
+            U32  latency;                       // nombre de vols
+            U32  frame;                         // frames soumises (comparées par différence)
+        };
+
+        struct SPendingRelease
+        {
+            U32 value;
+            U32 frames[MAX_FRAME_SOURCES];      // compteurs des sources au release()
+        };
+
+        SBindlessHandle allocateLocked(EBindlessType type);
+        void writeLocked(SBindlessHandle handle, const VkDescriptorImageInfo* image, const VkDescriptorBufferInfo* buffer);
+        bool isValidLocked(SBindlessHandle handle) const;
+        bool isRetiredLocked(const SPendingRelease& release) const;
+        void retireLocked();
+
+    private:
+        VkDevice              m_device = VK_NULL_HANDLE;
+        VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+        VkDescriptorPool      m_pool = VK_NULL_HANDLE;
+        VkDescriptorSet       m_set = VK_NULL_HANDLE;
+        VkPipelineLayout      m_pipelineLayout = VK_NULL_HANDLE;
+
+        SSlots                  m_slots[eBINDLESS_TYPE_COUNT];
+        Vector<SPendingRelease> m_pendingReleases;
+        SFrameSource            m_sources[MAX_FRAME_SOURCES] = {};
+        U32                     m_activeSources = 0;
+
+        mutable std::mutex m_mutex;
+        SBindlessStats     m_stats{};
+    };
+}
+
+#endif
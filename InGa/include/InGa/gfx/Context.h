@@ -5,6 +5,8 @@
 #include <InGa/core/export.h>
 #include <InGa/core/Window.h>
 #include <InGa/gfx/RenderDevice.h>
+#include <InGa/gfx/RenderGraph.h>
+#include <InGa/core/frame_stats.h>
 
 namespace Inga
 {
@@ -20,6 +22,38 @@ namespace Inga
         U8               useHighPerformanceGpu; // If you have Integrated + Dedicated
     };
 
+    // Image de swapchain de la frame en cours d'enregistrement
+    struct SFrameTarget
+    {
+        VkImage     image;
+        VkImageView view;
+        VkExtent2D  extent;
+        VkFormat    format;
+        U32         imageIndex;
+        U32         flightIndex;
+    };
+
+    // Temps CPU d'une frame (ns) : des attentes longues = GPU ou présentation en retard
+    struct SFrameTiming
+    {
+        U64 frameIndex;
+        U64 fenceWaitNs;    // fence du vol (+ celle d'un autre vol qui tenait encore l'image)
+        U64 acquireNs;      // vkAcquireNextImageKHR : bloque sur le moteur de présentation
+        U64 recordNs;
+        U64 submitNs;       // vkQueueSubmit2 + vkQueuePresentKHR
+        U64 cpuWaitNs;      // fenceWaitNs + acquireNs
+        U32 secondaryCount; // secondaires exécutés par le primaire (0 = enregistrement direct)
+    };
+
+    // Appelé dans draw(), entre vkCmdBeginRendering (image effacée) et vkCmdEndRendering
+    typedef void (*RecordFrameCallback)(VkCommandBuffer cmd, const SFrameTarget& target, void* userData);
+
+    // Appelé sur les threads du JobSystem, chacun dans son secondaire, pour les éléments [begin, end)
+    typedef void (*RecordRangeCallback)(VkCommandBuffer cmd, U32 begin, U32 end, const SFrameTarget& target, void* userData);
+
+    // Déclare les passes de la frame ; backbuffer = image de swapchain, passée en PRESENT_SRC par le graphe
+    typedef void (*BuildRenderGraphCallback)(CRenderGraph& graph, RenderResource backbuffer, const SFrameTarget& target, void* userData);
+
     class INGA_API CContext
     {
     public:
@@ -34,18 +68,59 @@ namespace Inga
         void shutdown();
         void setupSyncObjects(); 
         void cleanup();
+
+        bool isOpen() const { return m_window.isOpen(); }
+
+        void setRecordCallback(RecordFrameCallback callback, void* userData = nullptr);
+
+        // Enregistrement réparti : itemCount éléments par lots de batchSize, un secondaire par lot,
+        // exécutés dans l'ordre des lots (après le callback simple). À rappeler quand itemCount change.
+        // Sans JobSystem démarré avant initialize(), tout est enregistré sur le primaire.
+        void setParallelRecordCallback(RecordRangeCallback callback, U32 itemCount, U32 batchSize = 64, void* userData = nullptr);
+        void setClearColor(F32 r, F32 g, F32 b, F32 a = 1.0f);
+
+        // Remplace l'effacement + callbacks : le graphe est reconstruit et compilé à chaque frame
+        // (ses images transitoires sont gardées tant que leurs tailles ne changent pas)
+        void setRenderGraphCallback(BuildRenderGraphCallback callback, void* userData = nullptr);
+        CRenderGraph& getRenderGraph() { return m_renderGraph; }
+
+        // Dernière frame dessinée, et fenêtre glissante des attentes CPU (fence + acquire)
+        const SFrameTiming& getLastFrameTiming() const { return m_lastTiming; }
+        const FrameStats& getCpuWaitStats() const { return m_cpuWaitStats; }
 private:
 
     bool createSurface(const Window & window, VkInstance instance);
+    bool createSwapchain(VkSwapchainKHR oldSwapchain);
+    bool recreateSwapchain();
     void initCommandResources();
+    void recoverFailedSubmit(SCommandBufferFrame& frame);
+    U32  recordFrame(SCommandBufferFrame& frame, const SFrameTarget& target, U64& uploadWaitValue);
+    VkCommandBuffer beginSecondary(SCommandBufferFrame& frame, const SFrameTarget& target);
+    static void recordRangeJob(U32 begin, U32 end, void* userData);
 
     private:
 		Window m_window;
         SContextConf m_config;
         CRenderDevice* m_renderDevice = nullptr;
         SSwapchain m_swapchain;
-        SCommandPool m_cmdPoolGFX;
         Vector<SCommandBufferFrame> m_cmdFrames;
+
+        RecordFrameCallback m_recordCallback = nullptr;
+        void*               m_recordUserData = nullptr;
+        RecordRangeCallback m_parallelCallback = nullptr;
+        void*               m_parallelUserData = nullptr;
+        U32                 m_parallelItemCount = 0;
+        U32                 m_parallelBatchSize = 64;
+        VkClearColorValue   m_clearColor = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+        BuildRenderGraphCallback m_graphCallback = nullptr;
+        void*               m_graphUserData = nullptr;
+        CRenderGraph        m_renderGraph;
+        bool                m_swapchainDirty = false;
+
+        U64          m_frameIndex = 0;
+        U32          m_bindlessSource = CBindlessTable::INVALID_FRAME_SOURCE;   // compteur de frames dans la table partagée
+        SFrameTiming m_lastTiming{};
+        FrameStats   m_cpuWaitStats;
     };
 }
 
@@ -0,0 +1,151 @@
+#ifndef INGA_GPU_MEMORY_H
+#define INGA_GPU_MEMORY_H
+
+#include <InGa/core/export.h>
+#include <InGa/core/inga_platform.h>
+#include <InGa/core/container.h>
+#include <InGa/core/offset_allocator.h>
+#include <InGa/gfx/vulkan/vk_types.h>
+#include <mutex>
+
+namespace Inga
+{
+    enum EGpuMemoryUsage : U8
+    {
+        eGPU_MEMORY_DEVICE,     // DEVICE_LOCAL, jamais mappée
+        eGPU_MEMORY_UPLOAD,     // HOST_VISIBLE | HOST_COHERENT, mappée en permanence (staging, constantes)
+        eGPU_MEMORY_READBACK,   // HOST_VISIBLE, HOST_CACHED de préférence : invalidate() avant lecture
+    };
+
+    struct SGpuAllocation
+    {
+        static const U32 DEDICATED = 0xFFFFFFFF;
+
+        VkDeviceMemory   memory = VK_NULL_HANDLE;
+        VkDeviceSize     offset = 0;
+        VkDeviceSize     size = 0;
+        void*            mapped = nullptr;          // déjà décalé de offset ; nullptr si non mappable
+        U32              memoryType = 0xFFFFFFFF;
+        U32              blockIndex = DEDICATED;
+        U8               linear = 1;                // pool buffers / images linéaires, sinon images optimales
+        OffsetAllocation slot;
+
+        bool isValid() const { return memory != VK_NULL_HANDLE; }
+    };
+
+    struct SGpuMemoryStats
+    {
+        U64 blockBytes;             // VkDeviceMemory des blocs partagés
+        U64 usedBytes;              // octets sous-alloués dans ces blocs (alignement compris)
+        U64 dedicatedBytes;
+        U32 blockCount;
+        U32 allocationCount;        // sous-allocations vivantes
+        U32 dedicatedCount;
+        U32 deviceMemoryCount;      // vkAllocateMemory vivants (blocs + dédiées)
+        U32 maxDeviceMemoryCount;   // maxMemoryAllocationCount du GPU
+        U64 heapUsage[VK_MAX_MEMORY_HEAPS];
+        U64 heapSize[VK_MAX_MEMORY_HEAPS];
+        U32 heapCount;
+    };
+
+    /*
+     * CGpuMemoryAllocator : sous-allocation de la mémoire GPU.
+     *
+     * Chaque type mémoire a deux pools de gros blocs VkDeviceMemory (buffers et
+     * images linéaires / images optimales : bufferImageGranularity ne s'applique
+     * jamais entre voisins). Un bloc est découpé par un OffsetAllocator (TLSF,
+     * O(1), métadonnées côté CPU) en unités de ALLOCATION_UNIT octets.
+     *
+     * Les ressources plus grosses que la moitié d'un bloc, ou dont le pilote
+     * préfère une allocation dédiée (VkMemoryDedicatedRequirements), ont leur
+     * propre VkDeviceMemory. La mémoire host-visible est mappée une fois par bloc.
+     *
+     * Thread-safe (un mutex) ; possédé par CRenderDevice.
+     */
+    class INGA_API CGpuMemoryAllocator
+    {
+    public:
+        static const VkDeviceSize DEFAULT_BLOCK_SIZE = 256ull * 1024 * 1024;
+        static const VkDeviceSize ALLOCATION_UNIT = 256;
+        static const U32 MAX_ALLOCATIONS_PER_BLOCK = 64 * 1024;
+
+        CGpuMemoryAllocator() = default;
+        ~CGpuMemoryAllocator();
+
+        CGpuMemoryAllocator(const CGpuMemoryAllocator&) = delete;
+        CGpuMemoryAllocator& operator=(const CGpuMemoryAllocator&) = delete;
+
+        bool initialize(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE);
+        void shutdown();
+
+        // Mémoire brute : linear = false pour une image VK_IMAGE_TILING_OPTIMAL
+        bool allocate(const VkMemoryRequirements& requirements, EGpuMemoryUsage usage, bool linear, SGpuAllocation& allocation);
+        void free(SGpuAllocation& allocation);
+
+        // Création + allocation + bind ; en cas d'échec rien ne reste alloué
+        bool createBuffer(const VkBufferCreateInfo& info, EGpuMemoryUsage usage, VkBuffer& buffer, SGpuAllocation& allocation);
+        void destroyBuffer(VkBuffer& buffer, SGpuAllocation& allocation);
+        bool createImage(const VkImageCreateInfo& info, EGpuMemoryUsage usage, VkImage& image, SGpuAllocation& allocation);
+        void destroyImage(VkImage& image, SGpuAllocation& allocation);
+
+        // Nécessaires seulement sur un type mémoire non HOST_COHERENT (readback)
+        void flush(const SGpuAllocation& allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+        void invalidate(const SGpuAllocation& allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+        SGpuMemoryStats getStats() const;
+        void logStats() const;
+
+        inline bool isInitialized() const { return m_device != VK_NULL_HANDLE; }
+
+    private:
+        struct SBlock
+        {
+            VkDeviceMemory  memory = VK_NULL_HANDLE;
+            VkDeviceSize    size = 0;
+            void*           mapped = nullptr;
+            OffsetAllocator allocator;
+        };
+
+        static SBlock* createBlock();
+        static void destroyBlock(SBlock* block);
+
+        // Vector<SBlock*> : l'OffsetAllocator n'est pas déplaçable ; nullptr = emplacement libéré
+        struct SPool
+        {
+            Vector<SBlock*> blocks;
+        };
+
+        U32 findMemoryType(U32 typeBits, EGpuMemoryUsage usage) const;
+        bool allocateDeviceMemory(VkDeviceSize size, U32 memoryType, bool linear,
+                                  VkImage dedicatedImage, VkBuffer dedicatedBuffer,
+                                  VkDeviceMemory& memory, void*& mapped);
+        void freeDeviceMemory(VkDeviceMemory memory, VkDeviceSize size, U32 memoryType, bool mapped);
+
+        bool allocateInternal(const VkMemoryRequirements& requirements, EGpuMemoryUsage usage, bool linear,
+                              bool dedicated, VkImage dedicatedImage, VkBuffer dedicatedBuffer,
+                              SGpuAllocation& allocation);
+        bool allocateFromPool(VkDeviceSize size, VkDeviceSize alignment, U32 memoryType, bool linear, SGpuAllocation& allocation);
+
+        bool isHostVisible(U32 memoryType) const;
+        VkMappedMemoryRange mappedRange(const SGpuAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const;
+
+    private:
+        VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+        VkDevice         m_device = VK_NULL_HANDLE;
+        VkDeviceSize     m_blockSize = DEFAULT_BLOCK_SIZE;
+        VkDeviceSize     m_nonCoherentAtomSize = 1;
+        U32              m_maxDeviceMemoryCount = 4096;
+
+        VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+        SPool m_pools[VK_MAX_MEMORY_TYPES][2];      // [type][0 = optimal, 1 = linéaire]
+
+        mutable std::mutex m_mutex;
+        U32 m_deviceMemoryCount = 0;
+        U32 m_dedicatedCount = 0;
+        U64 m_dedicatedBytes = 0;
+        U64 m_heapUsage[VK_MAX_MEMORY_HEAPS] = {};
+        bool m_warnedAllocationCount = false;
+    };
+}
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef INGA_PIPELINE_CACHE_H
+#define INGA_PIPELINE_CACHE_H
+
+#include <InGa/core/export.h>
+#include <InGa/core/inga_platform.h>
+#include <InGa/core/container.h>
+#include <InGa/gfx/vulkan/vk_types.h>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Inga
+{
+    enum EPipelineCacheLoad : U8
+    {
+        ePIPELINE_CACHE_COLD,       // pas de fichier : démarrage à froid
+        ePIPELINE_CACHE_LOADED,
+        ePIPELINE_CACHE_REJECTED,   // autre GPU / pilote, ou fichier tronqué / corrompu
+    };
+
+    struct SPipelineCacheStats
+    {
+        EPipelineCacheLoad loadResult;
+        U64 loadedBytes;
+        U64 loadTimeNs;             // lecture + validation + vkCreatePipelineCache
+        U64 savedBytes;             // dernière sauvegarde
+        U64 saveTimeNs;
+        U32 saveCount;
+        U32 mergedCaches;           // caches de workers fusionnés depuis le départ
+    };
+
+    /*
+     * CPipelineCache : VkPipelineCache persistant sur disque.
+     *
+     * Le fichier = un en-tête moteur (taille + hash des données, GPU et pilote
+     * qui l'ont produit) suivi du blob de vkGetPipelineCacheData. Au chargement,
+     * l'en-tête moteur puis celui de Vulkan (vendor, device, pipelineCacheUUID)
+     * sont vérifiés : un pilote n'a pas à survivre à un blob qui n'est pas le sien.
+     *
+     * Workers : createWorkerCache() rend un cache privé (amorcé avec le blob
+     * chargé), submitWorkerCache() le rend après usage ; merge() les fusionne.
+     * vkMergePipelineCaches exige un accès exclusif au cache principal :
+     * toute création de pipeline avec getCache() se fait sous lockForUse(),
+     * que merge() / save() / update() prennent en exclusif.
+     *
+     *   auto use = pipelineCache.lockForUse();
+     *   vkCreateGraphicsPipelines(device, pipelineCache.getCache(), ...);
+     *
+     * save() écrit path.tmp puis le renomme : un crash pendant l'écriture
+     * laisse l'ancien fichier intact. Possédé par CRenderDevice.
+     */
+    class INGA_API CPipelineCache
+    {
+    public:
+        static const U64 MAX_FILE_SIZE = 256ull * 1024 * 1024;
+
+        CPipelineCache() = default;
+        ~CPipelineCache();
+
+        CPipelineCache(const CPipelineCache&) = delete;
+        CPipelineCache& operator=(const CPipelineCache&) = delete;
+
+        // Un fichier absent ou rejeté n'est pas une erreur : on part d'un cache vide
+        bool initialize(VkPhysicalDevice physicalDevice, VkDevice device, const char* path);
+
+        // Fusionne, sauvegarde et détruit
+        void shutdown();
+
+        VkPipelineCache getCache() const { return m_cache; }
+
+        // Verrou partagé entre threads qui créent des pipelines avec getCache()
+        std::shared_lock<std::shared_mutex> lockForUse() const { return std::shared_lock<std::shared_mutex>(m_useMutex); }
+
+        VkPipelineCache createWorkerCache();
+        void submitWorkerCache(VkPipelineCache cache);
+
+        // Renvoient false si rien n'a été fait (rien à fusionner / erreur d'écriture)
+        bool merge();
+        bool save();
+
+        // 0 = sauvegarde seulement à shutdown() ; sinon update() sauvegarde si le cache a grossi.
+        // update() ne bloque pas : une création de pipeline en cours repousse la sauvegarde
+        void setAutoSaveInterval(F64 seconds);
+        void update();
+
+        SPipelineCacheStats getStats() const;
+
+        inline bool isInitialized() const { return m_device != VK_NULL_HANDLE; }
+
+    private:
+        // Préfixe du fichier, devant le blob Vulkan
+        struct SFileHeader
+        {
+            U32 magic;
+            U32 version;
+            U64 dataSize;
+            U64 dataHash;
+            U32 vendorID;
+            U32 deviceID;
+            U32 driverVersion;
+            U8  pipelineCacheUUID[VK_UUID_SIZE];
+        };
+
+        bool loadFile(Vector<U8>& data);
+        bool validateBlob(const U8* data, U64 size) const;
+        bool mergeLocked();
+        bool saveLocked(U64 start);
+
+    private:
+        VkDevice         m_device = VK_NULL_HANDLE;
+        VkPipelineCache  m_cache = VK_NULL_HANDLE;
+        VkPhysicalDeviceProperties m_properties{};
+        char             m_path[512] = {};
+
+        Vector<U8>              m_initialData;      // amorce des caches de workers
+        Vector<VkPipelineCache> m_workerCaches;     // rendus, en attente de fusion
+
+        U64 m_autoSaveTicks = 0;
+        U64 m_lastSaveTicks = 0;
+        U64 m_lastSavedSize = 0;
+
+        mutable std::shared_mutex m_useMutex;   // avant m_mutex : créations (partagé) / merge, save (exclusif)
+        mutable std::mutex  m_mutex;
+        SPipelineCacheStats m_stats{};
+    };
+}
+
+#endif
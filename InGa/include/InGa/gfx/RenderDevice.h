@@ -4,9 +4,23 @@
 #include <InGa/core/export.h>
 #include <InGa/core/inga_platform.h>
 #include <InGa/gfx/vulkan/vk_types.h>
+#include <InGa/gfx/GpuMemory.h>
+#include <InGa/gfx/UploadService.h>
+#include <InGa/gfx/PipelineCache.h>
+#include <InGa/gfx/BindlessTable.h>
+#include <mutex>
 
 namespace Inga
 {
+    enum EQueueType : U8
+    {
+        eQUEUE_GRAPHICS,
+        eQUEUE_COMPUTE,
+        eQUEUE_TRANSFER,
+        eQUEUE_PRESENT,
+        eQUEUE_COUNT
+    };
+
     class INGA_API CRenderDevice
     {
     public:
@@ -18,10 +32,20 @@ namespace Inga
 
         bool findPresentQueue(VkSurfaceKHR surface);
 
+        // vkQueueSubmit2 exige une synchronisation externe : un mutex par VkQueue distincte
+        // (les types qui partagent une même queue partagent aussi le verrou)
+        VkResult submit(EQueueType type, U32 submitCount, const VkSubmitInfo2* submits, VkFence fence);
+        VkResult present(const VkPresentInfoKHR* presentInfo);
+
         // Getters
         VkDevice getDevice() const { return m_logicalDevice; }
         VkInstance getInstance() const { return m_instance; }
         VkPhysicalDevice getPhysicalDevice() const { return m_physicalDevice; }
+        CGpuMemoryAllocator& getMemoryAllocator() { return m_memoryAllocator; }
+        CUploadService& getUploadService() { return m_uploadService; }
+        CPipelineCache& getPipelineCache() { return m_pipelineCache; }
+        CBindlessTable& getBindlessTable() { return m_bindlessTable; }
+        VkQueue getQueue(EQueueType type) const;
         
         inline U32 getGraphicsQueueFamily() const { return m_graphicsQueueFamily; }
         inline U32 getPresentQueueFamily()  const { return m_presentQueueFamily; }
@@ -37,6 +61,7 @@ namespace Inga
         bool checkDeviceQueueSupport(VkPhysicalDevice device);
         bool checkDeviceExtensionSupport(VkPhysicalDevice device);
         I32  rateDeviceSuitability(VkPhysicalDevice device);
+        void updateQueueLocks();
 
     private:
         VkInstance       m_instance       = VK_NULL_HANDLE;
@@ -48,6 +73,14 @@ namespace Inga
         VkQueue m_computeQueue  = VK_NULL_HANDLE;
         VkQueue m_transferQueue = VK_NULL_HANDLE;
 
+        CGpuMemoryAllocator m_memoryAllocator;
+        CUploadService      m_uploadService;
+        CPipelineCache      m_pipelineCache;
+        CBindlessTable      m_bindlessTable;
+
+        std::mutex m_queueMutex[eQUEUE_COUNT];
+        U8 m_queueLock[eQUEUE_COUNT] = { eQUEUE_GRAPHICS, eQUEUE_COMPUTE, eQUEUE_TRANSFER, eQUEUE_PRESENT };
+
         VkDebugUtilsMessengerEXT m_debugMessenger = VK_NULL_HANDLE;
         U32 m_graphicsQueueFamily = 0xFFFFFFFF;
         U32 m_presentQueueFamily  = 0xFFFFFFFF;
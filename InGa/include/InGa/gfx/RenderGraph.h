@@ -0,0 +1,260 @@
+#ifndef INGA_RENDER_GRAPH_H
+#define INGA_RENDER_GRAPH_H
+
+#include <InGa/core/export.h>
+#include <InGa/core/inga_platform.h>
+#include <InGa/core/container.h>
+#include <InGa/gfx/GpuMemory.h>
+#include <InGa/gfx/vulkan/vk_types.h>
+
+namespace Inga
+{
+    class CRenderDevice;
+    class CRenderGraph;
+
+    enum ERenderPassType : U8
+    {
+        eRENDER_PASS_GRAPHICS,      // rendu dynamique ouvert par le graphe sur ses attachments
+        eRENDER_PASS_COMPUTE,
+        eRENDER_PASS_TRANSFER,
+    };
+
+    // Usage d'une ressource par une passe : étape, accès et layout en découlent
+    enum ERenderAccess : U8
+    {
+        eACCESS_COLOR_ATTACHMENT,
+        eACCESS_DEPTH_ATTACHMENT,
+        eACCESS_DEPTH_READ,         // attachment depth en lecture seule
+        eACCESS_SAMPLED,
+        eACCESS_STORAGE_READ,
+        eACCESS_STORAGE_WRITE,
+        eACCESS_TRANSFER_SRC,
+        eACCESS_TRANSFER_DST,
+        eACCESS_VERTEX_BUFFER,
+        eACCESS_INDEX_BUFFER,
+        eACCESS_INDIRECT_BUFFER,
+        eACCESS_UNIFORM_BUFFER,
+        eACCESS_COUNT
+    };
+
+    typedef U32 RenderResource;
+    typedef void (*RenderPassCallback)(VkCommandBuffer cmd, CRenderGraph& graph, void* userData);
+
+    struct SRenderImageDesc
+    {
+        VkFormat              format = VK_FORMAT_UNDEFINED;
+        VkExtent2D            extent = { 0, 0 };
+        U32                   mipLevels = 1;
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+        VkImageUsageFlags     usage = 0;    // en plus de l'usage déduit des accès
+    };
+
+    // État d'une ressource importée à l'entrée et à la sortie du graphe
+    struct SRenderResourceState
+    {
+        VkImageLayout         layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2        accessMask = VK_ACCESS_2_NONE;
+    };
+
+    struct SRenderGraphStats
+    {
+        U32 passCount;
+        U32 culledPassCount;
+        U32 barrierBatches;         // vkCmdPipelineBarrier2 par exécution
+        U32 imageBarriers;
+        U32 memoryBarriers;         // barrières globales (buffers)
+        U32 transientImages;
+        U64 transientBytes;         // mémoire réellement allouée (aliasing compris)
+        U64 unaliasedBytes;         // ce qu'aurait coûté une allocation par image
+        U32 physicalRebuilds;       // images transitoires recréées depuis le départ
+    };
+
+    /*
+     * CRenderGraph : graphe de frame.
+     *
+     * Chaque frame : reset(), déclaration des ressources (transitoires ou
+     * importées) et des passes avec leurs accès (use), puis compile() et
+     * execute(cmd). L'ordre de déclaration fixe la sémantique : une lecture
+     * voit la dernière écriture déclarée avant elle.
+     *
+     * compile() :
+     *  - supprime les passes dont le résultat n'atteint ni une ressource
+     *    importée ni une passe setSideEffect() ;
+     *  - ordonne les passes (topologique ; une passe indépendante de la
+     *    précédente passe devant, pour écarter producteur et consommateur) ;
+     *  - calcule une seule vkCmdPipelineBarrier2 par passe au plus : les
+     *    lectures successives d'une même écriture sont couvertes par la
+     *    première barrière, les buffers partagent une barrière globale ;
+     *  - place les images transitoires dans des tas communs : deux images
+     *    dont les durées de vie ne se croisent pas partagent la mémoire.
+     *
+     * Les images transitoires sont gardées d'un compile() à l'autre tant que
+     * leurs descriptions et leur placement ne changent pas. Sinon elles sont
+     * recréées après un vkDeviceWaitIdle (redimensionnement, nouveau graphe).
+     */
+    class INGA_API CRenderGraph
+    {
+    public:
+        static const RenderResource INVALID_RESOURCE = 0xFFFFFFFF;
+        static const U32 MAX_COLOR_ATTACHMENTS = 8;
+
+        CRenderGraph() = default;
+        ~CRenderGraph();
+
+        CRenderGraph(const CRenderGraph&) = delete;
+        CRenderGraph& operator=(const CRenderGraph&) = delete;
+
+        bool initialize(CRenderDevice* device);
+        void shutdown();                    // GPU au repos
+
+        // Oublie passes et ressources ; les images transitoires restent pour le prochain compile()
+        void reset();
+
+        RenderResource createImage(const char* name, const SRenderImageDesc& desc);
+        RenderResource importImage(const char* name, VkImage image, VkImageView view, VkFormat format, VkExtent2D extent,
+                                   const SRenderResourceState& initial, const SRenderResourceState& final);
+        RenderResource importBuffer(const char* name, VkBuffer buffer,
+                                    const SRenderResourceState& initial = SRenderResourceState());
+
+        U32 addPass(const char* name, ERenderPassType type, RenderPassCallback callback, void* userData = nullptr);
+        void use(U32 pass, RenderResource resource, ERenderAccess access);
+        void clear(U32 pass, RenderResource resource, const VkClearValue& value);
+        void setSideEffect(U32 pass);
+
+        bool compile();
+        void execute(VkCommandBuffer cmd);
+
+        // Pendant execute() : handles physiques
+        VkImage     getImage(RenderResource resource) const;
+        VkImageView getImageView(RenderResource resource) const;
+        VkBuffer    getBuffer(RenderResource resource) const;
+        VkExtent2D  getExtent(RenderResource resource) const;
+
+        const SRenderGraphStats& getStats() const { return m_stats; }
+        inline bool isInitialized() const { return m_device != nullptr; }
+
+    private:
+        struct SResource
+        {
+            const char*          name;
+            bool                 imported;
+            bool                 isBuffer;
+            SRenderImageDesc     desc;
+            VkImage              image;
+            VkImageView          view;
+            VkBuffer             buffer;
+            SRenderResourceState initial;
+            SRenderResourceState final;
+            VkImageUsageFlags    usage;         // déduit des accès (transitoires)
+            U32                  physical;      // index dans m_physical, transitoires vivantes
+            U32                  firstOrder;    // durée de vie dans l'ordre d'exécution
+            U32                  lastOrder;
+            VkPipelineStageFlags2 lastStages;   // dernier usage : source des alias suivants
+            VkAccessFlags2        lastWrites;
+        };
+
+        struct SUse
+        {
+            U32                 pass;
+            RenderResource      resource;
+            ERenderAccess       access;
+            bool                clear;
+            VkClearValue        clearValue;
+            VkAttachmentLoadOp  loadOp;
+            VkAttachmentStoreOp storeOp;
+        };
+
+        struct SPass
+        {
+            const char*         name;
+            ERenderPassType     type;
+            RenderPassCallback  callback;
+            void*               userData;
+            bool                sideEffect;
+            bool                alive;
+            U32                 useBegin;       // dans m_passUses
+            U32                 useCount;
+            U32                 edgeBegin;      // dans m_edges (arêtes entrantes)
+            U32                 edgeCount;
+            U32                 barrierBegin;   // dans m_imageBarriers
+            U32                 barrierCount;
+            VkMemoryBarrier2    memoryBarrier;
+            bool                hasMemoryBarrier;
+        };
+
+        struct SEdge
+        {
+            U32  from;
+            U32  to;
+            bool strong;                        // RAW / WAW : garde la source en vie ; WAR : ordre seulement
+        };
+
+        struct SPhysicalImage
+        {
+            SRenderImageDesc     desc;
+            VkImageUsageFlags    usage;
+            VkImage              image;
+            VkImageView          view;
+            VkMemoryRequirements requirements;
+            U32                  heap;
+            VkDeviceSize         offset;
+            U32                  firstOrder;
+            U32                  lastOrder;
+            VkPipelineStageFlags2 lastStages;   // dernier usage au compile() précédent
+            VkAccessFlags2        lastWrites;
+        };
+
+        struct SHeap
+        {
+            U32            memoryTypeBits;
+            VkDeviceSize   size;
+            VkDeviceSize   alignment;
+            SGpuAllocation allocation;
+        };
+
+        void buildPassUses();
+        void buildEdges();
+        void cullPasses();
+        void schedulePasses();
+        bool realizeTransients();
+        void computeBarriers();
+
+        void placeTransients(Vector<SPhysicalImage>& images, Vector<SHeap>& heaps) const;
+        bool createPhysical(Vector<SPhysicalImage>& images, Vector<SHeap>& heaps);
+        void destroyPhysical(Vector<SPhysicalImage>& images, Vector<SHeap>& heaps);
+
+        void addImageBarrier(const SResource& resource, VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+                             VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess, VkImageLayout oldLayout, VkImageLayout newLayout);
+
+    private:
+        CRenderDevice* m_device = nullptr;
+
+        Vector<SResource> m_resources;
+        Vector<SUse>      m_uses;
+        Vector<SPass>     m_passes;
+
+        // Tables de compile() : gardées d'une frame à l'autre pour leur capacité
+        Vector<U32>   m_passUses;
+        Vector<SEdge> m_edges;
+        Vector<U32>   m_order;
+        Vector<U32>   m_lastWriter;         // par ressource ; curseurs dans computeBarriers()
+        Vector<U32>   m_readerHead;         // lectures depuis la dernière écriture : liste chaînée
+        Vector<U32>   m_readerLinks;        // paires (passe, suivant)
+        Vector<U32>   m_indegree;
+        Vector<U32>   m_ready;
+        Vector<U32>   m_resourceUses;       // usages dans l'ordre d'exécution, groupés par ressource
+        Vector<U32>   m_resourceUseBegin;
+        Vector<U8>    m_covered;            // lecture déjà couverte par une barrière précédente
+        Vector<VkImageMemoryBarrier2> m_imageBarriers;
+        U32           m_finalBarrierBegin = 0;
+        bool          m_compiled = false;
+
+        Vector<SPhysicalImage> m_physical;
+        Vector<SHeap>          m_heaps;
+
+        SRenderGraphStats m_stats{};
+    };
+}
+
+#endif
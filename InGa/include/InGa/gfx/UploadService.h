@@ -0,0 +1,188 @@
+#ifndef INGA_UPLOAD_SERVICE_H
+#define INGA_UPLOAD_SERVICE_H
+
+#include <InGa/core/export.h>
+#include <InGa/core/inga_platform.h>
+#include <InGa/core/container.h>
+#include <InGa/gfx/GpuMemory.h>
+#include <InGa/gfx/vulkan/vk_types.h>
+#include <mutex>
+
+namespace Inga
+{
+    class CRenderDevice;
+
+    // Consommateur d'un upload : la famille qui lira la ressource et comment
+    struct SUploadTarget
+    {
+        U32                   queueFamily = 0xFFFFFFFF;     // 0xFFFFFFFF = famille graphics
+        VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        VkAccessFlags2        accessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+    };
+
+    // Un mip (et une plage de couches) entier ou partiel ; le contenu précédent est perdu
+    struct SImageUpload
+    {
+        VkImage            image = VK_NULL_HANDLE;
+        VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        U32                mipLevel = 0;
+        U32                baseArrayLayer = 0;
+        U32                layerCount = 1;
+        VkOffset3D         offset = { 0, 0, 0 };
+        VkExtent3D         extent = { 0, 0, 1 };
+        U32                bufferRowLength = 0;     // 0 = lignes jointives
+        U32                bufferImageHeight = 0;
+        U32                texelBlockSize = 0;      // octets par texel ou bloc compressé (RGB8 : 3), 0 = 16
+        VkImageLayout      finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    };
+
+    struct SUploadStats
+    {
+        U64 bytesUploaded;
+        U64 batchesSubmitted;
+        U64 ringStalls;             // attentes CPU : anneau de staging plein
+        U64 temporaryBuffers;       // uploads trop gros pour l'anneau
+        U64 completedValue;
+        U64 submittedValue;
+    };
+
+    /*
+     * CUploadService : uploads asynchrones sur la queue de transfert.
+     *
+     * Les données sont copiées dans un anneau de staging mappé en permanence,
+     * les copies sont enregistrées dans un lot (copies consécutives vers le même
+     * buffer fusionnées en un seul vkCmdCopyBuffer) puis soumises par flush()
+     * sur la queue de transfert, qui signale un timeline semaphore.
+     *
+     * Chaque upload rend un jeton : la valeur du semaphore qui marquera sa fin.
+     * Côté consommateur :
+     *   flush();
+     *   U64 waitValue = recordAcquireBarriers(cmd, graphicsFamily);
+     *   // soumission de cmd avec une attente sur getTimelineSemaphore() >= waitValue
+     * Si la queue de transfert est d'une autre famille, la release est faite dans
+     * le lot et recordAcquireBarriers() enregistre l'acquire correspondante.
+     *
+     * Sur une queue de transfert dédiée, minImageTransferGranularity peut
+     * interdire les copies partielles d'image : uploader des mips entiers.
+     *
+     * Thread-safe (un mutex, memcpy compris) ; possédé par CRenderDevice.
+     */
+    class INGA_API CUploadService
+    {
+    public:
+        static const VkDeviceSize DEFAULT_STAGING_SIZE = 64ull * 1024 * 1024;
+        static const U32 MAX_BATCHES = 8;
+
+        CUploadService() = default;
+        ~CUploadService();
+
+        CUploadService(const CUploadService&) = delete;
+        CUploadService& operator=(const CUploadService&) = delete;
+
+        bool initialize(CRenderDevice* device, VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE);
+        void shutdown();
+
+        // Renvoient le jeton de l'upload, 0 en cas d'échec
+        U64 uploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size,
+                         const SUploadTarget& target = SUploadTarget());
+        U64 uploadImage(const SImageUpload& region, const void* data, VkDeviceSize size,
+                        const SUploadTarget& target = SUploadTarget());
+
+        // Soumet le lot en cours ; renvoie le dernier jeton soumis (0 si aucun)
+        U64 flush();
+
+        bool isComplete(U64 token);
+        bool wait(U64 token, U64 timeoutNs = ~0ull);
+
+        // Acquires en attente pour cette famille + valeur que la soumission de cmd doit attendre (0 = aucune)
+        U64 recordAcquireBarriers(VkCommandBuffer cmd, U32 queueFamily);
+
+        // Recycle les lots terminés et les buffers temporaires (appelé aussi par les uploads)
+        void collect();
+
+        VkSemaphore getTimelineSemaphore() const { return m_timeline; }
+        SUploadStats getStats();
+
+        inline bool isInitialized() const { return m_device != nullptr; }
+
+    private:
+        struct SBatch
+        {
+            VkCommandPool   pool = VK_NULL_HANDLE;
+            VkCommandBuffer cmd = VK_NULL_HANDLE;
+            U64             value = 0;          // valeur signalée, 0 = libre
+            U64             endCursor = 0;      // fin de ses données dans l'anneau
+            bool            recording = false;
+        };
+
+        struct SAcquire
+        {
+            U64  token;
+            U32  queueFamily;
+            bool isImage;
+            bool needsBarrier;                  // false : même famille, seule l'attente compte
+            VkBufferMemoryBarrier2 buffer;
+            VkImageMemoryBarrier2  image;
+        };
+
+        struct SBufferWrite
+        {
+            VkBuffer     buffer;
+            VkDeviceSize offset;
+            VkDeviceSize size;
+        };
+
+        struct STemporaryBuffer
+        {
+            U64            token;
+            VkBuffer       buffer;
+            SGpuAllocation allocation;
+        };
+
+        SBatch* beginBatch();
+        void submitBatch();
+        void flushCopies();
+        bool reserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+        bool waitOldestBatch();
+        void collectLocked();
+
+        U32 resolveFamily(const SUploadTarget& target) const;
+
+    private:
+        CRenderDevice* m_device = nullptr;
+        VkDevice       m_vkDevice = VK_NULL_HANDLE;
+        U32            m_transferFamily = 0xFFFFFFFF;
+        U32            m_graphicsFamily = 0xFFFFFFFF;
+
+        // Anneau : curseurs monotones, position = curseur % taille
+        VkBuffer       m_staging = VK_NULL_HANDLE;
+        SGpuAllocation m_stagingAllocation;
+        VkDeviceSize   m_stagingSize = 0;
+        VkDeviceSize   m_alignment = 16;
+        U64            m_writeCursor = 0;
+        U64            m_retiredCursor = 0;
+
+        VkSemaphore m_timeline = VK_NULL_HANDLE;
+        U64         m_submittedValue = 0;
+        U64         m_completedValue = 0;
+
+        SBatch m_batches[MAX_BATCHES];
+        U32    m_current = 0;                   // lot en cours d'enregistrement (ou prochain)
+        U32    m_oldest = 0;                    // plus ancien lot en vol
+        U64    m_batchBytes = 0;
+
+        VkBuffer          m_copyDst = VK_NULL_HANDLE;
+        Vector<VkBufferCopy> m_copyRegions;
+        Vector<VkBufferMemoryBarrier2> m_releaseBuffers;
+        Vector<VkImageMemoryBarrier2>  m_releaseImages;
+        Vector<SBufferWrite> m_batchWrites;     // plages écrites par le lot en cours
+        Vector<SAcquire>  m_recordedAcquires;   // lot en cours
+        Vector<SAcquire>  m_pendingAcquires;    // lots soumis, pas encore acquis
+        Vector<STemporaryBuffer> m_temporaryBuffers;
+
+        std::mutex   m_mutex;
+        SUploadStats m_stats{};
+    };
+}
+
+#endif
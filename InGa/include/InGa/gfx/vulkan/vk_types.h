@@ -53,6 +53,8 @@ struct SSwapchain
   U32 m_currentFrame =  0;
   U32 m_maxImageInFlight = 2;
 
+  // Vues + semaphores par image ; la swapchain elle-même reste (recréation avec oldSwapchain)
+  void destroyImageResources(VkDevice device);
   void cleanup(VkDevice device);
 };
 
@@ -65,11 +67,23 @@ struct SCommandPool
     U8 resetable;
 };
 
+// Pool d'un thread pour un vol : remis à zéro d'un bloc quand le vol revient
+struct SThreadCommandPool
+{
+    VkCommandPool           pool = VK_NULL_HANDLE;
+    Vector<VkCommandBuffer> secondaries;    // gardés d'une frame à l'autre, réenregistrés
+    U32                     used = 0;
+};
+
 struct SCommandBufferFrame
 {
+    VkCommandPool   pool;           // pool du primaire
     VkCommandBuffer cmd;
     VkFence         inFlight;
     VkSemaphore     imageAvailable;
+
+    Vector<SThreadCommandPool> threadPools;    // [index JobSystem] + 1 pour un thread externe
+    Vector<VkCommandBuffer>    secondaries;    // ordre d'exécution dans la frame
 };
 
 struct SCommanBuffer
@@ -7,9 +7,21 @@ namespace Inga
         EngineConfig conf = {};
         conf.maxPageCount    = 64;
         conf.pageSize        = 16 * 1024 * 1024;
-        conf.logLevel   = LogLevel::eVERBOSE;
+#ifdef INGA_DEBUG
+        conf.logLevel   = LogLevel::eDEBUG;
+#else
+        conf.logLevel   = LogLevel::eINFO;
+#endif
         conf.logOutput = LogOutput::eALLOUT;
         conf.logFile = "logs/inga_latest.log";
+        conf.logMode = LogMode::eLOG_ASYNC;
+        conf.logOverflow = LogOverflow::eLOG_BLOCK;
+        conf.logQueueSize = 4096;
+        conf.workerCount = 0;
+        conf.maxJobsPerThread = 4096;
+        conf.profilerEventsPerThread = 64 * 1024;
+        conf.profilerHardwareCounters = false;
+        conf.profilerCaptureSignalFrames = 120;
 
         return conf;
     }
@@ -1,48 +1,43 @@
 #include <InGa/core/allocator.h>
+#include <InGa/core/time.h>
 #include "internal_allocator.h"
+#include <atomic>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-#include <chrono> // On l'utilise ici seulement pour la mesure brute
-
 
 // --- Statistiques de performance internes ---
 #ifdef INGA_DEBUG
-static U64 g_total_alloc_time_us = 0;
-static U64 g_total_free_time_us  = 0;
-static U64 g_alloc_calls         = 0;
-static U64 g_free_calls          = 0;
+// En ticks de Inga::Time (convertis à l'affichage) : une mesure à la µs
+// arrondissait presque tous les appels à 0
+static U64 g_total_alloc_ticks = 0;
+static U64 g_total_free_ticks  = 0;
+static U64 g_alloc_calls       = 0;
+static U64 g_free_calls        = 0;
 #endif
 
-// Petite fonction utilitaire interne (non exportée)
-static inline U64 GetMicroseconds()
-{
-    auto now = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
-}
-
 #ifdef INGA_DEBUG
 struct AllocPerformanceCounter
 {
     U64 start;
-    U64* targetTotalTime;
+    U64* targetTotalTicks;
     U64* targetCallCount;
 
-    AllocPerformanceCounter(U64* totalTime, U64* callCount)
-        : targetTotalTime(totalTime), targetCallCount(callCount)
+    AllocPerformanceCounter(U64* totalTicks, U64* callCount)
+        : targetTotalTicks(totalTicks), targetCallCount(callCount)
     {
-        start = GetMicroseconds();
+        start = Inga::Time::now();
     }
 
     ~AllocPerformanceCounter()
     {
-        *targetTotalTime += (GetMicroseconds() - start);
+        *targetTotalTicks += (Inga::Time::now() - start);
         (*targetCallCount)++;
     }
 };
-#define INGA_INSTRUMENT_ALLOC() AllocPerformanceCounter counter(&g_total_alloc_time_us, &g_alloc_calls)
-#define INGA_INSTRUMENT_FREE()  AllocPerformanceCounter counter(&g_total_free_time_us, &g_free_calls)
+#define INGA_INSTRUMENT_ALLOC() AllocPerformanceCounter counter(&g_total_alloc_ticks, &g_alloc_calls)
+#define INGA_INSTRUMENT_FREE()  AllocPerformanceCounter counter(&g_total_free_ticks, &g_free_calls)
 #else
 #define INGA_INSTRUMENT_ALLOC()
 #define INGA_INSTRUMENT_FREE()
@@ -61,6 +56,61 @@ namespace Inga
     static U64 g_bootstrap_offset = 0;
     static IngaMutex g_global_mutex;
 
+    // --- Événements (hook) ---
+    static std::atomic<AllocationEventHook> g_event_hook{nullptr};
+    static std::atomic<void*> g_event_user_data{nullptr};
+
+    // Profondeur des appels en cours sur ce thread : seul l'appel externe émet
+    static thread_local U32 t_event_depth = 0;
+    static thread_local B8 t_event_timing = INGA_FALSE;
+    static thread_local U64 t_lock_wait_ticks = 0;
+
+    struct AllocationEventScope
+    {
+        AllocationEventHook hook;
+        U64 start;
+
+        AllocationEventScope()
+            : hook(nullptr)
+            , start(0)
+        {
+            if (t_event_depth++ == 0) hook = g_event_hook.load(std::memory_order_acquire);
+            if (hook)
+            {
+                t_event_timing = INGA_TRUE;
+                t_lock_wait_ticks = 0;
+                start = Time::now();
+            }
+        }
+
+        ~AllocationEventScope()
+        {
+            t_event_depth--;
+        }
+
+        // Le hook tourne avec t_event_depth > 0 : ses propres allocations ne remontent pas
+        void emit(AllocationEventType type, void* ptr, void* oldPtr, U64 size, U16 groupId)
+        {
+            if (!hook) return;
+            t_event_timing = INGA_FALSE;
+            const AllocationEvent event = { start, Time::now() - start, t_lock_wait_ticks, size, ptr, oldPtr, groupId, type };
+            hook(event, g_event_user_data.load(std::memory_order_relaxed));
+        }
+    };
+
+    // Verrou de groupe, avec mesure de l'attente quand un hook écoute
+    static inline void lockGroup(MemoryGroup* group)
+    {
+        if (!t_event_timing)
+        {
+            INGA_MUTEX_LOCK(&group->mutex);
+            return;
+        }
+        const U64 start = Time::now();
+        INGA_MUTEX_LOCK(&group->mutex);
+        t_lock_wait_ticks += Time::now() - start;
+    }
+
     B8 Allocator::start(U32 maxGroups, U64 defaultPageSize)
     {
         if (g_is_initialized) return INGA_FALSE;
@@ -118,15 +168,20 @@ namespace Inga
         firstBlock->canary = 0x494E4741; // "INGA"
         firstBlock->size = group->pageSize;
         firstBlock->used = INGA_FALSE;
+        firstBlock->groupId = id;
+        firstBlock->pageId = 0;
         firstBlock->next = nullptr;
         firstBlock->previous = nullptr;
+        firstBlock->lFree = nullptr;
+        firstBlock->rFree = nullptr;
 
         page->freeBlock = (U8*)firstBlock;
+        page->firstFreeBlock = (U8*)firstBlock;
 
         return id;
     }
 
-U16 Allocator::setGroupIdByName(const char* name)
+U16 Allocator::findGroupId(const char* name)
 {
     if (!name || !g_is_initialized)
     {
@@ -146,10 +201,18 @@ U16 Allocator::setGroupIdByName(const char* name)
     }
 
     INGA_MUTEX_UNLOCK(&g_global_mutex);
-    
-    // Si on ne trouve pas, on loggue une erreur et on retourne un ID invalide
-    printf("[InGa] Erreur : Groupe memoire '%s' non trouve.\n", name);
-    return 0xFFFF; 
+    return 0xFFFF;
+}
+
+U16 Allocator::setGroupIdByName(const char* name)
+{
+    U16 id = findGroupId(name);
+    if (id == 0xFFFF && name && g_is_initialized)
+    {
+        // Si on ne trouve pas, on loggue une erreur et on retourne un ID invalide
+        printf("[InGa] Erreur : Groupe memoire '%s' non trouve.\n", name);
+    }
+    return id;
 }
 
 static bool createNewPage(MemoryGroup* group)
@@ -193,9 +256,8 @@ static bool createNewPage(MemoryGroup* group)
     return true;
 }
 
-void* Allocator::alloc(U64 size, U32 align, U16 groupId, const char* file, I32 line)
+static void* allocBlock(U64 size, U32 align, U16 groupId, const char* file, I32 line)
 {
-    INGA_INSTRUMENT_ALLOC();
 // 1. BOOTSTRAP
     if (!g_is_initialized) 
     {
@@ -219,7 +281,7 @@ void* Allocator::alloc(U64 size, U32 align, U16 groupId, const char* file, I32 l
     MemoryGroup* group = &g_groups[groupId];
 
     // --- ZONE CRITIQUE ---
-    INGA_MUTEX_LOCK(&group->mutex);
+    lockGroup(group);
 
     // 3. RECHERCHE DANS LES PAGES
     for (U32 p = 0; p < group->pageCount; ++p) 
@@ -231,9 +293,9 @@ void* Allocator::alloc(U64 size, U32 align, U16 groupId, const char* file, I32 l
         while (current) 
         {
             // Note : On sait qu'il est libre car on parcourt la liste lFree/rFree
-            U64 headerEnd = (U64)((U8*)current + sizeof(BlockHeader));
+            U64 headerEnd = (U64)((U8*)current + INGA_BLOCK_HEADER_SIZE);
             U64 padding = (align - (headerEnd % align)) % align;
-            U64 totalNeeded = size + padding + sizeof(BlockHeader);
+            U64 totalNeeded = alignBlockSize(size + padding + INGA_BLOCK_HEADER_SIZE);
 
             if (current->size >= totalNeeded) 
             {
@@ -248,7 +310,7 @@ void* Allocator::alloc(U64 size, U32 align, U16 groupId, const char* file, I32 l
 
                 // --- SPLIT ---
                 U64 remaining = current->size - totalNeeded;
-                if (remaining > (sizeof(BlockHeader) + 32)) 
+                if (remaining > (INGA_BLOCK_HEADER_SIZE + 32)) 
                 {
                     BlockHeader* nextB = (BlockHeader*)((U8*)current + totalNeeded);
                     
@@ -287,8 +349,11 @@ void* Allocator::alloc(U64 size, U32 align, U16 groupId, const char* file, I32 l
                 current->line = line;
 #endif
 
+                U8* payload = (U8*)(headerEnd + padding);
+                setPayloadOffset(payload, current);
+
                 INGA_MUTEX_UNLOCK(&group->mutex); 
-                return (void*)(headerEnd + padding);
+                return payload;
             }
             // MODIFICATION : On passe au bloc LIBRE suivant
             current = current->rFree;
@@ -301,24 +366,32 @@ void* Allocator::alloc(U64 size, U32 align, U16 groupId, const char* file, I32 l
         // Pour éviter de dupliquer la logique complexe de split/liens libres,
         // on appelle récursivement alloc. Le mutex sera repris proprement.
         INGA_MUTEX_UNLOCK(&group->mutex);
-        return alloc(size, align, groupId, file, line);
+        return allocBlock(size, align, groupId, file, line);
     }
 
     INGA_MUTEX_UNLOCK(&group->mutex);
     return nullptr;
 }
 
-void Allocator::free(void* ptr)
+void* Allocator::alloc(U64 size, U32 align, U16 groupId, const char* file, I32 line)
+{
+    INGA_INSTRUMENT_ALLOC();
+    AllocationEventScope scope;
+    void* ptr = allocBlock(size, align, groupId, file, line);
+    scope.emit(eALLOCATION_ALLOC, ptr, nullptr, size, groupId);
+    return ptr;
+}
+
+static void freeBlock(void* ptr)
 {
-  INGA_INSTRUMENT_FREE();
 // 1. SÉCURITÉ
     if (!ptr) 
     {
         return;
     }
 
-    // On récupère le header (Juste avant le payload)
-    BlockHeader* header = (BlockHeader*)((U8*)ptr - sizeof(BlockHeader));
+    // On récupère le header (via l'offset stocké juste avant le payload)
+    BlockHeader* header = headerFromPayload(ptr);
     
     // Vérification du Canary pour éviter de libérer n'importe quoi
     if (header->canary != 0x494E4741) 
@@ -334,7 +407,7 @@ void Allocator::free(void* ptr)
     MemoryPage* page = &group->pages[header->pageId];
 
     // --- ZONE CRITIQUE ---
-    INGA_MUTEX_LOCK(&group->mutex);
+    lockGroup(group);
 
     header->used = INGA_FALSE;
     header->payloadSize = 0;
@@ -402,6 +475,36 @@ void Allocator::free(void* ptr)
     INGA_MUTEX_UNLOCK(&group->mutex);
 }
 
+void Allocator::free(void* ptr)
+{
+    INGA_INSTRUMENT_FREE();
+    AllocationEventScope scope;
+    if (!scope.hook || !ptr)
+    {
+        freeBlock(ptr);
+        return;
+    }
+
+    // Taille et groupe relevés avant que le bloc ne soit fusionné
+    const BlockHeader* header = headerFromPayload(ptr);
+    const B8 valid = header->canary == 0x494E4741;
+    const U64 size = valid ? header->payloadSize : 0;
+    const U16 groupId = valid ? header->groupId : 0xFFFF;
+    freeBlock(ptr);
+    scope.emit(eALLOCATION_FREE, ptr, nullptr, size, groupId);
+}
+
+const char* Allocator::getGroupName(U16 groupId)
+{
+    return g_is_initialized && groupId < g_group_count ? g_groups[groupId].name : nullptr;
+}
+
+void Allocator::setEventHook(AllocationEventHook hook, void* userData)
+{
+    g_event_user_data.store(userData, std::memory_order_relaxed);
+    g_event_hook.store(hook, std::memory_order_release);
+}
+
 
 void Allocator::printStats()
 {
@@ -467,7 +570,7 @@ void Allocator::printStats()
     
     if (g_alloc_calls > 0)
     {
-        double avgAlloc = (double)g_total_alloc_time_us / (double)g_alloc_calls;
+        double avgAlloc = Time::toMicroseconds(g_total_alloc_ticks) / (double)g_alloc_calls;
         printf("  Allocations : %" PRIu64 " appels | Moyenne : %.3f us\n", 
                g_alloc_calls, avgAlloc);
     }
@@ -478,7 +581,7 @@ void Allocator::printStats()
 
     if (g_free_calls > 0)
     {
-        double avgFree = (double)g_total_free_time_us / (double)g_free_calls;
+        double avgFree = Time::toMicroseconds(g_total_free_ticks) / (double)g_free_calls;
         printf("  Libérations : %" PRIu64 " appels | Moyenne : %.3f us (fusions incl.)\n", 
                g_free_calls, avgFree);
     }
@@ -570,24 +673,24 @@ void Allocator::stop()
     printf("[InGa] Allocateur arrete proprement. Aucune fuite detectee.\n");
 }
 
-void* Allocator::realloc(void* ptr, U64 newSize, U32 align, const char* file, I32 line)
+static void* reallocBlock(void* ptr, U64 newSize, U32 align, const char* file, I32 line)
 {
   // 1. CAS PARTICULIERS STANDARDS
-    if (!ptr) return alloc(newSize, align, 0, file, line); 
+    if (!ptr) return Allocator::alloc(newSize, align, 0, file, line); 
     if (newSize == 0) 
     {
-        free(ptr);
+        Allocator::free(ptr);
         return nullptr;
     }
 
     // 2. RÉCUPÉRATION DU HEADER ACTUEL
-    BlockHeader* header = (BlockHeader*)((U8*)ptr - sizeof(BlockHeader));
+    BlockHeader* header = headerFromPayload(ptr);
     
     // Sécurité : on vérifie que c'est bien un bloc à nous
     INGA_ASSERT_RAW(header->canary == 0x494E4741, "Realloc sur un pointeur invalide !");
 
     MemoryGroup* group = &g_groups[header->groupId];
-    INGA_MUTEX_LOCK(&group->mutex);
+    lockGroup(group);
 
     // Calcul de l'espace actuel
     U64 currentTotalSize = header->size;
@@ -598,10 +701,9 @@ void* Allocator::realloc(void* ptr, U64 newSize, U32 align, const char* file, I3
     {
         U64 totalPotentialSize = currentTotalSize + header->next->size;
         
-        // Calcul du besoin réel avec alignement
-        U64 headerEnd = (U64)((U8*)header + sizeof(BlockHeader));
-        U64 padding = (align - (headerEnd % align)) % align;
-        U64 totalNeeded = newSize + padding + sizeof(BlockHeader);
+        // Calcul du besoin réel : le payload reste à la même adresse
+        U64 payloadOffset = (U64)((U8*)ptr - (U8*)header);
+        U64 totalNeeded = alignBlockSize(newSize + payloadOffset);
 
         if (totalPotentialSize >= totalNeeded)
         {
@@ -642,7 +744,7 @@ void* Allocator::realloc(void* ptr, U64 newSize, U32 align, const char* file, I3
     INGA_MUTEX_UNLOCK(&group->mutex); 
     
     // On alloue un nouveau bloc
-    void* newPtr = alloc(newSize, align, header->groupId, file, line);
+    void* newPtr = Allocator::alloc(newSize, align, header->groupId, file, line);
     if (newPtr)
     {
         // On copie l'ancienne donnée vers la nouvelle destination
@@ -650,12 +752,21 @@ void* Allocator::realloc(void* ptr, U64 newSize, U32 align, const char* file, I3
         ::memcpy(newPtr, ptr, copySize);
         
         // On libère l'ancien bloc (qui gérera ses propres fusions)
-        free(ptr);
+        Allocator::free(ptr);
     }
 
     return newPtr;
 }
 
+void* Allocator::realloc(void* ptr, U64 newSize, U32 align, const char* file, I32 line)
+{
+    AllocationEventScope scope;
+    const U16 groupId = ptr && scope.hook ? headerFromPayload(ptr)->groupId : 0;
+    void* newPtr = reallocBlock(ptr, newSize, align, file, line);
+    scope.emit(eALLOCATION_REALLOC, newPtr, ptr, newSize, groupId);
+    return newPtr;
+}
+
 }
 
 
@@ -1,4 +1,10 @@
 #include <InGa/core/clock.h>
+#include <InGa/core/time.h>
+#include <InGa/core/thread.h>
+#include <InGa/core/profiler.h>
+#include <chrono>
+#include <cmath>
+#include <thread>
 
 namespace Inga
 {
@@ -6,25 +12,151 @@ namespace Inga
         : m_deltaTime(0.0f)
         , m_totalTime(0.0)
         , m_timeScale(1.0f)
+        , m_fixedStep(0.0)
+        , m_accumulator(0.0)
+        , m_droppedTime(0.0)
+        , m_fixedStepIndex(0)
+        , m_maxFixedSteps(5)
+        , m_fixedStepsThisFrame(0)
     {
-        m_startTime = HighResClock::now();
-        m_lastTime = m_startTime;
+        m_startTicks = Time::now();
+        m_lastTicks = m_startTicks;
     }
 
     void Clock::tick()
     {
-        TimePoint currentTime = HighResClock::now();
+        // Une fois par frame : la fréquence du TSC est affinée au passage
+        Time::recalibrate();
+        const U64 currentTicks = Time::now();
         
         // Calcul de la durée depuis le dernier tick
-        std::chrono::duration<float> elapsed = currentTime - m_lastTime;
+        const F64 elapsed = Time::toSeconds(currentTicks - m_lastTicks);
         
         // On applique le timeScale au deltaTime pour les effets de ralenti
-        m_deltaTime = elapsed.count() * m_timeScale;
+        m_deltaTime = (float)elapsed * m_timeScale;
 
         // Calcul du temps total écoulé (non affecté par le timeScale généralement)
-        std::chrono::duration<double> total = currentTime - m_startTime;
-        m_totalTime = total.count();
+        m_totalTime = Time::toSeconds(currentTicks - m_startTicks);
 
-        m_lastTime = currentTime;
+        m_frameStats.addFrame(Time::toNs(currentTicks - m_lastTicks));
+        m_lastTicks = currentTicks;
+
+        // --- Pas fixe ---
+        if (m_fixedStep > 0.0)
+        {
+            m_accumulator += elapsed * m_timeScale;
+            m_fixedStepsThisFrame = 0;
+
+            const double maxAccumulated = m_fixedStep * m_maxFixedSteps;
+            if (m_accumulator > maxAccumulated)
+            {
+                m_droppedTime += m_accumulator - maxAccumulated;
+                m_accumulator = maxAccumulated;
+            }
+        }
+    }
+
+    void Clock::setFixedTimeStep(double step, U32 maxStepsPerFrame)
+    {
+        m_fixedStep = step > 0.0 ? step : 0.0;
+        m_maxFixedSteps = maxStepsPerFrame > 0 ? maxStepsPerFrame : 1;
+        m_accumulator = 0.0;
+        m_fixedStepsThisFrame = 0;
+    }
+
+    bool Clock::consumeFixedStep()
+    {
+        if (m_fixedStep <= 0.0 || m_accumulator < m_fixedStep) return false;
+
+        m_accumulator -= m_fixedStep;
+        m_fixedStepIndex++;
+        m_fixedStepsThisFrame++;
+        return true;
+    }
+
+    float Clock::getInterpolationAlpha() const
+    {
+        if (m_fixedStep <= 0.0) return 1.0f;
+        const double alpha = m_accumulator / m_fixedStep;
+        return alpha < 1.0 ? (float)alpha : 1.0f;
+    }
+
+    // --- FrameLimiter ---
+
+    static const U64 g_limiter_sleep_slice_ns = 1000000;
+
+    FrameLimiter::FrameLimiter(double targetFrameRate)
+        : m_targetFrameRate(0.0)
+        , m_periodTicks(0)
+        , m_deadline(0)
+        , m_minSpinTicks(0)
+        , m_sleepMeanNs(1.1 * g_limiter_sleep_slice_ns)
+        , m_sleepVarianceNs(0.04 * g_limiter_sleep_slice_ns * g_limiter_sleep_slice_ns)
+        , m_lastWait(0.0)
+    {
+        setMinSpinTime(0.0002);
+        setTargetFrameRate(targetFrameRate);
+    }
+
+    void FrameLimiter::setTargetFrameRate(double framesPerSecond)
+    {
+        m_targetFrameRate = framesPerSecond > 0.0 ? framesPerSecond : 0.0;
+        m_periodTicks = m_targetFrameRate > 0.0 ? Time::fromNs((U64)(1e9 / m_targetFrameRate)) : 0;
+        m_deadline = 0;
+    }
+
+    void FrameLimiter::setMinSpinTime(double seconds)
+    {
+        m_minSpinTicks = Time::fromNs((U64)((seconds > 0.0 ? seconds : 0.0) * 1e9));
+    }
+
+    double FrameLimiter::getSpinTime() const
+    {
+        const double estimate = (m_sleepMeanNs + 2.0 * std::sqrt(m_sleepVarianceNs)) * 1e-9;
+        const double minimum = Time::toSeconds(m_minSpinTicks);
+        return estimate > minimum ? estimate : minimum;
+    }
+
+    void FrameLimiter::wait()
+    {
+        if (m_periodTicks == 0)
+        {
+            m_lastWait = 0.0;
+            return;
+        }
+
+        INGA_PROFILE_ZONE("FrameLimiter::wait");
+
+        const U64 start = Time::now();
+        if (m_deadline == 0) m_deadline = start + m_periodTicks;
+
+        // --- Sommeil par tranches tant qu'une tranche de plus ne risque pas de dépasser ---
+        for (;;)
+        {
+            const U64 now = Time::now();
+            if (now >= m_deadline || Time::toSeconds(m_deadline - now) <= getSpinTime()) break;
+
+            std::this_thread::sleep_for(std::chrono::nanoseconds(g_limiter_sleep_slice_ns));
+
+            // Moyenne / variance glissantes de la durée réelle d'une tranche
+            const double slept = (double)Time::toNs(Time::now() - now);
+            const double delta = slept - m_sleepMeanNs;
+            m_sleepMeanNs += delta / 16.0;
+            m_sleepVarianceNs = (m_sleepVarianceNs + delta * delta / 16.0) * (15.0 / 16.0);
+        }
+
+        // --- Attente active pour la fin ---
+        U64 now = Time::now();
+        while (now < m_deadline)
+        {
+            Thread::spinPause();
+            now = Time::now();
+        }
+
+        m_lastWait = Time::toSeconds(now - start);
+
+        // Frame en retard de plus d'une période : on repart de maintenant (pas de rafale de rattrapage)
+        m_deadline += m_periodTicks;
+        if (m_deadline <= now) m_deadline = now + m_periodTicks;
     }
 }
@@ -0,0 +1,200 @@
+#include <InGa/core/frame_stats.h>
+#include <InGa/core/log.h>
+#include <cstring>
+
+namespace Inga
+{
+    FrameStats::FrameStats()
+        : m_hitchFactor(2.0)
+        , m_hitchMinimumMs(0.0)
+        , m_hitchCallback(nullptr)
+        , m_hitchUserData(nullptr)
+        , m_logIntervalNs(0)
+    {
+        reset();
+    }
+
+    void FrameStats::reset()
+    {
+        memset(m_samples, 0, sizeof(m_samples));
+        memset(m_histogram, 0, sizeof(m_histogram));
+        m_cursor = 0;
+        m_count = 0;
+        m_sumUs = 0;
+        m_frameIndex = 0;
+        m_medianUs = 0;
+        m_hitchCount = 0;
+        m_sinceLogNs = 0;
+    }
+
+    // --- Histogramme log-linéaire ---
+
+    // Sous 2^g_linear_bits µs : une classe par µs ; au-delà, 2^(g_linear_bits - 1) classes par octave
+    static const U32 g_linear_bits = 8;
+    static const U32 g_linear_count = 1u << g_linear_bits;
+    static const U32 g_octave_count = 1u << (g_linear_bits - 1);
+
+    U32 FrameStats::bucketOf(U32 us)
+    {
+        if (us < g_linear_count) return us;
+
+        U32 msb = 31;
+        while (!(us & (1u << msb))) --msb;
+        const U32 shift = msb - (g_linear_bits - 1);
+        const U32 bucket = g_linear_count + (shift - 1) * g_octave_count + ((us >> shift) - g_octave_count);
+        return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+    }
+
+    U32 FrameStats::bucketLower(U32 bucket)
+    {
+        if (bucket < g_linear_count) return bucket;
+        const U32 shift = (bucket - g_linear_count) / g_octave_count + 1;
+        return ((bucket - g_linear_count) % g_octave_count + g_octave_count) << shift;
+    }
+
+    U32 FrameStats::bucketUpper(U32 bucket)
+    {
+        if (bucket < g_linear_count) return bucket + 1;
+        const U32 shift = (bucket - g_linear_count) / g_octave_count + 1;
+        return bucketLower(bucket) + (1u << shift);
+    }
+
+    void FrameStats::addFrame(U64 frameNs)
+    {
+        const U64 us64 = frameNs / 1000;
+        const U32 us = us64 < 0xFFFFFFFFull ? (U32)us64 : 0xFFFFFFFF;
+
+        // La plus ancienne frame sort de la fenêtre
+        if (m_count == WINDOW_SIZE)
+        {
+            const U32 old = m_samples[m_cursor];
+            m_histogram[bucketOf(old)]--;
+            m_sumUs -= old;
+        }
+        else
+        {
+            m_count++;
+        }
+
+        m_samples[m_cursor] = us;
+        m_cursor = (m_cursor + 1) % WINDOW_SIZE;
+        m_histogram[bucketOf(us)]++;
+        m_sumUs += us;
+
+        // --- Hitch : comparé à la médiane (rafraîchie régulièrement, pas à chaque frame) ---
+        if ((m_frameIndex & 31) == 0 || m_medianUs == 0) m_medianUs = percentileUs(50.0);
+
+        const F64 frameMs = (F64)us * 1e-3;
+        const F64 medianMs = (F64)m_medianUs * 1e-3;
+        if (m_count >= 32 && frameMs > medianMs * m_hitchFactor && frameMs > m_hitchMinimumMs)
+        {
+            m_hitchCount++;
+            if (m_hitchCallback) m_hitchCallback(FrameHitch{ m_frameIndex, frameMs, medianMs }, m_hitchUserData);
+        }
+        m_frameIndex++;
+
+        // --- Log périodique ---
+        if (m_logIntervalNs > 0)
+        {
+            m_sinceLogNs += frameNs;
+            if (m_sinceLogNs >= m_logIntervalNs)
+            {
+                m_sinceLogNs = 0;
+                logSummary();
+            }
+        }
+    }
+
+    // Interpolé dans la classe qui contient le rang demandé
+    U32 FrameStats::percentileUs(F64 percent) const
+    {
+        if (m_count == 0) return 0;
+
+        U32 rank = (U32)((F64)m_count * percent / 100.0);
+        if (rank >= m_count) rank = m_count - 1;
+
+        U32 seen = 0;
+        for (U32 b = 0; b < BUCKET_COUNT; ++b)
+        {
+            const U32 count = m_histogram[b];
+            if (seen + count > rank)
+            {
+                const F64 position = ((F64)(rank - seen) + 0.5) / (F64)count;
+                return bucketLower(b) + (U32)(position * (F64)(bucketUpper(b) - bucketLower(b)));
+            }
+            seen += count;
+        }
+        return bucketLower(BUCKET_COUNT - 1);
+    }
+
+    F64 FrameStats::getPercentile(F64 percent) const
+    {
+        return (F64)percentileUs(percent) * 1e-3;
+    }
+
+    U32 FrameStats::getHistogramBucket(U32 index, F64* lowerMs, F64* upperMs) const
+    {
+        if (index >= BUCKET_COUNT) return 0;
+        if (lowerMs) *lowerMs = (F64)bucketLower(index) * 1e-3;
+        if (upperMs) *upperMs = (F64)bucketUpper(index) * 1e-3;
+        return m_histogram[index];
+    }
+
+    FrameStatsSummary FrameStats::getSummary() const
+    {
+        FrameStatsSummary summary = {};
+        summary.frameCount = m_count;
+        summary.hitchCount = m_hitchCount;
+        if (m_count == 0) return summary;
+
+        U32 minUs = 0xFFFFFFFF;
+        U32 maxUs = 0;
+        for (U32 i = 0; i < m_count; ++i)
+        {
+            if (m_samples[i] < minUs) minUs = m_samples[i];
+            if (m_samples[i] > maxUs) maxUs = m_samples[i];
+        }
+
+        summary.averageMs = (F64)m_sumUs / (F64)m_count * 1e-3;
+        summary.minMs = (F64)minUs * 1e-3;
+        summary.maxMs = (F64)maxUs * 1e-3;
+        summary.p50Ms = getPercentile(50.0);
+        summary.p95Ms = getPercentile(95.0);
+        summary.p99Ms = getPercentile(99.0);
+        summary.averageFps = summary.averageMs > 0.0 ? 1000.0 / summary.averageMs : 0.0;
+
+        // 1 % low : moyenne des frames les plus lentes, en partant du haut de l'histogramme
+        const U32 slowCount = m_count >= 100 ? m_count / 100 : 1;
+        U32 taken = 0;
+        F64 slowSumUs = 0.0;
+        for (U32 b = BUCKET_COUNT; b-- > 0 && taken < slowCount; )
+        {
+            if (m_histogram[b] == 0) continue;
+            const U32 take = m_histogram[b] < slowCount - taken ? m_histogram[b] : slowCount - taken;
+            slowSumUs += (F64)take * (F64)(bucketLower(b) + bucketUpper(b)) * 0.5;
+            taken += take;
+        }
+        summary.low1PercentFps = slowSumUs > 0.0 ? 1e6 * (F64)taken / slowSumUs : 0.0;
+        return summary;
+    }
+
+    void FrameStats::setHitchThreshold(F64 factorOfMedian, F64 minimumMs)
+    {
+        m_hitchFactor = factorOfMedian > 1.0 ? factorOfMedian : 1.0;
+        m_hitchMinimumMs = minimumMs > 0.0 ? minimumMs : 0.0;
+    }
+
+    void FrameStats::setHitchCallback(FrameHitchCallback callback, void* userData)
+    {
+        m_hitchCallback = callback;
+        m_hitchUserData = userData;
+    }
+
+    void FrameStats::logSummary() const
+    {
+        const FrameStatsSummary s = getSummary();
+        INGA_LOG(eINFO, "FRAME", "%.2f ms (%.1f fps) | p50 %.2f p95 %.2f p99 %.2f max %.2f ms | 1%% low %.1f fps | %llu hitches",
+                 s.averageMs, s.averageFps, s.p50Ms, s.p95Ms, s.p99Ms, s.maxMs, s.low1PercentFps,
+                 (unsigned long long)s.hitchCount);
+    }
+}
@@ -78,6 +78,34 @@ struct BlockHeader
         U16 id;
         IngaMutex mutex; // Un verrou par groupe
     };
+
+    /*
+     * Zone réservée devant chaque payload : le BlockHeader suivi d'un mot U32.
+     * Les 4 octets juste avant le payload stockent toujours la distance
+     * header -> payload, ce qui permet de retrouver le header même quand
+     * l'alignement demandé a inséré du padding.
+     * La taille est arrondie à INGA_BLOCK_GRANULARITY pour que tous les blocs
+     * d'une page restent alignés sur 16 octets.
+     */
+#define INGA_BLOCK_GRANULARITY 16
+#define INGA_BLOCK_HEADER_SIZE \
+    ((sizeof(Inga::BlockHeader) + sizeof(U32) + (INGA_BLOCK_GRANULARITY - 1)) & ~(U64)(INGA_BLOCK_GRANULARITY - 1))
+
+    static inline U64 alignBlockSize(U64 size)
+    {
+        return (size + (INGA_BLOCK_GRANULARITY - 1)) & ~(U64)(INGA_BLOCK_GRANULARITY - 1);
+    }
+
+    static inline void setPayloadOffset(U8* payload, BlockHeader* header)
+    {
+        ((U32*)payload)[-1] = (U32)(payload - (U8*)header);
+    }
+
+    static inline BlockHeader* headerFromPayload(void* payload)
+    {
+        U32 offset = ((U32*)payload)[-1];
+        return (BlockHeader*)((U8*)payload - offset);
+    }
 }
 
 #endif // INGA_INTERNAL_ALLOCATOR_H
@@ -0,0 +1,525 @@
+#include <InGa/core/job.h>
+#include <InGa/core/allocator.h>
+#include <InGa/core/queue.h>
+#include <InGa/core/thread.h>
+#include <InGa/core/log.h>
+#include <InGa/core/profiler.h>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace Inga
+{
+    struct Job
+    {
+        JobFunction function;
+        JobRangeFunction rangeFunction;
+        void* userData;
+        JobCounter* counter;
+        U32 rangeBegin;
+        U32 rangeEnd;
+        std::atomic<U8> inUse;
+    };
+
+    /*
+     * WorkStealingDeque : deque Chase-Lev bornée (version C11 de Lê et al.).
+     * push/pop : uniquement le thread propriétaire (bottom).
+     * steal    : n'importe quel autre thread (top, protégé par CAS).
+     */
+    struct WorkStealingDeque
+    {
+        alignas(INGA_CACHE_LINE_SIZE) std::atomic<I64> top{0};
+        alignas(INGA_CACHE_LINE_SIZE) std::atomic<I64> bottom{0};
+        alignas(INGA_CACHE_LINE_SIZE) std::atomic<Job*>* buffer = nullptr;
+        I64 mask = 0;
+
+        bool push(Job* job)
+        {
+            const I64 b = bottom.load(std::memory_order_relaxed);
+            const I64 t = top.load(std::memory_order_acquire);
+            if (b - t > mask) return false; // Pleine
+
+            buffer[b & mask].store(job, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        Job* pop()
+        {
+            const I64 b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            I64 t = top.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // Vide
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = buffer[b & mask].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // Dernier élément : course possible avec un voleur
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    job = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job* steal()
+        {
+            I64 t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const I64 b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b) return nullptr;
+
+            Job* job = buffer[t & mask].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr; // Un autre thread a gagné
+            }
+            return job;
+        }
+    };
+
+    // État par thread participant (thread principal + workers)
+    struct alignas(INGA_CACHE_LINE_SIZE) JobThreadData
+    {
+        WorkStealingDeque deque;
+        Job* jobPool;
+        U32 jobPoolIndex;
+        U32 rngState;
+        std::thread thread;
+    };
+
+    struct JobSystemInternal
+    {
+        JobThreadData* threads = nullptr;
+        U32 threadCount = 0;
+        U32 maxJobsPerThread = 0;
+        U16 groupId = 0xFFFF;
+
+        // Jobs lancés par des threads non enregistrés (Vulkan callbacks, threads utilisateurs...)
+        MpmcQueue<Job*> injectQueue;
+        Job* injectPool = nullptr;
+        std::atomic<U32> injectPoolIndex{0};
+
+        // Mise en sommeil des workers inactifs
+        std::atomic<U32> queuedJobs{0};
+        std::atomic<U32> sleepingWorkers{0};
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+
+        std::atomic<bool> running{false};
+    } gJobs;
+
+    static thread_local U32 t_thread_index = 0xFFFFFFFF;
+
+    static const U32 g_spin_before_sleep = 256;
+
+    static void executeJob(Job* job)
+    {
+        if (job->rangeFunction)
+        {
+            job->rangeFunction(job->rangeBegin, job->rangeEnd, job->userData);
+        }
+        else
+        {
+            job->function(job->userData);
+        }
+
+        JobCounter* counter = job->counter;
+        job->inUse.store(0, std::memory_order_release);
+
+        if (counter)
+        {
+            counter->value.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    static inline U32 nextRandom(U32& state)
+    {
+        // xorshift32 : suffisant pour choisir une victime
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    static Job* findJob(U32 threadIndex)
+    {
+        Job* job = nullptr;
+
+        if (threadIndex < gJobs.threadCount)
+        {
+            JobThreadData& self = gJobs.threads[threadIndex];
+
+            job = self.deque.pop();
+            if (!job)
+            {
+                gJobs.injectQueue.pop(job);
+            }
+
+            if (!job && gJobs.threadCount > 1)
+            {
+                // Vol : on part d'une victime aléatoire et on fait le tour
+                U32 start = nextRandom(self.rngState) % gJobs.threadCount;
+                for (U32 i = 0; i < gJobs.threadCount && !job; ++i)
+                {
+                    U32 victim = (start + i) % gJobs.threadCount;
+                    if (victim == threadIndex) continue;
+                    job = gJobs.threads[victim].deque.steal();
+                }
+            }
+        }
+        else
+        {
+            // Thread externe : il n'a pas de deque, il aide via l'injection et le vol
+            gJobs.injectQueue.pop(job);
+            for (U32 i = 0; i < gJobs.threadCount && !job; ++i)
+            {
+                job = gJobs.threads[i].deque.steal();
+            }
+        }
+
+        if (job)
+        {
+            gJobs.queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    static void wakeWorkers(U32 jobCount)
+    {
+        gJobs.queuedJobs.fetch_add(jobCount, std::memory_order_seq_cst);
+        if (gJobs.sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(gJobs.sleepMutex);
+            if (jobCount > 1) gJobs.sleepCondition.notify_all();
+            else gJobs.sleepCondition.notify_one();
+        }
+    }
+
+    static void workerMain(U32 threadIndex)
+    {
+        t_thread_index = threadIndex;
+
+        char name[16];
+        snprintf(name, sizeof(name), "InGa Worker %u", threadIndex);
+        Thread::setCurrentName(name);
+        if (Profiler::isEnabled()) Profiler::setThreadName(name);
+
+        U32 idleSpins = 0;
+        while (gJobs.running.load(std::memory_order_acquire))
+        {
+            Job* job = findJob(threadIndex);
+            if (job)
+            {
+                executeJob(job);
+                idleSpins = 0;
+                continue;
+            }
+
+            if (++idleSpins < g_spin_before_sleep)
+            {
+                Thread::spinPause();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(gJobs.sleepMutex);
+            gJobs.sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            gJobs.sleepCondition.wait(lock, []
+            {
+                return gJobs.queuedJobs.load(std::memory_order_seq_cst) > 0 ||
+                       !gJobs.running.load(std::memory_order_acquire);
+            });
+            gJobs.sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+            idleSpins = 0;
+        }
+
+        t_thread_index = 0xFFFFFFFF;
+    }
+
+    static Job* allocateJob(U32 threadIndex)
+    {
+        Job* pool;
+        U32 index;
+
+        if (threadIndex < gJobs.threadCount)
+        {
+            JobThreadData& self = gJobs.threads[threadIndex];
+            pool = self.jobPool;
+            index = self.jobPoolIndex++;
+        }
+        else
+        {
+            pool = gJobs.injectPool;
+            index = gJobs.injectPoolIndex.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Pool circulaire : si le slot est encore occupé, le pool est saturé
+        Job* job = &pool[index & (gJobs.maxJobsPerThread - 1)];
+        U8 expected = 0;
+        if (!job->inUse.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return job;
+    }
+
+    static void submitJob(Job* job)
+    {
+        const U32 threadIndex = t_thread_index;
+
+        bool queued = false;
+        if (threadIndex < gJobs.threadCount)
+        {
+            queued = gJobs.threads[threadIndex].deque.push(job);
+        }
+        else
+        {
+            queued = gJobs.injectQueue.push(job);
+        }
+
+        if (queued)
+        {
+            wakeWorkers(1);
+        }
+        else
+        {
+            // Plus de place : on exécute sur place plutôt que de bloquer
+            executeJob(job);
+        }
+    }
+
+    static void dispatch(JobFunction function, JobRangeFunction rangeFunction, void* userData,
+                         U32 begin, U32 end, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Job* job = gJobs.running.load(std::memory_order_acquire) ? allocateJob(t_thread_index) : nullptr;
+        if (!job)
+        {
+            // Système arrêté ou pool saturé : exécution immédiate sur le thread appelant
+            Job local;
+            local.function = function;
+            local.rangeFunction = rangeFunction;
+            local.userData = userData;
+            local.counter = counter;
+            local.rangeBegin = begin;
+            local.rangeEnd = end;
+            local.inUse.store(1, std::memory_order_relaxed);
+            executeJob(&local);
+            return;
+        }
+
+        job->function = function;
+        job->rangeFunction = rangeFunction;
+        job->userData = userData;
+        job->counter = counter;
+        job->rangeBegin = begin;
+        job->rangeEnd = end;
+        submitJob(job);
+    }
+
+    B8 JobSystem::start(U32 workerCount, U32 maxJobsPerThread)
+    {
+        if (gJobs.running.load()) return INGA_FALSE;
+
+        if (workerCount == 0)
+        {
+            U32 hw = Thread::getHardwareThreadCount();
+            workerCount = hw > 1 ? hw - 1 : 1;
+        }
+
+        gJobs.maxJobsPerThread = queueRoundCapacity(maxJobsPerThread);
+        gJobs.threadCount = workerCount + 1; // + thread principal
+
+        // Groupe mémoire dédié : pools de jobs et deques
+        U64 perThread = sizeof(JobThreadData) + (sizeof(Job) + sizeof(std::atomic<Job*>)) * (U64)gJobs.maxJobsPerThread;
+        U64 groupSize = perThread * (gJobs.threadCount + 1) + 64 * 1024;
+        gJobs.groupId = Allocator::findGroupId("Jobs");
+        if (gJobs.groupId == 0xFFFF)
+        {
+            AllocationGroupInfo info = { "Jobs", groupSize };
+            gJobs.groupId = Allocator::addGroup(info);
+        }
+        if (gJobs.groupId == 0xFFFF)
+        {
+            INGA_LOG(eERROR, "JOBS", "Unable to create the 'Jobs' memory group.");
+            return INGA_FALSE;
+        }
+
+        gJobs.threads = (JobThreadData*)Allocator::alloc(sizeof(JobThreadData) * gJobs.threadCount,
+                                                         alignof(JobThreadData), gJobs.groupId, __FILE__, __LINE__);
+        for (U32 i = 0; i < gJobs.threadCount; ++i)
+        {
+            JobThreadData* data = new (&gJobs.threads[i]) JobThreadData();
+            data->jobPool = (Job*)Allocator::alloc(sizeof(Job) * gJobs.maxJobsPerThread, INGA_CACHE_LINE_SIZE,
+                                                   gJobs.groupId, __FILE__, __LINE__);
+            for (U32 j = 0; j < gJobs.maxJobsPerThread; ++j)
+            {
+                new (&data->jobPool[j]) Job();
+                data->jobPool[j].inUse.store(0, std::memory_order_relaxed);
+            }
+            data->jobPoolIndex = 0;
+            data->rngState = 0x9E3779B9u ^ (i * 0x85EBCA6Bu) ^ 1u;
+
+            data->deque.buffer = (std::atomic<Job*>*)Allocator::alloc(sizeof(std::atomic<Job*>) * gJobs.maxJobsPerThread,
+                                                                      INGA_CACHE_LINE_SIZE, gJobs.groupId, __FILE__, __LINE__);
+            for (U32 j = 0; j < gJobs.maxJobsPerThread; ++j)
+            {
+                new (&data->deque.buffer[j]) std::atomic<Job*>(nullptr);
+            }
+            data->deque.mask = (I64)gJobs.maxJobsPerThread - 1;
+        }
+
+        gJobs.injectPool = (Job*)Allocator::alloc(sizeof(Job) * gJobs.maxJobsPerThread, INGA_CACHE_LINE_SIZE,
+                                                  gJobs.groupId, __FILE__, __LINE__);
+        for (U32 j = 0; j < gJobs.maxJobsPerThread; ++j)
+        {
+            new (&gJobs.injectPool[j]) Job();
+            gJobs.injectPool[j].inUse.store(0, std::memory_order_relaxed);
+        }
+        gJobs.injectQueue.init(gJobs.maxJobsPerThread, gJobs.groupId);
+
+        gJobs.queuedJobs.store(0);
+        gJobs.running.store(true, std::memory_order_release);
+
+        // Le thread appelant devient le thread 0
+        t_thread_index = 0;
+        for (U32 i = 1; i < gJobs.threadCount; ++i)
+        {
+            gJobs.threads[i].thread = std::thread(workerMain, i);
+        }
+
+        INGA_LOG(eINFO, "JOBS", "Job system started : %u workers + main thread, %u jobs per thread.",
+                 workerCount, gJobs.maxJobsPerThread);
+        return INGA_TRUE;
+    }
+
+    void JobSystem::stop()
+    {
+        if (!gJobs.running.load()) return;
+
+        // On vide ce qui reste avant d'arrêter les workers
+        Job* job;
+        while ((job = findJob(t_thread_index)) != nullptr)
+        {
+            executeJob(job);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(gJobs.sleepMutex);
+            gJobs.running.store(false, std::memory_order_release);
+        }
+        gJobs.sleepCondition.notify_all();
+
+        for (U32 i = 1; i < gJobs.threadCount; ++i)
+        {
+            if (gJobs.threads[i].thread.joinable()) gJobs.threads[i].thread.join();
+        }
+
+        // Jobs poussés par les workers pendant leur arrêt : on les termine ici
+        while ((job = findJob(0)) != nullptr)
+        {
+            executeJob(job);
+        }
+
+        gJobs.injectQueue.shutdown();
+        Allocator::free(gJobs.injectPool);
+        gJobs.injectPool = nullptr;
+
+        for (U32 i = 0; i < gJobs.threadCount; ++i)
+        {
+            Allocator::free(gJobs.threads[i].jobPool);
+            Allocator::free(gJobs.threads[i].deque.buffer);
+            gJobs.threads[i].~JobThreadData();
+        }
+        Allocator::free(gJobs.threads);
+        gJobs.threads = nullptr;
+        gJobs.threadCount = 0;
+        t_thread_index = 0xFFFFFFFF;
+    }
+
+    B8 JobSystem::isRunning()
+    {
+        return gJobs.running.load(std::memory_order_acquire) ? INGA_TRUE : INGA_FALSE;
+    }
+
+    void JobSystem::run(const JobDecl& job, JobCounter* counter)
+    {
+        dispatch(job.function, nullptr, job.userData, 0, 0, counter);
+    }
+
+    void JobSystem::run(const JobDecl* jobs, U32 count, JobCounter* counter)
+    {
+        for (U32 i = 0; i < count; ++i)
+        {
+            dispatch(jobs[i].function, nullptr, jobs[i].userData, 0, 0, counter);
+        }
+    }
+
+    void JobSystem::runRange(U32 count, U32 batchSize, JobRangeFunction function, void* userData, JobCounter* counter)
+    {
+        if (count == 0) return;
+        if (batchSize == 0)
+        {
+            // Par défaut : ~4 lots par thread pour lisser la charge
+            U32 threads = gJobs.threadCount > 0 ? gJobs.threadCount : 1;
+            batchSize = (count + threads * 4 - 1) / (threads * 4);
+        }
+
+        for (U32 begin = 0; begin < count; begin += batchSize)
+        {
+            U32 end = (count - begin > batchSize) ? begin + batchSize : count;
+            dispatch(nullptr, function, userData, begin, end, counter);
+        }
+    }
+
+    void JobSystem::wait(JobCounter* counter)
+    {
+        if (!counter) return;
+
+        while (!counter->isDone())
+        {
+            Job* job = gJobs.running.load(std::memory_order_acquire) ? findJob(t_thread_index) : nullptr;
+            if (job)
+            {
+                executeJob(job);
+            }
+            else
+            {
+                Thread::spinPause();
+            }
+        }
+    }
+
+    void JobSystem::parallelFor(U32 count, U32 batchSize, JobRangeFunction function, void* userData)
+    {
+        JobCounter counter;
+        runRange(count, batchSize, function, userData, &counter);
+        wait(&counter);
+    }
+
+    U32 JobSystem::getThreadCount()
+    {
+        return gJobs.threadCount;
+    }
+
+    U32 JobSystem::getCurrentThreadIndex()
+    {
+        return t_thread_index;
+    }
+}
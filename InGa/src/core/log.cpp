@@ -1,49 +1,975 @@
-#include <InGa/core/log.h> 
+#include <InGa/core/log.h>
+#include <InGa/core/log_sink.h>
+#include <InGa/core/profiler.h>
 #include <InGa/core/allocator.h>
+#include <InGa/core/queue.h>
+#include <InGa/core/thread.h>
+#include <InGa/core/time.h>
 #include <cstdio>
 #include <cstring>
 #include <cstdarg>
 #include <filesystem>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
 
 namespace Inga
 {
 namespace fs = std::filesystem;
 
+    // Taille max d'un message en mode async (au-delà : tronqué avec "...")
+    static const U32 g_record_text_size = 1024;
+
+    // Taille du lot formaté par le writer avant un fwrite
+    static const U32 g_batch_buffer_size = 64 * 1024;
+
+    // Buffer utilisateur du fichier de log (setvbuf) : les petits messages
+    // s'accumulent en RAM, un seul write() quand il est plein ou au flush
+    static const U32 g_file_buffer_size = 256 * 1024;
+
+    // Mode binaire : buffer par thread et nombre max de threads enregistrés
+    static const U32 g_binary_buffer_size = 64 * 1024;
+    static const U32 g_binary_max_threads = 64;
+
+    static const U32 g_max_sinks = 8;
+
+    LogMode Log::s_mode = eLOG_SYNC;
+    LogLevel Log::s_minLevel = eINFO;
+
+    /*
+     * BinLogThreadBuffer : buffer binaire d'un thread (mode eLOG_BINARY).
+     * Seul le propriétaire y ajoute des messages ; "busy" le protège des
+     * flushs venant d'autres threads. Ordre des verrous : binMutex puis busy.
+     */
+    struct BinLogThreadBuffer
+    {
+        U8* data = nullptr;      // nullptr = pas enregistré
+        U32 used = 0;
+        U32 pending = 0;         // taille du message en cours (begin -> end)
+        std::atomic<bool> busy{false};
+
+        ~BinLogThreadBuffer();
+    };
+
+    static thread_local BinLogThreadBuffer tBinBuffer;
+
+    /*
+     * LogRecord : un message déjà formaté, en attente d'écriture.
+     * tag / color / file / func doivent pointer vers des chaînes statiques
+     * (littéraux des macros INGA_LOG) : seul le texte est copié.
+     */
+    struct LogRecord
+    {
+        LogLevel level;
+        const char* tag;
+        const char* color;
+        const char* file;
+        const char* func;
+        I32 line;
+        U32 threadId;
+        U64 timestampNs;
+        U32 length;
+        char text[g_record_text_size];
+    };
+
     struct LogInternal
     {
         char* buffer = nullptr;
         size_t bufferSize = 0;
-        LogLevel minLevel = eINFO;
         LogOutput output = eTERMOUT;
         std::mutex mutex;
-        bool inited = false;
+        std::atomic<bool> inited{false};
         char filePath[512];
+
+        // --- Fichier persistant + rotation ---
+        FILE* file = nullptr;
+        char* fileBuffer = nullptr;
+        U64 fileBytes = 0;
+        U64 fileMessages = 0;
+        // Réglables à tout moment, lus sans verrou par le writer et le thread de rotation
+        std::atomic<U32> maxFileSize{64 * 1024 * 1024}; // 0 = illimité
+        std::atomic<U32> maxFileMessages{0};    // 0 = illimité
+        std::atomic<U32> maxRotatedFiles{5};    // inga_X.log.1 ... inga_X.log.N
+        std::atomic<LogLevel> flushLevel{eWARNING};
+        std::atomic<U32> flushIntervalMs{1000};
+        std::chrono::steady_clock::time_point lastFlush;
+        std::atomic<bool> flushRequested{false};
+
+        // --- Rotation hors mode async : thread dédié, les appelants ne font que la demander ---
+        std::thread rotator;
+        std::atomic<bool> rotatorRunning{false};
+        std::atomic<bool> rotateRequested{false};
+        std::mutex rotatorMutex;
+        std::condition_variable rotatorCondition;
+        char* spareFileBuffer = nullptr;        // buffer du prochain fichier, échangé à la rotation
+
+        // --- Mode async ---
+        std::atomic<LogMode> mode{eLOG_SYNC};   // repasse en sync sous gLog.mutex à l'arrêt
+        std::atomic<U32> asyncProducers{0};     // appelants entre le test du mode et leur push
+        LogOverflow overflow = eLOG_BLOCK;
+        MpmcQueue<LogRecord> queue;
+        std::thread writer;
+        std::atomic<bool> writerRunning{false};
+        std::atomic<bool> writerAlive{false};   // faux une fois writerMain sorti : la queue n'a plus de lecteur
+        std::atomic<bool> writerSleeping{false};
+        std::mutex writerMutex;
+        std::condition_variable writerCondition;
+        std::atomic<U64> enqueued{0};
+        std::atomic<U64> written{0};
+        std::atomic<U64> dropped{0};
+        U64 droppedReported = 0;
+        char* termBatch = nullptr;
+        char* fileBatch = nullptr;
+
+        // --- Mode binaire ---
+        FILE* binFile = nullptr;
+        char binFilePath[512];
+        std::mutex binMutex;
+        BinLogThreadBuffer* binThreads[g_binary_max_threads] = {};
+        U32 binThreadCount = 0;
+        std::atomic<U32> nextSiteId{1};
+        std::atomic<U32> binSession{0};         // +1 par fichier .ilog : les sites s'y réenregistrent
+
+        // --- Horodatage : horloge monotone + heure murale au démarrage ---
+        U64 startTimestampNs = 0;
+        I64 startWallNs = 0;
+
+        // --- Sinks enregistrés (appelés sous sinkMutex) ---
+        LogSink* sinks[g_max_sinks] = {};
+        std::atomic<U32> sinkCount{0};
+        std::mutex sinkMutex;
+
+        // --- Déduplication des messages consécutifs (writer ou sous mutex) ---
+        bool dedup = true;
+        U32 repeats = 0;
+        LogRecord lastRecord;
     } gLog;
 
-    static const char* LevelStrings[] = 
+    static const char* LevelStrings[] =
     {
         "\x1b[1;35m VERBOSE \x1b[0m", "\x1b[1;34m  DEBUG  \x1b[0m",
         "\x1b[1;92m  INFO   \x1b[0m", "\x1b[0;33m WARNING \x1b[0m",
         "\x1b[0;31m  ERROR  \x1b[0m", "\x1b[7;31m  FATAL  \x1b[0m"
     };
 
-    static const char* LevelStringsPlain[] = 
+    static const char* LevelStringsPlain[] =
     {
         "VERBOSE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL"
     };
 
-    bool Log::init(LogLevel level, LogOutput output, const char* folder)
+    // --- Horodatage ---
+
+    // Cache par thread de "HH:MM:SS" : localtime() (verrou global de la glibc)
+    // et strftime ne sont appelés qu'une fois par seconde
+    struct WallClockCache
+    {
+        I64 second = -1;
+        char text[16];
+    };
+
+    static thread_local WallClockCache tWallClock;
+
+    // Vrai sur le thread writer (mode async) : lui seul fait la rotation en ligne
+    static thread_local bool tLogWriter = false;
+
+    // Écrit "HH:MM:SS.mmm" pour un timestamp de Log::getTimestampNs()
+    static const char* formatWallTime(U64 timestampNs, char* dst, size_t size)
+    {
+        const I64 wallNs = gLog.startWallNs + (I64)(timestampNs - gLog.startTimestampNs);
+        const I64 second = wallNs / 1000000000ll;
+        if (second != tWallClock.second)
+        {
+            time_t seconds = (time_t)second;
+            struct tm ts;
+#if defined(INGA_PLATFORM_WINDOWS)
+            localtime_s(&ts, &seconds);
+#else
+            localtime_r(&seconds, &ts);
+#endif
+            strftime(tWallClock.text, sizeof(tWallClock.text), "%H:%M:%S", &ts);
+            tWallClock.second = second;
+        }
+        snprintf(dst, size, "%s.%03u", tWallClock.text, (U32)((wallNs / 1000000ll) % 1000));
+        return dst;
+    }
+
+    const char* Log::formatTimestamp(U64 timestampNs, char* dst, U32 size)
+    {
+        return formatWallTime(timestampNs, dst, size);
+    }
+
+    U64 Log::getTimestampNs()
+    {
+        return Time::nowNs();
+    }
+
+    static void initTimestamps()
+    {
+        gLog.startTimestampNs = Log::getTimestampNs();
+        gLog.startWallNs = (I64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        tWallClock.second = -1;
+    }
+
+    // --- Formatage des lignes pour les lots du writer ---
+
+    static int formatTermLine(char* dst, size_t size, const LogRecord& r, const char* text)
+    {
+        if (r.color)
+            return snprintf(dst, size, "[%s][T%u][%s] (%s | %s:%d) %s%s\x1b[0m\n", LevelStrings[r.level], r.threadId, r.tag, r.func, r.file, r.line, r.color, text);
+        return snprintf(dst, size, "[%s][T%u][%s] (%s | %s:%d) %s\n", LevelStrings[r.level], r.threadId, r.tag, r.func, r.file, r.line, text);
+    }
+
+    static int formatFileLine(char* dst, size_t size, const LogRecord& r, const char* text)
+    {
+        char tBuf[24];
+        formatWallTime(r.timestampNs, tBuf, sizeof(tBuf));
+
+        return snprintf(dst, size, "[%s][%s][T%u][%s] (%s | %s:%d) %s\n",
+                        tBuf, LevelStringsPlain[r.level], r.threadId, r.tag, r.func, r.file, r.line, text);
+    }
+
+    // --- Sinks ---
+
+    static void submitToSinks(const LogEntry& entry)
+    {
+        std::lock_guard<std::mutex> lock(gLog.sinkMutex);
+        const U32 count = gLog.sinkCount.load(std::memory_order_relaxed);
+        for (U32 i = 0; i < count; ++i)
+        {
+            gLog.sinks[i]->submit(entry);
+        }
+    }
+
+    static LogEntry makeEntry(const LogRecord& r, const char* text, U32 length)
+    {
+        return LogEntry{ r.level, r.tag, r.color, r.file, r.func, r.line, r.threadId, r.timestampNs, text, length };
+    }
+
+    // Ajoute une ligne au lot ; si le lot est plein, il est vidé d'abord
+    static void appendToBatch(char* batch, U32& used, FILE* out, const char* line, int length)
     {
+        if (length <= 0) return;
+        if ((U32)length >= g_batch_buffer_size)
+        {
+            if (used) { fwrite(batch, 1, used, out); used = 0; }
+            fwrite(line, 1, (size_t)length, out);
+            return;
+        }
+        if (used + (U32)length > g_batch_buffer_size)
+        {
+            fwrite(batch, 1, used, out);
+            used = 0;
+        }
+        memcpy(batch + used, line, (size_t)length);
+        used += (U32)length;
+    }
+
+    // --- Fichier de log : ouverture, flush, rotation ---
+
+    // Ouvre gLog.filePath avec son buffer et écrit la bannière ; bytes = taille écrite
+    static FILE* openLogFileAt(char*& buffer, const char* banner, U64& bytes)
+    {
+        FILE* file = fopen(gLog.filePath, "wt");
+        if (!file) return nullptr;
+
+        if (!buffer)
+        {
+            buffer = (char*)Allocator::alloc(g_file_buffer_size, 16, 0, __FILE__, __LINE__);
+        }
+        if (buffer)
+        {
+            setvbuf(file, buffer, _IOFBF, g_file_buffer_size);
+        }
+
+        // fprintf rend -1 en cas d'erreur : ne pas le compter comme 2^64 - 1 octets
+        const int written = fprintf(file, "%s\n", banner);
+        bytes = written > 0 ? (U64)written : 0;
+        return file;
+    }
+
+    static bool openLogFile(const char* banner)
+    {
+        U64 bytes = 0;
+        gLog.file = openLogFileAt(gLog.fileBuffer, banner, bytes);
+        if (!gLog.file) return false;
+
+        gLog.fileBytes = bytes;
+        gLog.fileMessages = 0;
+        gLog.lastFlush = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    static void closeLogFile()
+    {
+        if (gLog.file)
+        {
+            fclose(gLog.file);
+            gLog.file = nullptr;
+        }
+    }
+
+    static void flushLogFile()
+    {
+        if (gLog.file) fflush(gLog.file);
+        gLog.lastFlush = std::chrono::steady_clock::now();
+    }
+
+    static const char* g_rotated_banner = "--- INGA ENGINE LOG (ROTATED) ---";
+
+    // Décale les anciens fichiers (tous fermés) : .N supprimé, .i -> .i+1
+    static void shiftRotatedFiles(U32 keep)
+    {
+        if (keep == 0) return;
+
+        char from[560];
+        char to[560];
+        snprintf(to, sizeof(to), "%s.%u", gLog.filePath, keep);
+        remove(to);
+        for (U32 i = keep - 1; i >= 1; --i)
+        {
+            snprintf(from, sizeof(from), "%s.%u", gLog.filePath, i);
+            snprintf(to, sizeof(to), "%s.%u", gLog.filePath, i + 1);
+            rename(from, to);
+        }
+    }
+
+    // Le fichier courant devient .1 (ou est supprimé si on n'en garde aucun)
+    static void retireCurrentFile(U32 keep)
+    {
+        if (keep == 0)
+        {
+            remove(gLog.filePath);
+            return;
+        }
+        char to[560];
+        snprintf(to, sizeof(to), "%s.1", gLog.filePath);
+        rename(gLog.filePath, to);
+    }
+
+    /*
+     * Rotation : inga_X.log -> inga_X.log.1 -> ... -> inga_X.log.N (supprimé).
+     * Faite en ligne par le writer en mode async (il possède le fichier).
+     */
+    static void rotateLogFile()
+    {
+        closeLogFile();
+
+        const U32 keep = gLog.maxRotatedFiles.load(std::memory_order_relaxed);
+        shiftRotatedFiles(keep);
+        retireCurrentFile(keep);
+
+        if (!openLogFile(g_rotated_banner))
+        {
+            fprintf(stderr, "[LOG ERROR] Rotation impossible : %s\n", gLog.filePath);
+        }
+    }
+
+    /*
+     * Rotation hors mode async, sur le thread de rotation. Les renommages et le fopen
+     * se font sans gLog.mutex ; seul l'échange du FILE* est fait sous verrou, le
+     * fclose (qui vide le buffer de 256 Ko) a lieu après.
+     */
+    static void rotateLogFileDetached()
+    {
+        const U32 keep = gLog.maxRotatedFiles.load(std::memory_order_relaxed);
+        shiftRotatedFiles(keep);
+
+#if defined(INGA_PLATFORM_WINDOWS)
+        // Windows refuse de renommer un fichier ouvert : tout se fait sous le verrou,
+        // mais sur ce thread, les appelants ne font qu'attendre le mutex
         std::lock_guard<std::mutex> lock(gLog.mutex);
-        
-        gLog.minLevel = level;
+        if (!gLog.inited || !gLog.file) return;
+        closeLogFile();
+        retireCurrentFile(keep);
+        if (!openLogFile(g_rotated_banner))
+        {
+            fprintf(stderr, "[LOG ERROR] Rotation impossible : %s\n", gLog.filePath);
+        }
+#else
+        // POSIX : le fichier ouvert suit son renommage, les messages en cours finissent dans .1
+        retireCurrentFile(keep);
+
+        U64 bytes = 0;
+        FILE* next = openLogFileAt(gLog.spareFileBuffer, g_rotated_banner, bytes);
+        if (!next)
+        {
+            fprintf(stderr, "[LOG ERROR] Rotation impossible : %s\n", gLog.filePath);
+            return;
+        }
+
+        FILE* previous = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(gLog.mutex);
+            previous = gLog.file;
+            gLog.file = next;
+            std::swap(gLog.fileBuffer, gLog.spareFileBuffer);
+            gLog.fileBytes = bytes;
+            gLog.fileMessages = 0;
+            gLog.lastFlush = std::chrono::steady_clock::now();
+        }
+        if (previous) fclose(previous);
+#endif
+    }
+
+    static void rotatorMain()
+    {
+        Thread::setCurrentName("InGa Log Rotate");
+
+        std::unique_lock<std::mutex> lock(gLog.rotatorMutex);
+        while (gLog.rotatorRunning.load(std::memory_order_acquire))
+        {
+            gLog.rotatorCondition.wait(lock, []
+            {
+                return gLog.rotateRequested.load(std::memory_order_acquire) ||
+                       !gLog.rotatorRunning.load(std::memory_order_acquire);
+            });
+            if (!gLog.rotatorRunning.load(std::memory_order_acquire)) break;
+
+            lock.unlock();
+            rotateLogFileDetached();
+            gLog.rotateRequested.store(false, std::memory_order_release);
+            lock.lock();
+        }
+    }
+
+    static void startRotator()
+    {
+        gLog.rotateRequested.store(false, std::memory_order_relaxed);
+        gLog.rotatorRunning.store(true, std::memory_order_release);
+        gLog.rotator = std::thread(rotatorMain);
+    }
+
+    static void stopRotator()
+    {
+        if (!gLog.rotatorRunning.load()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(gLog.rotatorMutex);
+            gLog.rotatorRunning.store(false, std::memory_order_release);
+        }
+        gLog.rotatorCondition.notify_one();
+        if (gLog.rotator.joinable()) gLog.rotator.join();
+    }
+
+    // Appelant sous gLog.mutex : une seule demande en vol, le fichier grossit un peu d'ici là
+    static void requestRotation()
+    {
+        if (gLog.rotateRequested.exchange(true, std::memory_order_acq_rel)) return;
+        std::lock_guard<std::mutex> lock(gLog.rotatorMutex);
+        gLog.rotatorCondition.notify_one();
+    }
+
+    // Après chaque écriture fichier : flush par niveau / par période, puis rotation
+    static void afterFileWrite(LogLevel maxLevel, U64 bytes, U32 messages)
+    {
+        gLog.fileBytes += bytes;
+        gLog.fileMessages += messages;
+
+        auto now = std::chrono::steady_clock::now();
+        if (maxLevel >= gLog.flushLevel.load(std::memory_order_relaxed) || maxLevel == eFATAL ||
+            now - gLog.lastFlush >= std::chrono::milliseconds(gLog.flushIntervalMs.load(std::memory_order_relaxed)))
+        {
+            flushLogFile();
+        }
+
+        const U32 maxFileSize = gLog.maxFileSize.load(std::memory_order_relaxed);
+        const U32 maxFileMessages = gLog.maxFileMessages.load(std::memory_order_relaxed);
+        if ((maxFileSize && gLog.fileBytes >= maxFileSize) ||
+            (maxFileMessages && gLog.fileMessages >= maxFileMessages))
+        {
+            // Le writer possède le fichier ; ailleurs (appelants en sync) on délègue
+            if (tLogWriter) rotateLogFile();
+            else requestRotation();
+        }
+    }
+
+    // --- Déduplication : "Previous message repeated N times" ---
+
+    static bool isRepeat(LogLevel level, const char* tag, const char* file, I32 line, const char* text, U32 length)
+    {
+        const LogRecord& last = gLog.lastRecord;
+        if (length != last.length || line != last.line || level != last.level ||
+            file != last.file || tag != last.tag || memcmp(text, last.text, length) != 0)
+        {
+            return false;
+        }
+        gLog.repeats++;
+        return true;
+    }
+
+    static void rememberRecord(LogLevel level, const char* tag, const char* color, const char* file,
+                               const char* func, I32 line, U32 threadId, const char* text, U32 length)
+    {
+        LogRecord& last = gLog.lastRecord;
+        last.threadId = threadId;
+        last.level = level;
+        last.tag = tag;
+        last.color = color;
+        last.file = file;
+        last.func = func;
+        last.line = line;
+        // Trop long pour être comparé : ne sera jamais considéré comme répété
+        last.length = length < sizeof(last.text) ? length : 0xFFFFFFFF;
+        if (length < sizeof(last.text)) memcpy(last.text, text, length);
+    }
+
+    // Écrit le résumé des répétitions en attente (writer ou sous gLog.mutex)
+    static void writeRepeatSummary()
+    {
+        if (gLog.repeats == 0) return;
+
+        LogRecord& last = gLog.lastRecord;
+        char text[64];
+        snprintf(text, sizeof(text), "Previous message repeated %u times", gLog.repeats);
+        gLog.repeats = 0;
+
+        LogRecord summary = {};
+        summary.level = last.level;
+        summary.tag = last.tag;
+        summary.color = nullptr;
+        summary.file = last.file;
+        summary.func = last.func;
+        summary.line = last.line;
+        summary.threadId = last.threadId;
+        summary.timestampNs = Log::getTimestampNs();
+
+        char line[512];
+        if (gLog.output & eTERMOUT)
+        {
+            int length = formatTermLine(line, sizeof(line), summary, text);
+            if (length > 0) fwrite(line, 1, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1, stdout);
+        }
+        if ((gLog.output & eFILEOUT) && gLog.file)
+        {
+            int length = formatFileLine(line, sizeof(line), summary, text);
+            if (length > 0)
+            {
+                size_t bytes = (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1;
+                fwrite(line, 1, bytes, gLog.file);
+                afterFileWrite(summary.level, bytes, 1);
+            }
+        }
+        if (gLog.sinkCount.load(std::memory_order_acquire) > 0)
+        {
+            submitToSinks(makeEntry(summary, text, (U32)strlen(text)));
+        }
+    }
+
+    // --- Writer thread (mode async) ---
+
+    static void writeBatch(const LogRecord* records, U32 count)
+    {
+        if (count == 0) return;
+
+        char line[g_record_text_size + 512];
+
+        if (gLog.output & eTERMOUT)
+        {
+            U32 used = 0;
+            for (U32 i = 0; i < count; ++i)
+            {
+                int length = formatTermLine(line, sizeof(line), records[i], records[i].text);
+                if (length >= (int)sizeof(line)) length = (int)sizeof(line) - 1;
+                appendToBatch(gLog.termBatch, used, stdout, line, length);
+            }
+            if (used) fwrite(gLog.termBatch, 1, used, stdout);
+            fflush(stdout);
+        }
+
+        if ((gLog.output & eFILEOUT) && gLog.file)
+        {
+            U32 used = 0;
+            U64 bytes = 0;
+            LogLevel maxLevel = eVERBOSE;
+            for (U32 i = 0; i < count; ++i)
+            {
+                int length = formatFileLine(line, sizeof(line), records[i], records[i].text);
+                if (length >= (int)sizeof(line)) length = (int)sizeof(line) - 1;
+                appendToBatch(gLog.fileBatch, used, gLog.file, line, length);
+                bytes += length > 0 ? (U64)length : 0;
+                if (records[i].level > maxLevel) maxLevel = records[i].level;
+            }
+            if (used) fwrite(gLog.fileBatch, 1, used, gLog.file);
+            afterFileWrite(maxLevel, bytes, count);
+        }
+
+        if (gLog.sinkCount.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(gLog.sinkMutex);
+            const U32 sinkCount = gLog.sinkCount.load(std::memory_order_relaxed);
+            for (U32 i = 0; i < count; ++i)
+            {
+                const LogEntry entry = makeEntry(records[i], records[i].text, records[i].length);
+                for (U32 s = 0; s < sinkCount; ++s) gLog.sinks[s]->submit(entry);
+            }
+        }
+    }
+
+    static void reportDropped(LogRecord& scratch)
+    {
+        if (gLog.overflow != eLOG_DROP_COUNT) return;
+
+        U64 dropped = gLog.dropped.load(std::memory_order_relaxed);
+        if (dropped == gLog.droppedReported) return;
+
+        scratch.level = eWARNING;
+        scratch.tag = "LOG";
+        scratch.color = nullptr;
+        scratch.file = "log.cpp";
+        scratch.func = "writer";
+        scratch.line = __LINE__;
+        scratch.threadId = Thread::getCurrentId();
+        scratch.timestampNs = Log::getTimestampNs();
+        scratch.length = (U32)snprintf(scratch.text, sizeof(scratch.text),
+                                       "%llu messages dropped (async queue full)",
+                                       (unsigned long long)(dropped - gLog.droppedReported));
+        gLog.droppedReported = dropped;
+        writeBatch(&scratch, 1);
+    }
+
+    // writeBatch avec déduplication : les répétitions sont retirées du lot
+    static void writeRecords(LogRecord* records, U32 count)
+    {
+        if (!gLog.dedup)
+        {
+            writeBatch(records, count);
+            return;
+        }
+
+        U32 kept = 0;
+        for (U32 i = 0; i < count; ++i)
+        {
+            const LogRecord& r = records[i];
+            if (r.level != eFATAL && isRepeat(r.level, r.tag, r.file, r.line, r.text, r.length)) continue;
+
+            if (gLog.repeats > 0)
+            {
+                writeBatch(records, kept);
+                kept = 0;
+                writeRepeatSummary();
+            }
+            rememberRecord(r.level, r.tag, r.color, r.file, r.func, r.line, r.threadId, r.text, r.length);
+            if (kept != i) records[kept] = r;
+            ++kept;
+        }
+        writeBatch(records, kept);
+    }
+
+    // Vide la queue par lots ; retourne le nombre de messages écrits
+    static U32 drainQueue(LogRecord* batch, U32 batchCapacity)
+    {
+        U32 total = 0;
+        for (;;)
+        {
+            U32 count = 0;
+            while (count < batchCapacity && gLog.queue.pop(batch[count])) ++count;
+            if (count == 0) break;
+
+            writeRecords(batch, count);
+            gLog.written.fetch_add(count, std::memory_order_release);
+            total += count;
+        }
+        return total;
+    }
+
+    static void writerMain()
+    {
+        Thread::setCurrentName("InGa Log");
+        tLogWriter = true;
+
+        const U32 batchCapacity = 64;
+        LogRecord* batch = (LogRecord*)Allocator::alloc(sizeof(LogRecord) * (batchCapacity + 1), 16, 0, __FILE__, __LINE__);
+
+        while (gLog.writerRunning.load(std::memory_order_acquire))
+        {
+            U32 count = drainQueue(batch, batchCapacity);
+            reportDropped(batch[batchCapacity]);
+            if (gLog.flushRequested.load(std::memory_order_acquire))
+            {
+                writeRepeatSummary();
+                flushLogFile();
+                gLog.flushRequested.store(false, std::memory_order_release);
+            }
+            if (count > 0) continue;
+
+            // Plus rien en attente : la rafale de répétitions est terminée
+            writeRepeatSummary();
+
+            // Rien à écrire : flush périodique puis on dort jusqu'au prochain message
+            const std::chrono::milliseconds flushInterval(gLog.flushIntervalMs.load(std::memory_order_relaxed));
+            if (gLog.file && std::chrono::steady_clock::now() - gLog.lastFlush >= flushInterval)
+            {
+                flushLogFile();
+            }
+
+            std::unique_lock<std::mutex> lock(gLog.writerMutex);
+            gLog.writerSleeping.store(true, std::memory_order_seq_cst);
+            gLog.writerCondition.wait_for(lock, flushInterval, []
+            {
+                return !gLog.queue.empty() || gLog.flushRequested.load(std::memory_order_acquire) ||
+                       !gLog.writerRunning.load(std::memory_order_acquire);
+            });
+            gLog.writerSleeping.store(false, std::memory_order_relaxed);
+        }
+
+        // Arrêt : on écrit tout ce qui reste
+        drainQueue(batch, batchCapacity);
+        reportDropped(batch[batchCapacity]);
+        writeRepeatSummary();
+        flushLogFile();
+        gLog.flushRequested.store(false, std::memory_order_release);
+
+        Allocator::free(batch);
+        gLog.writerAlive.store(false, std::memory_order_release);
+    }
+
+    static void wakeWriter()
+    {
+        if (gLog.writerSleeping.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(gLog.writerMutex);
+            gLog.writerCondition.notify_one();
+        }
+    }
+
+    static bool startWriter(U32 queueSize)
+    {
+        if (!gLog.queue.init(queueSize)) return false;
+
+        gLog.termBatch = (char*)Allocator::alloc(g_batch_buffer_size, 16, 0, __FILE__, __LINE__);
+        gLog.fileBatch = (char*)Allocator::alloc(g_batch_buffer_size, 16, 0, __FILE__, __LINE__);
+        gLog.enqueued.store(0);
+        gLog.written.store(0);
+        gLog.dropped.store(0);
+        gLog.droppedReported = 0;
+
+        gLog.writerRunning.store(true, std::memory_order_release);
+        gLog.writerAlive.store(true, std::memory_order_release);
+        gLog.writer = std::thread(writerMain);
+        return true;
+    }
+
+    static void stopWriter()
+    {
+        if (!gLog.writerRunning.load()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(gLog.writerMutex);
+            gLog.writerRunning.store(false, std::memory_order_release);
+        }
+        gLog.writerCondition.notify_one();
+        if (gLog.writer.joinable()) gLog.writer.join();
+
+        gLog.queue.shutdown();
+        Allocator::free(gLog.termBatch);
+        Allocator::free(gLog.fileBatch);
+        gLog.termBatch = nullptr;
+        gLog.fileBatch = nullptr;
+    }
+
+    // --- Mode binaire : fichier .ilog, sites et buffers par thread ---
+
+    static bool openBinaryFile()
+    {
+        gLog.binFile = fopen(gLog.binFilePath, "wb");
+        if (!gLog.binFile) return false;
+
+        // startTimestampNs correspond exactement à la seconde startWallTimeSec
+        BinLogFileHeader header = {};
+        memcpy(header.magic, INGA_BINLOG_MAGIC, sizeof(header.magic));
+        header.version = INGA_BINLOG_VERSION;
+        header.startWallTimeSec = gLog.startWallNs / 1000000000ll;
+        header.startTimestampNs = gLog.startTimestampNs - (U64)(gLog.startWallNs % 1000000000ll);
+        fwrite(&header, sizeof(header), 1, gLog.binFile);
+        return true;
+    }
+
+    // Vide le buffer d'un thread dans le fichier (appelant : binMutex verrouillé)
+    static void flushBinaryBuffer(BinLogThreadBuffer* buffer)
+    {
+        while (buffer->busy.exchange(true, std::memory_order_acquire)) Thread::spinPause();
+        if (buffer->used && gLog.binFile)
+        {
+            fwrite(buffer->data, 1, buffer->used, gLog.binFile);
+        }
+        buffer->used = 0;
+        buffer->busy.store(false, std::memory_order_release);
+    }
+
+    static void flushBinaryBuffers()
+    {
+        for (U32 i = 0; i < gLog.binThreadCount; ++i)
+        {
+            flushBinaryBuffer(gLog.binThreads[i]);
+        }
+        if (gLog.binFile) fflush(gLog.binFile);
+    }
+
+    static void unregisterBinaryBuffer(BinLogThreadBuffer* buffer)
+    {
+        for (U32 i = 0; i < gLog.binThreadCount; ++i)
+        {
+            if (gLog.binThreads[i] == buffer)
+            {
+                gLog.binThreads[i] = gLog.binThreads[--gLog.binThreadCount];
+                break;
+            }
+        }
+        Allocator::free(buffer->data);
+        buffer->data = nullptr;
+        buffer->used = 0;
+    }
+
+    // Fin de thread : ses messages partent dans le fichier avant de libérer le buffer
+    BinLogThreadBuffer::~BinLogThreadBuffer()
+    {
+        if (!data) return;
+        std::lock_guard<std::mutex> lock(gLog.binMutex);
+        if (!data) return; // libéré entre-temps par terminate()
+        flushBinaryBuffer(this);
+        unregisterBinaryBuffer(this);
+    }
+
+    static void closeBinaryFile()
+    {
+        std::lock_guard<std::mutex> lock(gLog.binMutex);
+        flushBinaryBuffers();
+        while (gLog.binThreadCount > 0)
+        {
+            unregisterBinaryBuffer(gLog.binThreads[0]);
+        }
+        if (gLog.binFile)
+        {
+            fclose(gLog.binFile);
+            gLog.binFile = nullptr;
+        }
+    }
+
+    // Premier passage sur un site dans cette session : id + définition écrite tout de
+    // suite dans le fichier, donc toujours avant le premier message qui le référence.
+    // Après un terminate() / init(), le nouveau .ilog repart de zéro : les sites statiques
+    // d'une session précédente y sont réenregistrés.
+    static bool registerSite(LogSite& site)
+    {
+        std::lock_guard<std::mutex> lock(gLog.binMutex);
+        const U32 session = gLog.binSession.load(std::memory_order_relaxed);
+        if (site.session.load(std::memory_order_acquire) == session) return true;
+        if (!gLog.binFile) return false;
+
+        const char* fileName = site.file;
+        const char* lastSlash = strrchr(fileName, '/');
+        if (!lastSlash) lastSlash = strrchr(fileName, '\\');
+        if (lastSlash) fileName = lastSlash + 1;
+
+        const char* tag = site.tag ? site.tag : "";
+        const char* func = site.func ? site.func : "";
+        const char* fmt = site.fmt ? site.fmt : "";
+
+        BinLogSiteHeader header = {};
+        header.kind = eBINLOG_SITE;
+        header.siteId = gLog.nextSiteId.fetch_add(1, std::memory_order_relaxed);
+        header.line = site.line;
+        header.tagLength = (U16)strlen(tag);
+        header.fileLength = (U16)strlen(fileName);
+        header.funcLength = (U16)strlen(func);
+        header.fmtLength = (U16)strlen(fmt);
+
+        fwrite(&header, sizeof(header), 1, gLog.binFile);
+        fwrite(tag, 1, header.tagLength, gLog.binFile);
+        fwrite(fileName, 1, header.fileLength, gLog.binFile);
+        fwrite(func, 1, header.funcLength, gLog.binFile);
+        fwrite(fmt, 1, header.fmtLength, gLog.binFile);
+
+        site.id.store(header.siteId, std::memory_order_relaxed);
+        site.session.store(session, std::memory_order_release);
+        return true;
+    }
+
+    static bool registerBinaryBuffer(BinLogThreadBuffer* buffer)
+    {
+        std::lock_guard<std::mutex> lock(gLog.binMutex);
+        if (!gLog.binFile || gLog.binThreadCount >= g_binary_max_threads) return false;
+
+        buffer->data = (U8*)Allocator::alloc(g_binary_buffer_size, 16, 0, __FILE__, __LINE__);
+        if (!buffer->data) return false;
+        buffer->used = 0;
+        gLog.binThreads[gLog.binThreadCount++] = buffer;
+        return true;
+    }
+
+    U8* Log::beginBinary(LogSite& site, LogLevel level, U32 payloadSize, U8 argCount)
+    {
+        if (!gLog.inited || level < s_minLevel) return nullptr;
+
+        const U32 size = (U32)sizeof(BinLogMessageHeader) + payloadSize;
+        if (size > g_binary_buffer_size) return nullptr;
+
+        if (site.session.load(std::memory_order_acquire) != gLog.binSession.load(std::memory_order_relaxed) &&
+            !registerSite(site))
+        {
+            return nullptr;
+        }
+
+        // Capture du profiler : pas d'arguments formatés ici, seul le format du site
+        if (Profiler::isCapturing() && site.fmt)
+        {
+            Profiler::captureLog((U8)level, site.tag, site.fmt, (U32)strlen(site.fmt));
+        }
+
+        BinLogThreadBuffer& buffer = tBinBuffer;
+        if (!buffer.data && !registerBinaryBuffer(&buffer)) return nullptr;
+
+        // Plus de place : on vide notre buffer (used n'est modifié que par nous)
+        if (buffer.used + size > g_binary_buffer_size)
+        {
+            std::lock_guard<std::mutex> lock(gLog.binMutex);
+            flushBinaryBuffer(&buffer);
+        }
+
+        while (buffer.busy.exchange(true, std::memory_order_acquire)) Thread::spinPause();
+
+        BinLogMessageHeader header;
+        header.kind = eBINLOG_MESSAGE;
+        header.level = (U8)level;
+        header.argCount = argCount;
+        header.reserved = 0;
+        header.siteId = site.id.load(std::memory_order_relaxed);
+        header.threadId = Thread::getCurrentId();
+        header.payloadSize = payloadSize;
+        header.timestampNs = getTimestampNs();
+
+        U8* cursor = buffer.data + buffer.used;
+        memcpy(cursor, &header, sizeof(header));
+        buffer.pending = size;
+        return cursor + sizeof(header);
+    }
+
+    void Log::endBinary()
+    {
+        BinLogThreadBuffer& buffer = tBinBuffer;
+        buffer.used += buffer.pending;
+        buffer.pending = 0;
+        buffer.busy.store(false, std::memory_order_release);
+    }
+
+    bool Log::init(LogLevel level, LogOutput output, const char* folder,
+                   LogMode mode, LogOverflow overflow, U32 asyncQueueSize)
+    {
+        std::lock_guard<std::mutex> lock(gLog.mutex);
+
+        s_minLevel = level;
         gLog.output = output;
         gLog.bufferSize = 1024;
         gLog.buffer = INGA_NEW char[gLog.bufferSize];
+        gLog.mode = eLOG_SYNC;
+        gLog.overflow = overflow;
+        gLog.repeats = 0;
+        gLog.lastRecord.length = 0xFFFFFFFF;
 
         // Protection : Création du dossier si inexistant
-        try 
+        try
         {
             if (!fs::exists(folder))
             {
@@ -55,30 +981,108 @@ namespace fs = std::filesystem;
             fprintf(stderr, "[LOG ERROR] Erreur filesystem : %s\n", e.what());
         }
 
+        initTimestamps();
+
         time_t now = time(nullptr);
         struct tm* ts = localtime(&now);
         char timeBuf[64];
         strftime(timeBuf, sizeof(timeBuf), "%Y_%m_%d_%H_%M_%S", ts);
-        
+
         snprintf(gLog.filePath, sizeof(gLog.filePath), "%s/inga_%s.log", folder, timeBuf);
-        
-        FILE* f = fopen(gLog.filePath, "wt");
-        if (f)
+
+        // Le fichier reste ouvert jusqu'à terminate() (plus de fopen/fclose par message)
+        bool fileOpened = openLogFile("--- INGA ENGINE LOG START ---");
+
+        if (mode == eLOG_BINARY)
+        {
+            snprintf(gLog.binFilePath, sizeof(gLog.binFilePath), "%s/inga_%s.ilog", folder, timeBuf);
+            if (openBinaryFile())
+            {
+                // Nouveau fichier : ids repartis de 1, tous les sites à réenregistrer
+                std::lock_guard<std::mutex> binLock(gLog.binMutex);
+                gLog.nextSiteId.store(1, std::memory_order_relaxed);
+                gLog.binSession.fetch_add(1, std::memory_order_release);
+                s_mode = eLOG_BINARY;
+            }
+            else
+            {
+                fprintf(stderr, "[LOG ERROR] Impossible de creer le fichier binaire : %s\n", gLog.binFilePath);
+            }
+        }
+
+        if (mode == eLOG_ASYNC)
+        {
+            if (startWriter(asyncQueueSize))
+            {
+                gLog.mode = eLOG_ASYNC;
+            }
+            else
+            {
+                fprintf(stderr, "[LOG ERROR] Impossible de demarrer le mode async, retour au mode sync.\n");
+            }
+        }
+
+        // Sans writer, la rotation du fichier texte part sur son propre thread
+        if (gLog.mode != eLOG_ASYNC && fileOpened)
+        {
+            startRotator();
+        }
+
+        if (fileOpened)
         {
-            fprintf(f, "--- INGA ENGINE LOG START ---\n");
-            fclose(f);
             gLog.inited = true;
             return true;
         }
 
         fprintf(stderr, "[LOG ERROR] Impossible de creer le fichier : %s\n", gLog.filePath);
-        gLog.inited = true; 
+        gLog.inited = true;
         return true;
     }
 
     void Log::terminate()
     {
+        // Avant le verrou : une rotation en cours le prend pour échanger le fichier
+        stopRotator();
+
         std::lock_guard<std::mutex> lock(gLog.mutex);
+
+        // Les nouveaux messages passent en sync et attendent ce verrou ; ceux qui ont
+        // déjà vu le mode async finissent leur push, puis le writer vide la queue
+        const bool wasAsync = gLog.mode == eLOG_ASYNC;
+        gLog.mode = eLOG_SYNC;
+        while (gLog.asyncProducers.load(std::memory_order_acquire) > 0) Thread::yield();
+        stopWriter();
+
+        if (s_mode == eLOG_BINARY) s_mode = eLOG_SYNC;
+        closeBinaryFile();
+
+        if (!wasAsync) writeRepeatSummary();
+        gLog.repeats = 0;
+        gLog.lastRecord.length = 0xFFFFFFFF;
+        closeLogFile();
+
+        // Les sinks restent à l'appelant : flush puis on les détache
+        {
+            std::lock_guard<std::mutex> sinkLock(gLog.sinkMutex);
+            const U32 count = gLog.sinkCount.load(std::memory_order_relaxed);
+            for (U32 i = 0; i < count; ++i)
+            {
+                gLog.sinks[i]->flush();
+                gLog.sinks[i] = nullptr;
+            }
+            gLog.sinkCount.store(0, std::memory_order_release);
+        }
+
+        if (gLog.fileBuffer)
+        {
+            Allocator::free(gLog.fileBuffer);
+            gLog.fileBuffer = nullptr;
+        }
+        if (gLog.spareFileBuffer)
+        {
+            Allocator::free(gLog.spareFileBuffer);
+            gLog.spareFileBuffer = nullptr;
+        }
         if (gLog.buffer)
         {
             delete[] gLog.buffer;
@@ -87,13 +1091,253 @@ namespace fs = std::filesystem;
         gLog.inited = false;
     }
 
-    void Log::message(LogLevel level, const char* tag, const char* color, 
-                      const char* file, const char* func, int line, 
+    static void flushSinks()
+    {
+        std::unique_lock<std::mutex> lock(gLog.sinkMutex, std::try_to_lock);
+        if (!lock.owns_lock()) return;
+        const U32 count = gLog.sinkCount.load(std::memory_order_relaxed);
+        for (U32 i = 0; i < count; ++i) gLog.sinks[i]->flush();
+    }
+
+    bool Log::addSink(LogSink* sink)
+    {
+        if (!sink) return false;
+        std::lock_guard<std::mutex> lock(gLog.sinkMutex);
+        const U32 count = gLog.sinkCount.load(std::memory_order_relaxed);
+        if (count >= g_max_sinks) return false;
+        for (U32 i = 0; i < count; ++i)
+        {
+            if (gLog.sinks[i] == sink) return true;
+        }
+        gLog.sinks[count] = sink;
+        gLog.sinkCount.store(count + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Après removeSink, le Log n'appellera plus le sink (verrou partagé avec le writer)
+    void Log::removeSink(LogSink* sink)
+    {
+        std::lock_guard<std::mutex> lock(gLog.sinkMutex);
+        const U32 count = gLog.sinkCount.load(std::memory_order_relaxed);
+        for (U32 i = 0; i < count; ++i)
+        {
+            if (gLog.sinks[i] == sink)
+            {
+                gLog.sinks[i] = gLog.sinks[count - 1];
+                gLog.sinks[count - 1] = nullptr;
+                gLog.sinkCount.store(count - 1, std::memory_order_release);
+                sink->flush();
+                return;
+            }
+        }
+    }
+
+    const char* Log::getLevelName(LogLevel level)
+    {
+        return (U32)level < 6 ? LevelStringsPlain[level] : "?";
+    }
+
+    void Log::flush()
+    {
+        if (s_mode == eLOG_BINARY)
+        {
+            std::unique_lock<std::mutex> lock(gLog.binMutex, std::try_to_lock);
+            if (lock.owns_lock()) flushBinaryBuffers();
+        }
+
+        if (gLog.mode != eLOG_ASYNC)
+        {
+            // try_lock : flush() peut venir du crash handler pendant un message
+            std::unique_lock<std::mutex> lock(gLog.mutex, std::try_to_lock);
+            if (lock.owns_lock())
+            {
+                writeRepeatSummary();
+                flushLogFile();
+            }
+            fflush(stdout);
+            flushSinks();
+            return;
+        }
+
+        const U64 target = gLog.enqueued.load(std::memory_order_acquire);
+        gLog.flushRequested.store(true, std::memory_order_release);
+        wakeWriter();
+
+        // Tant que le writer tourne, lui seul écrit (buffers de lot, rotation) : on lui
+        // laisse ~1s puis on abandonne. On ne vide la queue nous-mêmes que s'il est sorti.
+        for (U32 spin = 0; gLog.written.load(std::memory_order_acquire) < target ||
+                           gLog.flushRequested.load(std::memory_order_acquire); ++spin)
+        {
+            if (!gLog.writerAlive.load(std::memory_order_acquire))
+            {
+                // try_lock : un seul appelant vide la queue, jamais pendant terminate()
+                std::unique_lock<std::mutex> lock(gLog.mutex, std::try_to_lock);
+                if (lock.owns_lock() && gLog.termBatch)
+                {
+                    LogRecord record;
+                    while (gLog.queue.pop(record))
+                    {
+                        writeBatch(&record, 1);
+                        gLog.written.fetch_add(1, std::memory_order_release);
+                    }
+                    flushLogFile();
+                }
+                gLog.flushRequested.store(false, std::memory_order_release);
+                break;
+            }
+            if (spin > 1000) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        fflush(stdout);
+        flushSinks();
+    }
+
+    void Log::setMaxFileSize(U32 size)
+    {
+        gLog.maxFileSize.store(size, std::memory_order_relaxed);
+    }
+
+    void Log::setMaxFileMessages(U32 count)
+    {
+        gLog.maxFileMessages.store(count, std::memory_order_relaxed);
+    }
+
+    void Log::setMaxRotatedFiles(U32 count)
+    {
+        gLog.maxRotatedFiles.store(count, std::memory_order_relaxed);
+    }
+
+    void Log::setFlushPolicy(LogLevel flushLevel, U32 intervalMs)
+    {
+        gLog.flushLevel.store(flushLevel, std::memory_order_relaxed);
+        gLog.flushIntervalMs.store(intervalMs > 0 ? intervalMs : 1, std::memory_order_relaxed);
+    }
+
+    void Log::setDeduplication(bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(gLog.mutex);
+        gLog.dedup = enabled;
+    }
+
+    /*
+     * Token bucket par site, sous forme GCRA : rateNextNs avance de 1/maxPerSecond
+     * à chaque message accepté ; on refuse quand il dépasse "maintenant" de plus
+     * d'une seconde (rafale max = maxPerSecond messages). Un seul CAS, pas de verrou.
+     */
+    bool Log::allowRate(LogSite& site, LogLevel level, U32 maxPerSecond)
+    {
+        if (maxPerSecond == 0) return false;
+
+        const U64 now = getTimestampNs();
+        const U64 interval = 1000000000ull / maxPerSecond;
+        const U64 tolerance = 1000000000ull - interval;
+
+        U64 next = site.rateNextNs.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const U64 base = next > now ? next : now;
+            if (base - now > tolerance)
+            {
+                site.suppressed.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (site.rateNextNs.compare_exchange_weak(next, base + interval, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        const U32 suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+        if (suppressed > 0)
+        {
+            message(level, site.tag, site.color, site.file, site.func, site.line,
+                    "%u similar messages suppressed (rate limit %u/s)", suppressed, maxPerSecond);
+        }
+        return true;
+    }
+
+    void Log::setLevel(LogLevel level)
+    {
+        s_minLevel = level;
+    }
+
+    U64 Log::getDroppedCount()
+    {
+        return gLog.dropped.load(std::memory_order_relaxed);
+    }
+
+    static void pushRecord(LogLevel level, const char* tag, const char* color,
+                           const char* fileName, const char* func, int line,
+                           const char* fmt, va_list args)
+    {
+        LogRecord record;
+        record.level = level;
+        record.tag = tag;
+        record.color = color;
+        record.file = fileName;
+        record.func = func;
+        record.line = line;
+        record.threadId = Thread::getCurrentId();
+        record.timestampNs = Log::getTimestampNs();
+
+        int length = vsnprintf(record.text, sizeof(record.text), fmt, args);
+        if (length >= (int)sizeof(record.text))
+        {
+            memcpy(record.text + sizeof(record.text) - 4, "...", 4);
+            length = (int)sizeof(record.text) - 1;
+        }
+        record.length = length > 0 ? (U32)length : 0;
+
+        if (Profiler::isCapturing()) Profiler::captureLog((U8)level, tag, record.text, record.length);
+
+        while (!gLog.queue.push(record))
+        {
+            if (gLog.overflow != eLOG_BLOCK)
+            {
+                gLog.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            wakeWriter();
+            Thread::yield();
+        }
+
+        gLog.enqueued.fetch_add(1, std::memory_order_release);
+        wakeWriter();
+    }
+
+    void Log::message(LogLevel level, const char* tag, const char* color,
+                      const char* file, const char* func, int line,
                       const char* fmt, ...)
     {
-        if (!gLog.inited || level < gLog.minLevel) return;
+        if (!gLog.inited || level < s_minLevel) return;
+
+        const char* fileName = getFileName(file);
+
+        // --- Mode async : un seul vsnprintf dans le record, pas de verrou ---
+        gLog.asyncProducers.fetch_add(1, std::memory_order_seq_cst);
+        if (gLog.mode == eLOG_ASYNC)
+        {
+            va_list args;
+            va_start(args, fmt);
+            pushRecord(level, tag, color, fileName, func, line, fmt, args);
+            va_end(args);
+            gLog.asyncProducers.fetch_sub(1, std::memory_order_release);
+
+            if (level == eFATAL)
+            {
+                flush();
+                fprintf(stderr, "[FATAL ERROR] Hitting the wall. Check log: %s\n", gLog.filePath);
+                *(volatile int*)0 = 0;
+            }
+            return;
+        }
+        gLog.asyncProducers.fetch_sub(1, std::memory_order_release);
+
+        const U64 timestampNs = getTimestampNs();
+        const U32 threadId = Thread::getCurrentId();
 
         std::lock_guard<std::mutex> lock(gLog.mutex);
+        if (!gLog.inited) return;   // terminate() passé pendant l'attente du verrou
 
         va_list args;
         va_start(args, fmt);
@@ -111,39 +1355,58 @@ namespace fs = std::filesystem;
         vsnprintf(gLog.buffer, gLog.bufferSize, fmt, args);
         va_end(args);
 
-        const char* fileName = getFileName(file);
-        
+        if (Profiler::isCapturing()) Profiler::captureLog((U8)level, tag, gLog.buffer, needed > 0 ? (U32)needed : 0);
+
+        // --- Déduplication : un message identique au précédent est seulement compté ---
+        if (gLog.dedup && level != eFATAL)
+        {
+            const U32 length = needed > 0 ? (U32)needed : 0;
+            if (isRepeat(level, tag, fileName, line, gLog.buffer, length)) return;
+            writeRepeatSummary();
+            rememberRecord(level, tag, color, fileName, func, line, threadId, gLog.buffer, length);
+        }
+
         // --- Sortie Console ---
         if (gLog.output & eTERMOUT)
         {
             // On a ajouté func ici après le nom du fichier
             if (color)
-                printf("[%s][%s] (%s | %s:%d) %s%s\x1b[0m\n", LevelStrings[level], tag, func, fileName, line, color, gLog.buffer);
+                printf("[%s][T%u][%s] (%s | %s:%d) %s%s\x1b[0m\n", LevelStrings[level], threadId, tag, func, fileName, line, color, gLog.buffer);
             else
-                printf("[%s][%s] (%s | %s:%d) %s\n", LevelStrings[level], tag, func, fileName, line, gLog.buffer);
+                printf("[%s][T%u][%s] (%s | %s:%d) %s\n", LevelStrings[level], threadId, tag, func, fileName, line, gLog.buffer);
         }
 
-        // --- Sortie Fichier ---
-        if (gLog.output & eFILEOUT)
+        // --- Sortie Fichier (bufferisée, flush par niveau / période) ---
+        if ((gLog.output & eFILEOUT) && gLog.file)
         {
-            FILE* f = fopen(gLog.filePath, "at");
-            if (f)
-            {
-                time_t now = time(nullptr);
-                struct tm* ts = localtime(&now);
-                char tBuf[10];
-                strftime(tBuf, sizeof(tBuf), "%H:%M:%S", ts);
+            char tBuf[24];
+            formatWallTime(timestampNs, tBuf, sizeof(tBuf));
 
-                fprintf(f, "[%s][%s][%s] (%s | %s:%d) %s\n", 
-                        tBuf, LevelStringsPlain[level], tag, func, fileName, line, gLog.buffer);
-                fclose(f);
-            }
+            int written = fprintf(gLog.file, "[%s][%s][T%u][%s] (%s | %s:%d) %s\n", 
+                                  tBuf, LevelStringsPlain[level], threadId, tag, func, fileName, line, gLog.buffer);
+            afterFileWrite(level, written > 0 ? (U64)written : 0, 1);
+        }
+
+        // --- Sinks enregistrés ---
+        if (gLog.sinkCount.load(std::memory_order_acquire) > 0)
+        {
+            submitToSinks(LogEntry{ level, tag, color, fileName, func, line, threadId, timestampNs,
+                                    gLog.buffer, needed > 0 ? (U32)needed : 0 });
         }
 
         if (level == eFATAL)
         {
+            // gLog.mutex est tenu : pas de flush(), qui le reprendrait
+            if (s_mode == eLOG_BINARY)
+            {
+                std::lock_guard<std::mutex> binLock(gLog.binMutex);
+                flushBinaryBuffers();
+            }
+            flushLogFile();
+            fflush(stdout);
+            flushSinks();
             fprintf(stderr, "[FATAL ERROR] Hitting the wall. Check log: %s\n", gLog.filePath);
-            *(volatile int*)0 = 0; 
+            *(volatile int*)0 = 0;
         }
     }
 
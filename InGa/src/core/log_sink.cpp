@@ -0,0 +1,169 @@
+#include <InGa/core/log_sink.h>
+#include <atomic>
+#include <cstring>
+
+#if defined(INGA_PLATFORM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace Inga
+{
+    // Taille max d'une ligne formatée par un sink (au-delà : tronquée)
+    static const U32 g_sink_line_size = 2048;
+
+    void LogSink::submit(const LogEntry& entry)
+    {
+        if (entry.level < m_level) return;
+
+        char line[g_sink_line_size];
+        int length = m_formatter(line, sizeof(line), entry);
+        if (length <= 0) return;
+        if (length >= (int)sizeof(line))
+        {
+            length = (int)sizeof(line) - 1;
+            line[length - 1] = '\n';
+        }
+        write(entry, line, (U32)length);
+    }
+
+    int LogSink::formatDefault(char* dst, size_t size, const LogEntry& entry)
+    {
+        char tBuf[24];
+        Log::formatTimestamp(entry.timestampNs, tBuf, sizeof(tBuf));
+        return snprintf(dst, size, "[%s][%s][T%u][%s] (%s | %s:%d) %.*s\n",
+                        tBuf, Log::getLevelName(entry.level), entry.threadId, entry.tag,
+                        entry.func, entry.file, entry.line, (int)entry.length, entry.text);
+    }
+
+    // --- MappedRingFileSink ---
+
+    MappedRingFileSink::~MappedRingFileSink()
+    {
+        close();
+    }
+
+    bool MappedRingFileSink::open(const char* path, U32 capacity)
+    {
+        close();
+        if (capacity < 4096) capacity = 4096;
+
+        const U64 mappedSize = sizeof(RingFileHeader) + (U64)capacity;
+
+#if defined(INGA_PLATFORM_WINDOWS)
+        HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                  CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                            (DWORD)(mappedSize >> 32), (DWORD)mappedSize, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)mappedSize);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_file = (intptr_t)file;
+        m_mapping = mapping;
+#else
+        int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+
+        if (ftruncate(fd, (off_t)mappedSize) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, (size_t)mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (view == MAP_FAILED)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        m_file = fd;
+#endif
+
+        m_mappedSize = mappedSize;
+        m_capacity = capacity;
+        m_header = (RingFileHeader*)view;
+        m_data = (U8*)view + sizeof(RingFileHeader);
+
+        memset(m_header, 0, sizeof(RingFileHeader));
+        memcpy(m_header->magic, INGA_RINGLOG_MAGIC, sizeof(m_header->magic));
+        m_header->version = INGA_RINGLOG_VERSION;
+        m_header->headerSize = sizeof(RingFileHeader);
+        m_header->capacity = m_capacity;
+        return true;
+    }
+
+    void MappedRingFileSink::close()
+    {
+        if (!m_header) return;
+
+#if defined(INGA_PLATFORM_WINDOWS)
+        FlushViewOfFile(m_header, 0);
+        UnmapViewOfFile(m_header);
+        CloseHandle((HANDLE)m_mapping);
+        CloseHandle((HANDLE)m_file);
+        m_mapping = nullptr;
+#else
+        munmap(m_header, (size_t)m_mappedSize);
+        ::close((int)m_file);
+#endif
+
+        m_file = -1;
+        m_header = nullptr;
+        m_data = nullptr;
+        m_capacity = 0;
+        m_mappedSize = 0;
+    }
+
+    void MappedRingFileSink::flush()
+    {
+        if (!m_header) return;
+#if defined(INGA_PLATFORM_WINDOWS)
+        FlushViewOfFile(m_header, 0);
+#else
+        msync(m_header, (size_t)m_mappedSize, MS_ASYNC);
+#endif
+    }
+
+    void MappedRingFileSink::write(const LogEntry&, const char* line, U32 length)
+    {
+        if (!m_header) return;
+
+        // Une ligne plus grande que l'anneau : on ne garde que la fin
+        if (length > m_capacity)
+        {
+            line += length - m_capacity;
+            length = (U32)m_capacity;
+        }
+
+        std::atomic_ref<U64> writeOffset(m_header->writeOffset);
+        const U64 offset = writeOffset.load(std::memory_order_relaxed);
+        const U64 position = offset % m_capacity;
+        const U64 firstPart = m_capacity - position < length ? m_capacity - position : length;
+
+        memcpy(m_data + position, line, (size_t)firstPart);
+        if (firstPart < length)
+        {
+            memcpy(m_data, line + firstPart, (size_t)(length - firstPart));
+        }
+
+        // Publié après la copie : un lecteur (ou le fichier après crash) voit des lignes complètes
+        writeOffset.store(offset + length, std::memory_order_release);
+    }
+}
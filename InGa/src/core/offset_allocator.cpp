@@ -0,0 +1,311 @@
+#include <InGa/core/offset_allocator.h>
+#include <InGa/core/allocator.h>
+#include <bit>
+#include <cstring>
+
+namespace Inga
+{
+    // --- Encodage des tailles en classes (petit flottant 5.3) ---
+
+    static const U32 MANTISSA_BITS = 3;
+    static const U32 MANTISSA_VALUE = 1 << MANTISSA_BITS;
+    static const U32 MANTISSA_MASK = MANTISSA_VALUE - 1;
+    static const U32 NO_BIT = 0xFFFFFFFF;
+
+    // Classe dont la plus petite taille est >= size : toute région qui y est rangée convient
+    static U32 sizeToBinRoundUp(U32 size)
+    {
+        if (size < MANTISSA_VALUE) return size;
+
+        const U32 highestBit = 31 - (U32)std::countl_zero(size);
+        const U32 mantissaStart = highestBit - MANTISSA_BITS;
+        const U32 exponent = mantissaStart + 1;
+        U32 mantissa = (size >> mantissaStart) & MANTISSA_MASK;
+        if (size & ((1u << mantissaStart) - 1)) ++mantissa;   // la retenue passe dans l'exposant
+
+        return (exponent << MANTISSA_BITS) + mantissa;
+    }
+
+    // Classe dont la plus petite taille est <= size : rangement d'une région libre
+    static U32 sizeToBinRoundDown(U32 size)
+    {
+        if (size < MANTISSA_VALUE) return size;
+
+        const U32 highestBit = 31 - (U32)std::countl_zero(size);
+        const U32 mantissaStart = highestBit - MANTISSA_BITS;
+        const U32 exponent = mantissaStart + 1;
+        const U32 mantissa = (size >> mantissaStart) & MANTISSA_MASK;
+
+        return (exponent << MANTISSA_BITS) | mantissa;
+    }
+
+    static U32 lowestBitAfter(U32 mask, U32 startBit)
+    {
+        if (startBit >= 32) return NO_BIT;
+        const U32 masked = mask & ~((1u << startBit) - 1);
+        return masked ? (U32)std::countr_zero(masked) : NO_BIT;
+    }
+
+    // --- OffsetAllocator ---
+
+    bool OffsetAllocator::init(U32 size, U32 maxAllocations, U16 groupId)
+    {
+        shutdown();
+        if (size == 0 || maxAllocations == 0) return false;
+
+        // Une région libre de plus que d'allocations : le reste en fin d'espace
+        m_maxNodes = maxAllocations + 1;
+        m_nodes = static_cast<Node*>(Allocator::alloc((U64)sizeof(Node) * m_maxNodes, alignof(Node), groupId, __FILE__, __LINE__));
+        m_freeNodes = static_cast<U32*>(Allocator::alloc((U64)sizeof(U32) * m_maxNodes, alignof(U32), groupId, __FILE__, __LINE__));
+        if (!m_nodes || !m_freeNodes)
+        {
+            shutdown();
+            return false;
+        }
+
+        memset(m_nodes, 0, (size_t)sizeof(Node) * m_maxNodes);
+        m_size = size;
+        reset();
+        return true;
+    }
+
+    void OffsetAllocator::shutdown()
+    {
+        if (m_nodes) Allocator::free(m_nodes);
+        if (m_freeNodes) Allocator::free(m_freeNodes);
+        m_nodes = nullptr;
+        m_freeNodes = nullptr;
+        m_size = 0;
+        m_maxNodes = 0;
+        m_freeStorage = 0;
+        m_allocationCount = 0;
+        m_freeOffset = 0;
+    }
+
+    void OffsetAllocator::reset()
+    {
+        if (!m_nodes) return;
+
+        m_freeStorage = 0;
+        m_allocationCount = 0;
+        m_usedBinsTop = 0;
+        memset(m_usedBins, 0, sizeof(m_usedBins));
+        for (U32 i = 0; i < BIN_COUNT; ++i) m_binHeads[i] = Node::UNUSED;
+
+        // Pile inversée : les premiers noeuds sortent en premier
+        for (U32 i = 0; i < m_maxNodes; ++i) m_freeNodes[i] = m_maxNodes - i - 1;
+        m_freeOffset = m_maxNodes;
+
+        insertNodeIntoBin(m_size, 0);
+    }
+
+    OffsetAllocation OffsetAllocator::allocate(U32 size)
+    {
+        OffsetAllocation allocation;
+        if (!m_nodes || size == 0 || size > m_freeStorage) return allocation;
+
+        const U32 minBin = sizeToBinRoundUp(size);
+        const U32 minTop = minBin >> MANTISSA_BITS;
+        const U32 minLeaf = minBin & MANTISSA_MASK;
+
+        U32 top = minTop;
+        U32 leaf = NO_BIT;
+        if (m_usedBinsTop & (1u << top)) leaf = lowestBitAfter(m_usedBins[top], minLeaf);
+
+        if (leaf == NO_BIT)
+        {
+            top = lowestBitAfter(m_usedBinsTop, minTop + 1);
+            if (top == NO_BIT) return allocation;
+            leaf = (U32)std::countr_zero((U32)m_usedBins[top]);
+        }
+
+        const U32 bin = (top << MANTISSA_BITS) | leaf;
+
+        // La région garde son noeud ; il en faut un libre pour le reste
+        const U32 nodeIndex = m_binHeads[bin];
+        Node& node = m_nodes[nodeIndex];
+        const U32 regionSize = node.size;
+        if (regionSize > size && m_freeOffset == 0) return allocation;
+
+        m_binHeads[bin] = node.binNext;
+        if (node.binNext != Node::UNUSED) m_nodes[node.binNext].binPrev = Node::UNUSED;
+        m_freeStorage -= regionSize;
+
+        if (m_binHeads[bin] == Node::UNUSED)
+        {
+            m_usedBins[top] &= (U8)~(1u << leaf);
+            if (m_usedBins[top] == 0) m_usedBinsTop &= ~(1u << top);
+        }
+
+        node.size = size;
+        node.used = true;
+        node.generation++;
+        node.binPrev = Node::UNUSED;
+        node.binNext = Node::UNUSED;
+
+        // Le reste redevient une région libre, voisine de droite
+        const U32 remainder = regionSize - size;
+        if (remainder > 0)
+        {
+            const U32 restIndex = insertNodeIntoBin(remainder, node.offset + size);
+            Node& rest = m_nodes[restIndex];
+
+            if (node.neighborNext != Node::UNUSED) m_nodes[node.neighborNext].neighborPrev = restIndex;
+            rest.neighborPrev = nodeIndex;
+            rest.neighborNext = node.neighborNext;
+            node.neighborNext = restIndex;
+        }
+
+        ++m_allocationCount;
+        allocation.offset = node.offset;
+        allocation.metadata = nodeIndex;
+        allocation.generation = node.generation;
+        return allocation;
+    }
+
+    void OffsetAllocator::free(OffsetAllocation allocation)
+    {
+        if (!m_nodes || allocation.metadata >= m_maxNodes) return;
+
+        const U32 nodeIndex = allocation.metadata;
+        Node& node = m_nodes[nodeIndex];
+
+        // Un handle périmé (double free, free après reset ou noeud réattribué) casserait
+        // les listes : assert en debug, ignoré en release
+        const bool live = node.used && node.generation == allocation.generation;
+        INGA_ASSERT_RAW(live, "OffsetAllocator::free : stale or double-freed allocation");
+        if (!live) return;
+
+        U32 offset = node.offset;
+        U32 size = node.size;
+
+        // Fusion avec les voisins libres : leurs noeuds retournent à la pile
+        if (node.neighborPrev != Node::UNUSED && !m_nodes[node.neighborPrev].used)
+        {
+            const U32 prevIndex = node.neighborPrev;
+            Node& prev = m_nodes[prevIndex];
+            offset = prev.offset;
+            size += prev.size;
+
+            removeNodeFromBin(prevIndex);
+            node.neighborPrev = prev.neighborPrev;
+        }
+
+        if (node.neighborNext != Node::UNUSED && !m_nodes[node.neighborNext].used)
+        {
+            const U32 nextIndex = node.neighborNext;
+            Node& next = m_nodes[nextIndex];
+            size += next.size;
+
+            removeNodeFromBin(nextIndex);
+            node.neighborNext = next.neighborNext;
+        }
+
+        const U32 neighborPrev = node.neighborPrev;
+        const U32 neighborNext = node.neighborNext;
+
+        node.used = false;
+        m_freeNodes[m_freeOffset++] = nodeIndex;
+        --m_allocationCount;
+
+        const U32 mergedIndex = insertNodeIntoBin(size, offset);
+        Node& merged = m_nodes[mergedIndex];
+
+        merged.neighborPrev = neighborPrev;
+        merged.neighborNext = neighborNext;
+        if (neighborPrev != Node::UNUSED) m_nodes[neighborPrev].neighborNext = mergedIndex;
+        if (neighborNext != Node::UNUSED) m_nodes[neighborNext].neighborPrev = mergedIndex;
+    }
+
+    U32 OffsetAllocator::getAllocationSize(OffsetAllocation allocation) const
+    {
+        if (!m_nodes || allocation.metadata >= m_maxNodes) return 0;
+        const Node& node = m_nodes[allocation.metadata];
+        return node.used && node.generation == allocation.generation ? node.size : 0;
+    }
+
+    OffsetAllocatorStats OffsetAllocator::getStats() const
+    {
+        OffsetAllocatorStats stats{};
+        stats.totalFree = m_freeStorage;
+        stats.allocationCount = m_allocationCount;
+        if (!m_nodes) return stats;
+
+        // Les régions d'une classe ne sont pas triées : la plus haute classe est parcourue entièrement
+        if (m_usedBinsTop)
+        {
+            const U32 top = 31 - (U32)std::countl_zero(m_usedBinsTop);
+            const U32 leaf = 31 - (U32)std::countl_zero((U32)m_usedBins[top]);
+            for (U32 i = m_binHeads[(top << MANTISSA_BITS) | leaf]; i != Node::UNUSED; i = m_nodes[i].binNext)
+            {
+                if (m_nodes[i].size > stats.largestFree) stats.largestFree = m_nodes[i].size;
+            }
+        }
+
+        for (U32 bin = 0; bin < BIN_COUNT; ++bin)
+        {
+            for (U32 i = m_binHeads[bin]; i != Node::UNUSED; i = m_nodes[i].binNext) ++stats.freeRegionCount;
+        }
+        return stats;
+    }
+
+    U32 OffsetAllocator::insertNodeIntoBin(U32 size, U32 offset)
+    {
+        const U32 bin = sizeToBinRoundDown(size);
+        const U32 top = bin >> MANTISSA_BITS;
+        const U32 leaf = bin & MANTISSA_MASK;
+
+        if (m_binHeads[bin] == Node::UNUSED)
+        {
+            m_usedBins[top] |= (U8)(1u << leaf);
+            m_usedBinsTop |= 1u << top;
+        }
+
+        const U32 head = m_binHeads[bin];
+        const U32 nodeIndex = m_freeNodes[--m_freeOffset];
+
+        Node& node = m_nodes[nodeIndex];
+        node.offset = offset;
+        node.size = size;
+        node.binPrev = Node::UNUSED;
+        node.binNext = head;
+        node.neighborPrev = Node::UNUSED;
+        node.neighborNext = Node::UNUSED;
+        node.used = false;
+
+        if (head != Node::UNUSED) m_nodes[head].binPrev = nodeIndex;
+        m_binHeads[bin] = nodeIndex;
+
+        m_freeStorage += size;
+        return nodeIndex;
+    }
+
+    void OffsetAllocator::removeNodeFromBin(U32 nodeIndex)
+    {
+        Node& node = m_nodes[nodeIndex];
+
+        if (node.binPrev != Node::UNUSED)
+        {
+            m_nodes[node.binPrev].binNext = node.binNext;
+            if (node.binNext != Node::UNUSED) m_nodes[node.binNext].binPrev = node.binPrev;
+        }
+        else
+        {
+            const U32 bin = sizeToBinRoundDown(node.size);
+            const U32 top = bin >> MANTISSA_BITS;
+            const U32 leaf = bin & MANTISSA_MASK;
+
+            m_binHeads[bin] = node.binNext;
+            if (node.binNext != Node::UNUSED) m_nodes[node.binNext].binPrev = Node::UNUSED;
+
+            if (m_binHeads[bin] == Node::UNUSED)
+            {
+                m_usedBins[top] &= (U8)~(1u << leaf);
+                if (m_usedBins[top] == 0) m_usedBinsTop &= ~(1u << top);
+            }
+        }
+
+        m_freeNodes[m_freeOffset++] = nodeIndex;
+        m_freeStorage -= node.size;
+    }
+}
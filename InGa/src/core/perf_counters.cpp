@@ -0,0 +1,216 @@
+#include <InGa/core/perf_counters.h>
+#include <atomic>
+#include <cstring>
+
+#if defined(INGA_PLATFORM_LINUX)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace Inga
+{
+    static const char* PerfCounterNames[ePERF_COUNTER_COUNT] =
+    {
+        "cycles", "instructions", "l1dMisses", "llcMisses", "branchMisses"
+    };
+
+    const char* PerfCounterGroup::getName(PerfCounter counter)
+    {
+        return (U32)counter < ePERF_COUNTER_COUNT ? PerfCounterNames[counter] : "?";
+    }
+
+    PerfCounterGroup::PerfCounterGroup()
+        : m_mask(0)
+        , m_openCount(0)
+        , m_rdpmc(false)
+    {
+        for (U32 i = 0; i < ePERF_COUNTER_COUNT; ++i)
+        {
+            m_fds[i] = -1;
+            m_pages[i] = nullptr;
+            m_slots[i] = 0;
+        }
+    }
+
+    PerfCounterGroup::~PerfCounterGroup()
+    {
+        close();
+    }
+
+#if defined(INGA_PLATFORM_LINUX)
+
+    struct PerfCounterConfig
+    {
+        U32 type;
+        U64 config;
+    };
+
+    static const PerfCounterConfig PerfCounterConfigs[ePERF_COUNTER_COUNT] =
+    {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    };
+
+    bool PerfCounterGroup::open()
+    {
+        close();
+
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        bool rdpmc = true;
+
+        for (U32 i = 0; i < ePERF_COUNTER_COUNT; ++i)
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PerfCounterConfigs[i].type;
+            attr.config = PerfCounterConfigs[i].config;
+            attr.disabled = i == 0 ? 1 : 0;   // le leader démarre tout le groupe
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+
+            const int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : m_fds[0], PERF_FLAG_FD_CLOEXEC);
+            if (fd < 0)
+            {
+                if (i == 0) return false; // pas de PMU accessible : rien à mesurer
+                continue;                 // compteur absent sur ce CPU : ignoré
+            }
+
+            m_fds[i] = fd;
+            m_slots[i] = m_openCount++;
+            m_mask |= 1u << i;
+
+            void* page = mmap(nullptr, (size_t)pageSize, PROT_READ, MAP_SHARED, fd, 0);
+            if (page == MAP_FAILED)
+            {
+                rdpmc = false;
+                continue;
+            }
+            m_pages[i] = page;
+            if (!((const perf_event_mmap_page*)page)->cap_user_rdpmc) rdpmc = false;
+        }
+
+        ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+#if defined(__x86_64__) || defined(__i386__)
+        m_rdpmc = rdpmc;
+#else
+        m_rdpmc = false;
+#endif
+        return true;
+    }
+
+    void PerfCounterGroup::close()
+    {
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        for (U32 i = ePERF_COUNTER_COUNT; i-- > 0; )
+        {
+            if (m_pages[i]) munmap(m_pages[i], (size_t)pageSize);
+            if (m_fds[i] >= 0) ::close(m_fds[i]);
+            m_pages[i] = nullptr;
+            m_fds[i] = -1;
+            m_slots[i] = 0;
+        }
+        m_mask = 0;
+        m_openCount = 0;
+        m_rdpmc = false;
+    }
+
+    void PerfCounterGroup::readGroup(PerfCounterSample& sample) const
+    {
+        U64 buffer[1 + ePERF_COUNTER_COUNT] = {};
+        memset(&sample, 0, sizeof(sample));
+        if (::read(m_fds[0], buffer, sizeof(buffer)) <= 0) return;
+
+        for (U32 i = 0; i < ePERF_COUNTER_COUNT; ++i)
+        {
+            if ((m_mask & (1u << i)) && m_slots[i] < buffer[0]) sample.values[i] = buffer[1 + m_slots[i]];
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // Protocole de la page perf : relire tant que "lock" a bougé pendant la lecture
+    static inline bool readMapped(const void* mapped, U64& value)
+    {
+        const volatile perf_event_mmap_page* page = (const volatile perf_event_mmap_page*)mapped;
+        U32 sequence;
+        U64 count;
+        do
+        {
+            sequence = page->lock;
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+
+            const U32 index = page->index;
+            if (index == 0) return false; // compteur pas programmé en ce moment (multiplexage)
+
+            I64 pmc = (I64)__builtin_ia32_rdpmc((int)index - 1);
+            const U32 shift = 64 - page->pmc_width;
+            pmc = (I64)((U64)pmc << shift) >> shift;
+            count = (U64)((I64)page->offset + pmc);
+
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } while (page->lock != sequence);
+
+        value = count;
+        return true;
+    }
+#endif
+
+    void PerfCounterGroup::read(PerfCounterSample& sample) const
+    {
+        if (!isOpen())
+        {
+            memset(&sample, 0, sizeof(sample));
+            return;
+        }
+
+#if defined(__x86_64__) || defined(__i386__)
+        if (m_rdpmc)
+        {
+            for (U32 i = 0; i < ePERF_COUNTER_COUNT; ++i)
+            {
+                sample.values[i] = 0;
+                if (!(m_mask & (1u << i))) continue;
+                if (!readMapped(m_pages[i], sample.values[i]))
+                {
+                    readGroup(sample);
+                    return;
+                }
+            }
+            return;
+        }
+#endif
+        readGroup(sample);
+    }
+
+#else
+
+    bool PerfCounterGroup::open()
+    {
+        return false;
+    }
+
+    void PerfCounterGroup::close()
+    {
+    }
+
+    void PerfCounterGroup::readGroup(PerfCounterSample& sample) const
+    {
+        memset(&sample, 0, sizeof(sample));
+    }
+
+    void PerfCounterGroup::read(PerfCounterSample& sample) const
+    {
+        memset(&sample, 0, sizeof(sample));
+    }
+
+#endif
+}
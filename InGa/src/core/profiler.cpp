@@ -0,0 +1,1248 @@
+#include <InGa/core/profiler.h>
+#include <InGa/core/allocator.h>
+#include <InGa/core/queue.h>
+#include <InGa/core/thread.h>
+#include <InGa/core/log.h>
+#include <InGa/core/time.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <new>
+
+#if !defined(INGA_PLATFORM_WINDOWS)
+    #include <csignal>
+#endif
+
+namespace Inga
+{
+    static const U32 g_profiler_max_threads = 64;
+    static const U32 g_profiler_max_depth = 64;
+    static const U32 g_no_node = 0xFFFFFFFF;
+
+    // Capture : capacités fixes, allouées au démarrage de la capture
+    static const U32 g_capture_max_zone_events = 256 * 1024;
+    static const U32 g_capture_max_logs = 16 * 1024;
+    static const U32 g_capture_max_frames = 10000;
+    static const U32 g_capture_max_counter_events = 64 * 1024;
+    static const U32 g_capture_max_allocations = 128 * 1024;
+    static const U32 g_capture_text_size = 112;
+
+    std::atomic<bool> Profiler::s_enabled{false};
+    std::atomic<bool> Profiler::s_capturing{false};
+
+    // name == nullptr : fin de la zone ouverte
+    struct ProfileEvent
+    {
+        U64 ticks;
+        const char* name;
+    };
+
+    // Zone ouverte côté agrégation (thread principal)
+    struct OpenZone
+    {
+        const char* name;
+        U64 startTicks;
+        U64 childTicks;
+        U32 node;
+        PerfCounterSample startCounters;
+    };
+
+    struct ProfileThreadData
+    {
+        SpscRing<ProfileEvent> ring;
+
+        // Compteurs matériels : un échantillon par événement, poussé avant lui
+        PerfCounterGroup perf;
+        SpscRing<PerfCounterSample> counterRing;
+        bool hasCounters = false;
+
+        U32 threadId = 0;
+        U16 threadIndex = 0;
+        std::atomic<bool>* busy = nullptr; // drapeau du thread propriétaire, nul après sa sortie (registryMutex)
+        char name[32];
+
+        // --- Côté producteur (thread propriétaire) ---
+        U32 skipDepth = 0;                 // begins perdus (buffer plein) : ends à ignorer
+        U32 openZones = 0;                 // une place est réservée pour chaque end à venir
+        U32 credits = 0;                   // places libres non réservées (recalculées quand épuisées)
+        std::atomic<U32> dropped{0};
+        std::atomic<bool> dead{false};
+
+        // --- Côté consommateur (endFrame) ---
+        OpenZone stack[g_profiler_max_depth];
+        U32 depth = 0;
+        U32 rootNode = g_no_node;
+    };
+
+    // Événement de zone copié pendant une capture (name == nullptr : fin de zone)
+    struct CaptureZoneEvent
+    {
+        U64 ticks;
+        const char* name;
+        U32 threadId;
+        U32 counterIndex;  // fin de zone : index dans ProfileCapture::counters (ou g_no_node)
+    };
+
+    // Message de log capturé (texte tronqué à g_capture_text_size)
+    struct CaptureLogEvent
+    {
+        U64 timestampNs;
+        const char* tag;
+        U32 threadId;
+        U16 length;
+        U8 level;
+        char text[g_capture_text_size];
+    };
+
+    // Appel à l'allocateur pendant une capture (voir Allocator::setEventHook)
+    struct CaptureAllocEvent
+    {
+        U64 startTicks;
+        U64 durationTicks;
+        U64 lockWaitTicks;
+        U64 size;
+        const void* ptr;
+        U32 threadId;
+        U16 groupId;
+        U8 type;
+    };
+
+    struct CaptureFrame
+    {
+        U64 frameIndex;
+        U64 startNs;
+        U64 durationNs;
+        U32 allocationCalls;   // remplis à l'écriture du fichier
+        U64 allocatedBytes;
+    };
+
+    struct CaptureThreadName
+    {
+        U32 threadId;
+        char name[32];
+    };
+
+    struct ProfileCapture
+    {
+        U16 groupId = 0xFFFF;
+
+        // Demandes (API sous registryMutex, signal via le flag), lues par endFrame
+        U32 pendingFrames = 0;
+        char pendingPath[512] = {};
+        U32 signalFrames = 120;
+        std::atomic<bool> signalRequested{false};
+
+        // Capture en cours (thread de endFrame)
+        bool active = false;
+        bool full = false;
+        U32 framesLeft = 0;
+        U32 frameCount = 0;
+        char path[512] = {};
+        CaptureZoneEvent* zones = nullptr;
+        U32 zoneCount = 0;
+        CaptureFrame* frames = nullptr;
+        PerfCounterSample* counters = nullptr;   // deltas des zones terminées
+        U32 counterCount = 0;
+        CaptureThreadName threadNames[g_profiler_max_threads * 2];
+        U32 threadNameCount = 0;
+
+        // Logs : n'importe quel thread ; logWriters permet d'attendre la fin
+        // des copies en cours avant de libérer le tableau
+        CaptureLogEvent* logs = nullptr;
+        std::atomic<U32> logCount{0};
+        std::atomic<U32> logWriters{0};
+
+        // Allocations : même principe que les logs (hook de l'allocateur)
+        bool allocationsEnabled = true;
+        CaptureAllocEvent* allocations = nullptr;
+        std::atomic<U32> allocationCount{0};
+        std::atomic<U32> allocationWriters{0};
+    };
+
+    // Arbre en construction + arbre publié (échangés à chaque endFrame)
+    struct ProfileTree
+    {
+        ProfileNode* nodes = nullptr;
+        U32 count = 0;
+    };
+
+    struct ProfilerInternal
+    {
+        bool started = false;
+        U16 groupId = 0;
+        U32 eventsPerThread = 0;
+        U32 maxNodes = 0;
+        std::atomic<U32> generation{1};
+
+        std::mutex registryMutex;
+        ProfileThreadData* threads[g_profiler_max_threads] = {};
+        U32 threadCount = 0;
+
+        ProfileTree trees[2];
+        U32 building = 0;
+        ProfileFrame lastFrame = {};
+        U64 frameIndex = 0;
+        U64 frameStartTicks = 0;
+        U64 frameStartNs = 0;
+        U32 droppedNodes = 0;
+
+        ProfileCapture capture;
+
+        std::atomic<bool> hardwareCounters{false};
+        U16 counterGroupId = 0xFFFF;
+        bool counterWarning = false;
+    } gProfiler;
+
+    /*
+     * Buffer du thread courant ; generation invalide le pointeur après stop().
+     * busy est vrai pendant que le thread écrit dans son buffer : stop() l'attend
+     * avant de libérer (generation ne change que sous registryMutex).
+     */
+    struct ProfileThreadSlot
+    {
+        ProfileThreadData* data = nullptr;
+        U32 generation = 0;
+        std::atomic<bool> busy{false};
+
+        ~ProfileThreadSlot()
+        {
+            if (!data) return;
+            std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+            if (generation != gProfiler.generation.load(std::memory_order_relaxed)) return; // déjà libéré par stop()
+            data->busy = nullptr;
+            data->dead.store(true, std::memory_order_release);
+        }
+    };
+
+    static thread_local ProfileThreadSlot tProfileSlot;
+
+    // --- Horloge ---
+
+    U64 Profiler::getTicks()
+    {
+        return Time::now();
+    }
+
+    U64 Profiler::ticksToNs(U64 ticks)
+    {
+        return Time::toNs(ticks);
+    }
+
+    // --- Enregistrement des threads ---
+
+    // Sous registryMutex : groupe perf + buffer d'échantillons de la taille du buffer d'événements
+    static void openThreadCounters(ProfileThreadData* data)
+    {
+        if (!data->perf.open())
+        {
+            if (!gProfiler.counterWarning)
+            {
+                gProfiler.counterWarning = true;
+                INGA_LOG(eWARNING, "PROFILER", "Hardware counters unavailable (perf_event_open failed, no PMU or perf_event_paranoid > 2).");
+            }
+            return;
+        }
+
+        const U64 ringSize = sizeof(PerfCounterSample) * (U64)data->ring.capacity();
+        if (gProfiler.counterGroupId == 0xFFFF)
+        {
+            gProfiler.counterGroupId = Allocator::findGroupId("ProfilerCounters");
+            if (gProfiler.counterGroupId == 0xFFFF)
+            {
+                AllocationGroupInfo info = { "ProfilerCounters", ringSize + 64 * 1024 };
+                gProfiler.counterGroupId = Allocator::addGroup(info);
+            }
+        }
+
+        if (gProfiler.counterGroupId == 0xFFFF || !data->counterRing.init(data->ring.capacity(), gProfiler.counterGroupId))
+        {
+            data->perf.close();
+            return;
+        }
+        data->hasCounters = true;
+    }
+
+    static ProfileThreadData* registerThread(ProfileThreadSlot& slot)
+    {
+        std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+        slot.generation = gProfiler.generation.load(std::memory_order_relaxed);
+        if (!gProfiler.started || gProfiler.threadCount >= g_profiler_max_threads) return nullptr;
+
+        void* memory = Allocator::alloc(sizeof(ProfileThreadData), alignof(ProfileThreadData), gProfiler.groupId, __FILE__, __LINE__);
+        if (!memory) return nullptr;
+
+        ProfileThreadData* data = new (memory) ProfileThreadData();
+        if (!data->ring.init(gProfiler.eventsPerThread, gProfiler.groupId))
+        {
+            data->~ProfileThreadData();
+            Allocator::free(data);
+            return nullptr;
+        }
+
+        data->threadId = Thread::getCurrentId();
+        snprintf(data->name, sizeof(data->name), "Thread %u", data->threadId);
+
+        // registerThread tourne sur le thread lui-même : le groupe perf le mesure
+        if (gProfiler.hardwareCounters.load(std::memory_order_relaxed)) openThreadCounters(data);
+
+        // Index d'affichage : le plus petit libre parmi les threads vivants
+        U16 index = 0;
+        for (bool taken = true; taken; )
+        {
+            taken = false;
+            for (U32 i = 0; i < gProfiler.threadCount; ++i)
+            {
+                if (gProfiler.threads[i]->threadIndex == index) { taken = true; ++index; break; }
+            }
+        }
+        data->threadIndex = index;
+
+        data->busy = &slot.busy;
+
+        gProfiler.threads[gProfiler.threadCount++] = data;
+        return data;
+    }
+
+    static void destroyThread(ProfileThreadData* data)
+    {
+        data->counterRing.shutdown();
+        data->ring.shutdown();
+        data->~ProfileThreadData();
+        Allocator::free(data);
+    }
+
+    /*
+     * Accès au buffer du thread courant, à refermer par leaveThread(). busy est levé
+     * avant de relire generation (seq_cst des deux côtés) : soit stop() voit busy et
+     * attend, soit on voit la nouvelle génération et on n'écrit pas.
+     */
+    static inline ProfileThreadData* enterThread(bool create)
+    {
+        ProfileThreadSlot& slot = tProfileSlot;
+        if (slot.data)
+        {
+            slot.busy.store(true, std::memory_order_seq_cst);
+            if (slot.generation == gProfiler.generation.load(std::memory_order_seq_cst)) return slot.data;
+            slot.busy.store(false, std::memory_order_relaxed);
+        }
+        if (!create) return nullptr;
+
+        // Enregistrement déjà refusé pendant cette session (profiler arrêté, trop de threads)
+        if (!slot.data && slot.generation == gProfiler.generation.load(std::memory_order_acquire)) return nullptr;
+
+        slot.data = registerThread(slot);
+        return slot.data ? enterThread(false) : nullptr;
+    }
+
+    static inline void leaveThread()
+    {
+        tProfileSlot.busy.store(false, std::memory_order_release);
+    }
+
+    // --- Zones (chemin chaud) ---
+
+    void Profiler::beginZone(const char* name)
+    {
+        ProfileThreadData* data = enterThread(true);
+        if (!data) return;
+
+        // Un begin consomme 2 places : la sienne et celle de son end (jamais perdu).
+        // size() surestime côté producteur, les crédits sont donc toujours sûrs.
+        if (data->credits < 2 && data->skipDepth == 0)
+        {
+            const U32 used = data->ring.size() + data->openZones;
+            data->credits = used < data->ring.capacity() ? data->ring.capacity() - used : 0;
+        }
+        if (data->skipDepth > 0 || data->credits < 2)
+        {
+            data->skipDepth++;
+            data->dropped.fetch_add(1, std::memory_order_relaxed);
+            leaveThread();
+            return;
+        }
+
+        data->credits -= 2;
+        data->openZones++;
+
+        const U64 ticks = Time::now();
+        if (data->hasCounters)
+        {
+            PerfCounterSample sample;
+            data->perf.read(sample);
+            data->counterRing.push(sample);
+        }
+        data->ring.push(ProfileEvent{ ticks, name });
+        leaveThread();
+    }
+
+    void Profiler::endZone()
+    {
+        ProfileThreadData* data = enterThread(false);
+        if (!data) return;
+
+        if (data->skipDepth > 0)
+        {
+            data->skipDepth--;
+            leaveThread();
+            return;
+        }
+
+        // Toujours de la place grâce à la réserve prise au begin
+        // (la place n'est rendue aux crédits qu'au prochain recalcul)
+        if (data->openZones == 0)
+        {
+            leaveThread();
+            return;
+        }
+        data->openZones--;
+
+        // Compteurs lus avant l'horloge : la zone n'inclut pas la lecture
+        if (data->hasCounters)
+        {
+            PerfCounterSample sample;
+            data->perf.read(sample);
+            data->counterRing.push(sample);
+        }
+        data->ring.push(ProfileEvent{ Time::now(), nullptr });
+        leaveThread();
+    }
+
+    void Profiler::setThreadName(const char* name)
+    {
+        ProfileThreadData* data = enterThread(true);
+        if (!data) return;
+        snprintf(data->name, sizeof(data->name), "%s", name);
+        leaveThread();
+    }
+
+    // --- Agrégation (endFrame, thread principal) ---
+
+    static U32 addNode(ProfileTree& tree, const char* name, U32 parent, U16 threadIndex)
+    {
+        if (tree.count >= gProfiler.maxNodes)
+        {
+            gProfiler.droppedNodes++;
+            return g_no_node;
+        }
+
+        const U32 index = tree.count++;
+        ProfileNode& node = tree.nodes[index];
+        node.name = name;
+        node.parent = parent;
+        node.firstChild = g_no_node;
+        node.nextSibling = g_no_node;
+        node.depth = parent == g_no_node ? 0 : (U16)(tree.nodes[parent].depth + 1);
+        node.threadIndex = threadIndex;
+        node.calls = 0;
+        node.inclusiveNs = 0;
+        node.exclusiveNs = 0;
+        memset(node.counters, 0, sizeof(node.counters));
+
+        if (parent != g_no_node)
+        {
+            // Ajout en fin de liste : l'ordre des enfants suit l'ordre d'exécution
+            U32* link = &tree.nodes[parent].firstChild;
+            while (*link != g_no_node) link = &tree.nodes[*link].nextSibling;
+            *link = index;
+        }
+        return index;
+    }
+
+    static U32 findOrAddChild(ProfileTree& tree, U32 parent, const char* name, U16 threadIndex)
+    {
+        if (parent == g_no_node) return g_no_node;
+        for (U32 child = tree.nodes[parent].firstChild; child != g_no_node; child = tree.nodes[child].nextSibling)
+        {
+            if (tree.nodes[child].name == name) return child;
+        }
+        return addNode(tree, name, parent, threadIndex);
+    }
+
+    static U32 ensureRoot(ProfileTree& tree, ProfileThreadData* data)
+    {
+        if (data->rootNode == g_no_node)
+        {
+            data->rootNode = addNode(tree, data->name, g_no_node, data->threadIndex);
+        }
+        return data->rootNode;
+    }
+
+    // counters : échantillon lu avec l'événement (thread avec compteurs) ;
+    // pour une fin de zone, delta reçoit les compteurs de la zone (retourne true)
+    static bool processEvent(ProfileTree& tree, ProfileThreadData* data, const ProfileEvent& event,
+                             const PerfCounterSample* counters, PerfCounterSample* delta)
+    {
+        if (event.name)
+        {
+            if (data->depth >= g_profiler_max_depth)
+            {
+                data->depth++; // trop profond : compté pour rester équilibré, pas agrégé
+                return false;
+            }
+            const U32 parent = data->depth > 0 ? data->stack[data->depth - 1].node : ensureRoot(tree, data);
+            OpenZone& zone = data->stack[data->depth++];
+            zone.name = event.name;
+            zone.startTicks = event.ticks;
+            zone.childTicks = 0;
+            zone.node = findOrAddChild(tree, parent, event.name, data->threadIndex);
+            if (counters) zone.startCounters = *counters;
+            return false;
+        }
+
+        if (data->depth == 0) return false; // end sans begin (zone ouverte avant start())
+        if (data->depth > g_profiler_max_depth)
+        {
+            data->depth--;
+            return false;
+        }
+
+        OpenZone& zone = data->stack[--data->depth];
+        const U64 duration = event.ticks > zone.startTicks ? event.ticks - zone.startTicks : 0;
+
+        if (counters)
+        {
+            for (U32 i = 0; i < ePERF_COUNTER_COUNT; ++i)
+            {
+                const U64 start = zone.startCounters.values[i];
+                delta->values[i] = counters->values[i] > start ? counters->values[i] - start : 0;
+            }
+        }
+
+        if (zone.node != g_no_node)
+        {
+            // Les champs *Ns contiennent des ticks jusqu'à la publication
+            ProfileNode& node = tree.nodes[zone.node];
+            node.calls++;
+            node.inclusiveNs += duration;
+            node.exclusiveNs += duration > zone.childTicks ? duration - zone.childTicks : 0;
+            if (counters)
+            {
+                for (U32 i = 0; i < ePERF_COUNTER_COUNT; ++i) node.counters[i] += delta->values[i];
+            }
+        }
+        if (data->depth > 0)
+        {
+            data->stack[data->depth - 1].childTicks += duration;
+        }
+        else if (data->rootNode != g_no_node)
+        {
+            ProfileNode& root = tree.nodes[data->rootNode];
+            root.inclusiveNs += duration;
+            if (counters)
+            {
+                for (U32 i = 0; i < ePERF_COUNTER_COUNT; ++i) root.counters[i] += delta->values[i];
+            }
+        }
+        return counters != nullptr;
+    }
+
+    // Les zones encore ouvertes continuent dans l'arbre de la frame suivante
+    static void reparentOpenZones(ProfileTree& tree, ProfileThreadData* data)
+    {
+        data->rootNode = g_no_node;
+        if (data->depth == 0) return;
+
+        U32 parent = ensureRoot(tree, data);
+        const U32 depth = data->depth < g_profiler_max_depth ? data->depth : g_profiler_max_depth;
+        for (U32 i = 0; i < depth; ++i)
+        {
+            data->stack[i].node = findOrAddChild(tree, parent, data->stack[i].name, data->threadIndex);
+            parent = data->stack[i].node;
+        }
+    }
+
+    // --- Capture (Chrome Trace Event JSON) ---
+
+    static void captureZone(U32 threadId, U64 ticks, const char* name, const PerfCounterSample* delta = nullptr)
+    {
+        ProfileCapture& capture = gProfiler.capture;
+        if (capture.zoneCount >= g_capture_max_zone_events)
+        {
+            capture.full = true;
+            return;
+        }
+
+        U32 counterIndex = g_no_node;
+        if (delta && capture.counters && capture.counterCount < g_capture_max_counter_events)
+        {
+            counterIndex = capture.counterCount++;
+            capture.counters[counterIndex] = *delta;
+        }
+        capture.zones[capture.zoneCount++] = CaptureZoneEvent{ ticks, name, threadId, counterIndex };
+    }
+
+    static void rememberThreadName(const ProfileThreadData* data)
+    {
+        ProfileCapture& capture = gProfiler.capture;
+        for (U32 i = 0; i < capture.threadNameCount; ++i)
+        {
+            if (capture.threadNames[i].threadId == data->threadId)
+            {
+                memcpy(capture.threadNames[i].name, data->name, sizeof(data->name));
+                return;
+            }
+        }
+        if (capture.threadNameCount >= g_profiler_max_threads * 2) return;
+
+        CaptureThreadName& entry = capture.threadNames[capture.threadNameCount++];
+        entry.threadId = data->threadId;
+        memcpy(entry.name, data->name, sizeof(data->name));
+    }
+
+    static void writeJsonString(FILE* out, const char* text, U32 length)
+    {
+        fputc('"', out);
+        for (U32 i = 0; i < length && text[i]; ++i)
+        {
+            const unsigned char c = (unsigned char)text[i];
+            if (c == '"' || c == '\\')
+            {
+                fputc('\\', out);
+                fputc(c, out);
+            }
+            else if (c < 0x20)
+            {
+                fprintf(out, "\\u%04x", c);
+            }
+            else
+            {
+                fputc(c, out);
+            }
+        }
+        fputc('"', out);
+    }
+
+    static const char* g_allocation_event_names[] = { "alloc", "free", "realloc" };
+
+    // Frame qui contient ce timestamp (la dernière commencée avant lui)
+    static U32 findCaptureFrame(U64 ns)
+    {
+        const ProfileCapture& capture = gProfiler.capture;
+        U32 low = 0;
+        U32 high = capture.frameCount;
+        while (high - low > 1)
+        {
+            const U32 middle = (low + high) / 2;
+            if (capture.frames[middle].startNs <= ns) low = middle;
+            else high = middle;
+        }
+        return low;
+    }
+
+    static bool writeCapture(U32 droppedLogs)
+    {
+        ProfileCapture& capture = gProfiler.capture;
+        FILE* out = fopen(capture.path, "wt");
+        if (!out) return false;
+
+        // Origine des temps : premier événement (les zones déjà ouvertes au
+        // démarrage de la capture commencent avant la première frame)
+        U64 originNs = capture.frameCount > 0 ? capture.frames[0].startNs : 0;
+        for (U32 i = 0; i < capture.zoneCount; ++i)
+        {
+            const U64 ns = Time::ticksToTimestampNs(capture.zones[i].ticks);
+            if (ns < originNs) originNs = ns;
+        }
+
+        const U32 allocationTotal = capture.allocationCount.load(std::memory_order_relaxed);
+        const U32 allocationCount = allocationTotal < g_capture_max_allocations ? allocationTotal : g_capture_max_allocations;
+        for (U32 i = 0; i < allocationCount && capture.frameCount > 0; ++i)
+        {
+            const CaptureAllocEvent& event = capture.allocations[i];
+            CaptureFrame& frame = capture.frames[findCaptureFrame(Time::ticksToTimestampNs(event.startTicks))];
+            frame.allocationCalls++;
+            if (event.type != eALLOCATION_FREE) frame.allocatedBytes += event.size;
+        }
+
+        fprintf(out, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"frames\":%u,\"zoneEvents\":%u,\"droppedLogs\":%u,\"allocationEvents\":%u,\"droppedAllocations\":%u,\"truncated\":%s},\n\"traceEvents\":[\n",
+                capture.frameCount, capture.zoneCount, droppedLogs, allocationCount, allocationTotal - allocationCount,
+                capture.full ? "true" : "false");
+
+        fprintf(out, "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"thread_name\",\"args\":{\"name\":\"Frames\"}}");
+        for (U32 i = 0; i < capture.threadNameCount; ++i)
+        {
+            const CaptureThreadName& entry = capture.threadNames[i];
+            fprintf(out, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", entry.threadId);
+            writeJsonString(out, entry.name, sizeof(entry.name));
+            fputs("}}", out);
+        }
+
+        // Frames sur une piste à part (tid 0) : ne s'imbriquent pas avec les zones
+        for (U32 i = 0; i < capture.frameCount; ++i)
+        {
+            const CaptureFrame& frame = capture.frames[i];
+            fprintf(out, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f,\"name\":\"Frame %llu\"}",
+                    (F64)(frame.startNs - originNs) / 1000.0, (F64)frame.durationNs / 1000.0,
+                    (unsigned long long)frame.frameIndex);
+            if (capture.allocations)
+            {
+                fprintf(out, ",\n{\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"name\":\"Allocations\",\"args\":{\"calls\":%u,\"bytes\":%llu}}",
+                        (F64)(frame.startNs - originNs) / 1000.0, frame.allocationCalls, (unsigned long long)frame.allocatedBytes);
+            }
+        }
+
+        for (U32 i = 0; i < capture.zoneCount; ++i)
+        {
+            const CaptureZoneEvent& event = capture.zones[i];
+            const F64 ts = (F64)(Time::ticksToTimestampNs(event.ticks) - originNs) / 1000.0;
+            if (event.name)
+            {
+                fprintf(out, ",\n{\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":", event.threadId, ts);
+                writeJsonString(out, event.name, 0xFFFFFFFF);
+                fputc('}', out);
+            }
+            else if (event.counterIndex == g_no_node)
+            {
+                fprintf(out, ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", event.threadId, ts);
+            }
+            else
+            {
+                // Les args de la fin s'ajoutent à ceux de la zone dans les visualiseurs
+                const PerfCounterSample& counters = capture.counters[event.counterIndex];
+                fprintf(out, ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{", event.threadId, ts);
+                for (U32 c = 0; c < ePERF_COUNTER_COUNT; ++c)
+                {
+                    fprintf(out, "\"%s\":%llu,", PerfCounterGroup::getName((PerfCounter)c), (unsigned long long)counters.values[c]);
+                }
+                const U64 cycles = counters.values[ePERF_CYCLES];
+                fprintf(out, "\"ipc\":%.3f}}", cycles ? (F64)counters.values[ePERF_INSTRUCTIONS] / (F64)cycles : 0.0);
+            }
+        }
+
+        const U32 logCount = capture.logCount.load(std::memory_order_relaxed) < g_capture_max_logs
+                           ? capture.logCount.load(std::memory_order_relaxed) : g_capture_max_logs;
+        for (U32 i = 0; i < logCount; ++i)
+        {
+            const CaptureLogEvent& event = capture.logs[i];
+            const F64 ts = event.timestampNs > originNs ? (F64)(event.timestampNs - originNs) / 1000.0 : 0.0;
+            fprintf(out, ",\n{\"ph\":\"i\",\"s\":\"t\",\"cat\":\"log\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":", event.threadId, ts);
+            writeJsonString(out, event.tag ? event.tag : "LOG", 0xFFFFFFFF);
+            fprintf(out, ",\"args\":{\"level\":\"%s\",\"text\":", Log::getLevelName((LogLevel)event.level));
+            writeJsonString(out, event.text, event.length);
+            fputs("}}", out);
+        }
+
+        // Tranches courtes sur la piste du thread : elles s'affichent sous la zone qui alloue
+        for (U32 i = 0; i < allocationCount; ++i)
+        {
+            const CaptureAllocEvent& event = capture.allocations[i];
+            const U64 ns = Time::ticksToTimestampNs(event.startTicks);
+            const char* group = Allocator::getGroupName(event.groupId);
+            fprintf(out, ",\n{\"ph\":\"X\",\"cat\":\"alloc\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":\"%s\",\"args\":{\"size\":%llu,\"group\":",
+                    event.threadId, ns > originNs ? (F64)(ns - originNs) / 1000.0 : 0.0, (F64)Time::toNs(event.durationTicks) / 1000.0,
+                    g_allocation_event_names[event.type], (unsigned long long)event.size);
+            writeJsonString(out, group ? group : "?", 0xFFFFFFFF);
+            fprintf(out, ",\"ptr\":\"%p\",\"lockWaitUs\":%.3f}}", event.ptr, (F64)Time::toNs(event.lockWaitTicks) / 1000.0);
+        }
+
+        fputs("\n]}\n", out);
+        const bool ok = ferror(out) == 0;
+        fclose(out);
+        return ok;
+    }
+
+    static void onAllocationEvent(const AllocationEvent& event, void*)
+    {
+        ProfileCapture& capture = gProfiler.capture;
+
+        capture.allocationWriters.fetch_add(1, std::memory_order_seq_cst);
+        if (Profiler::s_capturing.load(std::memory_order_seq_cst))
+        {
+            const U32 index = capture.allocationCount.fetch_add(1, std::memory_order_relaxed);
+            if (index < g_capture_max_allocations)
+            {
+                CaptureAllocEvent& entry = capture.allocations[index];
+                entry.startTicks = event.startTicks;
+                entry.durationTicks = event.durationTicks;
+                entry.lockWaitTicks = event.lockWaitTicks;
+                entry.size = event.size;
+                entry.ptr = event.ptr;
+                entry.threadId = Thread::getCurrentId();
+                entry.groupId = event.groupId;
+                entry.type = event.type;
+            }
+        }
+        capture.allocationWriters.fetch_sub(1, std::memory_order_release);
+    }
+
+    static void releaseCapture()
+    {
+        ProfileCapture& capture = gProfiler.capture;
+        Allocator::free(capture.zones);
+        Allocator::free(capture.frames);
+        Allocator::free(capture.logs);
+        Allocator::free(capture.counters);
+        Allocator::free(capture.allocations);
+        capture.zones = nullptr;
+        capture.frames = nullptr;
+        capture.logs = nullptr;
+        capture.counters = nullptr;
+        capture.allocations = nullptr;
+        capture.active = false;
+    }
+
+    // Sous registryMutex, à la fin d'un endFrame : la capture commence à la frame suivante
+    static void beginCapture(U32 frameCount, const char* path)
+    {
+        ProfileCapture& capture = gProfiler.capture;
+
+        const U64 zonesSize = sizeof(CaptureZoneEvent) * (U64)g_capture_max_zone_events;
+        const U64 logsSize = sizeof(CaptureLogEvent) * (U64)g_capture_max_logs;
+        const U64 framesSize = sizeof(CaptureFrame) * (U64)g_capture_max_frames;
+        const U64 countersSize = sizeof(PerfCounterSample) * (U64)g_capture_max_counter_events;
+        const U64 allocationsSize = sizeof(CaptureAllocEvent) * (U64)g_capture_max_allocations;
+        if (capture.groupId == 0xFFFF)
+        {
+            capture.groupId = Allocator::findGroupId("ProfilerCapture");
+            if (capture.groupId == 0xFFFF)
+            {
+                AllocationGroupInfo info = { "ProfilerCapture", zonesSize + logsSize + framesSize + countersSize + allocationsSize + 64 * 1024 };
+                capture.groupId = Allocator::addGroup(info);
+            }
+        }
+
+        if (capture.groupId != 0xFFFF)
+        {
+            capture.zones = (CaptureZoneEvent*)Allocator::alloc(zonesSize, 16, capture.groupId, __FILE__, __LINE__);
+            capture.logs = (CaptureLogEvent*)Allocator::alloc(logsSize, 16, capture.groupId, __FILE__, __LINE__);
+            capture.frames = (CaptureFrame*)Allocator::alloc(framesSize, 16, capture.groupId, __FILE__, __LINE__);
+            if (gProfiler.hardwareCounters.load(std::memory_order_relaxed))
+            {
+                capture.counters = (PerfCounterSample*)Allocator::alloc(countersSize, 16, capture.groupId, __FILE__, __LINE__);
+            }
+            if (capture.allocationsEnabled)
+            {
+                capture.allocations = (CaptureAllocEvent*)Allocator::alloc(allocationsSize, 16, capture.groupId, __FILE__, __LINE__);
+            }
+        }
+        if (!capture.zones || !capture.logs || !capture.frames)
+        {
+            releaseCapture();
+            INGA_LOG(eERROR, "PROFILER", "Unable to allocate the capture buffers.");
+            return;
+        }
+
+        if (path && path[0])
+        {
+            snprintf(capture.path, sizeof(capture.path), "%s", path);
+        }
+        else
+        {
+            time_t now = time(nullptr);
+            struct tm* ts = localtime(&now);
+            char timeBuf[64];
+            strftime(timeBuf, sizeof(timeBuf), "%Y_%m_%d_%H_%M_%S", ts);
+            snprintf(capture.path, sizeof(capture.path), "inga_capture_%s.json", timeBuf);
+        }
+
+        capture.active = true;
+        capture.full = false;
+        capture.framesLeft = frameCount;
+        capture.frameCount = 0;
+        capture.zoneCount = 0;
+        capture.counterCount = 0;
+        capture.threadNameCount = 0;
+        capture.logCount.store(0, std::memory_order_relaxed);
+        capture.allocationCount.store(0, std::memory_order_relaxed);
+
+        // Les zones déjà ouvertes reçoivent leur début pour rester appariées
+        for (U32 i = 0; i < gProfiler.threadCount; ++i)
+        {
+            ProfileThreadData* data = gProfiler.threads[i];
+            const U32 depth = data->depth < g_profiler_max_depth ? data->depth : g_profiler_max_depth;
+            for (U32 d = 0; d < depth; ++d)
+            {
+                captureZone(data->threadId, data->stack[d].startTicks, data->stack[d].name);
+            }
+        }
+
+        Profiler::s_capturing.store(true, std::memory_order_seq_cst);
+        if (capture.allocations) Allocator::setEventHook(onAllocationEvent);
+    }
+
+    // Sous registryMutex : ferme les zones ouvertes, écrit le fichier, libère les buffers
+    static void finishCapture(U64 endTicks)
+    {
+        ProfileCapture& capture = gProfiler.capture;
+
+        Profiler::s_capturing.store(false, std::memory_order_seq_cst);
+        if (capture.allocations) Allocator::setEventHook(nullptr);
+        while (capture.logWriters.load(std::memory_order_seq_cst) != 0) Thread::spinPause();
+        while (capture.allocationWriters.load(std::memory_order_seq_cst) != 0) Thread::spinPause();
+
+        for (U32 i = 0; i < gProfiler.threadCount; ++i)
+        {
+            ProfileThreadData* data = gProfiler.threads[i];
+            rememberThreadName(data);
+            if (capture.full) continue;
+
+            const U32 depth = data->depth < g_profiler_max_depth ? data->depth : g_profiler_max_depth;
+            for (U32 d = 0; d < depth; ++d) captureZone(data->threadId, endTicks, nullptr);
+        }
+
+        const U32 logCount = capture.logCount.load(std::memory_order_relaxed);
+        const U32 droppedLogs = logCount > g_capture_max_logs ? logCount - g_capture_max_logs : 0;
+
+        if (writeCapture(droppedLogs))
+        {
+            INGA_LOG(eINFO, "PROFILER", "Capture written to %s (%u frames, %u zone events, %u allocations%s).",
+                     capture.path, capture.frameCount, capture.zoneCount,
+                     capture.allocations ? capture.allocationCount.load(std::memory_order_relaxed) : 0,
+                     capture.full ? ", buffer full" : "");
+        }
+        else
+        {
+            INGA_LOG(eERROR, "PROFILER", "Unable to write the capture file %s.", capture.path);
+        }
+        releaseCapture();
+    }
+
+    B8 Profiler::requestCapture(U32 frameCount, const char* path)
+    {
+        std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+        if (!gProfiler.started || gProfiler.capture.active) return INGA_FALSE;
+
+        ProfileCapture& capture = gProfiler.capture;
+        capture.pendingFrames = frameCount == 0 ? 1 : (frameCount > g_capture_max_frames ? g_capture_max_frames : frameCount);
+        snprintf(capture.pendingPath, sizeof(capture.pendingPath), "%s", path ? path : "");
+        return INGA_TRUE;
+    }
+
+    void Profiler::setCaptureAllocations(bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+        gProfiler.capture.allocationsEnabled = enabled;
+    }
+
+#if !defined(INGA_PLATFORM_WINDOWS)
+    static void onCaptureSignal(int)
+    {
+        // Seule opération faite dans le handler : un store atomique lock-free
+        gProfiler.capture.signalRequested.store(true, std::memory_order_relaxed);
+    }
+#endif
+
+    B8 Profiler::installCaptureSignal(U32 frameCount)
+    {
+#if defined(INGA_PLATFORM_WINDOWS)
+        (void)frameCount;
+        return INGA_FALSE;
+#else
+        {
+            std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+            gProfiler.capture.signalFrames = frameCount;
+        }
+
+        struct sigaction action = {};
+        action.sa_handler = onCaptureSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        return sigaction(SIGUSR1, &action, nullptr) == 0 ? INGA_TRUE : INGA_FALSE;
+#endif
+    }
+
+    void Profiler::captureLog(U8 level, const char* tag, const char* text, U32 length)
+    {
+        ProfileCapture& capture = gProfiler.capture;
+
+        // logWriters est pris avant de relire le flag : finishCapture attend qu'il retombe à 0
+        capture.logWriters.fetch_add(1, std::memory_order_seq_cst);
+        if (s_capturing.load(std::memory_order_seq_cst))
+        {
+            const U32 index = capture.logCount.fetch_add(1, std::memory_order_relaxed);
+            if (index < g_capture_max_logs)
+            {
+                CaptureLogEvent& event = capture.logs[index];
+                event.timestampNs = Log::getTimestampNs();
+                event.tag = tag;
+                event.threadId = Thread::getCurrentId();
+                event.level = level;
+                event.length = (U16)(length < g_capture_text_size ? length : g_capture_text_size);
+                memcpy(event.text, text, event.length);
+            }
+        }
+        capture.logWriters.fetch_sub(1, std::memory_order_release);
+    }
+
+    void Profiler::endFrame()
+    {
+        if (!gProfiler.started) return;
+
+        Time::recalibrate();
+        const U64 frameEndTicks = Time::now();
+        const U64 frameEndNs = Time::ticksToTimestampNs(frameEndTicks);
+
+        ProfileTree& tree = gProfiler.trees[gProfiler.building];
+        ProfileCapture& capture = gProfiler.capture;
+        U32 dropped = 0;
+
+        std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+        for (U32 i = 0; i < gProfiler.threadCount; )
+        {
+            ProfileThreadData* data = gProfiler.threads[i];
+            const bool dead = data->dead.load(std::memory_order_acquire);
+
+            // Seuls les événements antérieurs à la fin de frame y sont comptés
+            for (ProfileEvent* event = data->ring.front(); event && event->ticks <= frameEndTicks; event = data->ring.front())
+            {
+                ProfileEvent copy = {};
+                data->ring.pop(copy);
+
+                // L'échantillon est poussé avant l'événement : toujours présent ici
+                PerfCounterSample sample;
+                PerfCounterSample delta;
+                const bool hasSample = data->hasCounters && data->counterRing.pop(sample);
+                const bool hasDelta = processEvent(tree, data, copy, hasSample ? &sample : nullptr, &delta);
+                if (capture.active) captureZone(data->threadId, copy.ticks, copy.name, hasDelta ? &delta : nullptr);
+            }
+            dropped += data->dropped.exchange(0, std::memory_order_relaxed);
+
+            if (dead && data->ring.empty())
+            {
+                if (capture.active) rememberThreadName(data);
+                destroyThread(data);
+                gProfiler.threads[i] = gProfiler.threads[--gProfiler.threadCount];
+                continue;
+            }
+            ++i;
+        }
+
+        // Publication : ticks -> ns
+        for (U32 i = 0; i < tree.count; ++i)
+        {
+            ProfileNode& node = tree.nodes[i];
+            node.inclusiveNs = Time::toNs(node.inclusiveNs);
+            node.exclusiveNs = Time::toNs(node.exclusiveNs);
+        }
+
+        ProfileFrame& frame = gProfiler.lastFrame;
+        frame.frameIndex = gProfiler.frameIndex++;
+        frame.startNs = gProfiler.frameStartNs;
+        frame.durationNs = frameEndNs - gProfiler.frameStartNs;
+        frame.nodeCount = tree.count;
+        frame.nodes = tree.nodes;
+        frame.droppedEvents = dropped + gProfiler.droppedNodes;
+
+        // Nouvel arbre pour la frame suivante
+        gProfiler.building ^= 1;
+        ProfileTree& next = gProfiler.trees[gProfiler.building];
+        next.count = 0;
+        gProfiler.droppedNodes = 0;
+        for (U32 i = 0; i < gProfiler.threadCount; ++i)
+        {
+            reparentOpenZones(next, gProfiler.threads[i]);
+        }
+
+        // Capture : la frame est enregistrée, puis écriture au bout de N frames
+        if (capture.active)
+        {
+            capture.frames[capture.frameCount++] = CaptureFrame{ frame.frameIndex, frame.startNs, frame.durationNs, 0, 0 };
+            if (--capture.framesLeft == 0 || capture.full) finishCapture(frameEndTicks);
+        }
+        else
+        {
+            if (capture.signalRequested.exchange(false, std::memory_order_relaxed) && capture.pendingFrames == 0)
+            {
+                capture.pendingFrames = capture.signalFrames;
+                capture.pendingPath[0] = '\0';
+            }
+            if (capture.pendingFrames > 0)
+            {
+                beginCapture(capture.pendingFrames, capture.pendingPath);
+                capture.pendingFrames = 0;
+            }
+        }
+
+        gProfiler.frameStartTicks = frameEndTicks;
+        gProfiler.frameStartNs = frameEndNs;
+    }
+
+    const ProfileFrame& Profiler::getLastFrame()
+    {
+        return gProfiler.lastFrame;
+    }
+
+    U64 Profiler::getZoneTime(const char* name, U32* calls)
+    {
+        const ProfileFrame& frame = gProfiler.lastFrame;
+        U64 total = 0;
+        U32 totalCalls = 0;
+        for (U32 i = 0; i < frame.nodeCount; ++i)
+        {
+            const ProfileNode& node = frame.nodes[i];
+            if (node.depth > 0 && (node.name == name || strcmp(node.name, name) == 0))
+            {
+                total += node.inclusiveNs;
+                totalCalls += node.calls;
+            }
+        }
+        if (calls) *calls = totalCalls;
+        return total;
+    }
+
+    bool Profiler::getZoneCounters(const char* name, PerfCounterSample& counters)
+    {
+        const ProfileFrame& frame = gProfiler.lastFrame;
+        memset(&counters, 0, sizeof(counters));
+        bool found = false;
+        for (U32 i = 0; i < frame.nodeCount; ++i)
+        {
+            const ProfileNode& node = frame.nodes[i];
+            if (node.depth > 0 && (node.name == name || strcmp(node.name, name) == 0))
+            {
+                for (U32 c = 0; c < ePERF_COUNTER_COUNT; ++c) counters.values[c] += node.counters[c];
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    void Profiler::setHardwareCounters(bool enabled)
+    {
+        gProfiler.hardwareCounters.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::hasHardwareCounters()
+    {
+        return gProfiler.hardwareCounters.load(std::memory_order_relaxed);
+    }
+
+    static void logNode(const ProfileFrame& frame, U32 index, U32 maxDepth)
+    {
+        const ProfileNode& node = frame.nodes[index];
+        if (node.depth > maxDepth) return;
+
+        const F64 ms = (F64)node.inclusiveNs * 1e-6;
+        const U64 cycles = node.counters[ePERF_CYCLES];
+        if (cycles > 0)
+        {
+            INGA_LOG(eINFO, "PROFILER", "%*s%s: %.3f ms (%u calls) | IPC %.2f | L1D %llu | LLC %llu | branch %llu",
+                     (int)node.depth * 2, "", node.name, ms, node.calls,
+                     (F64)node.counters[ePERF_INSTRUCTIONS] / (F64)cycles,
+                     (unsigned long long)node.counters[ePERF_L1D_MISSES],
+                     (unsigned long long)node.counters[ePERF_LLC_MISSES],
+                     (unsigned long long)node.counters[ePERF_BRANCH_MISSES]);
+        }
+        else
+        {
+            INGA_LOG(eINFO, "PROFILER", "%*s%s: %.3f ms (%u calls)", (int)node.depth * 2, "", node.name, ms, node.calls);
+        }
+
+        for (U32 child = node.firstChild; child != g_no_node; child = frame.nodes[child].nextSibling)
+        {
+            logNode(frame, child, maxDepth);
+        }
+    }
+
+    void Profiler::logLastFrame(U32 maxDepth)
+    {
+        const ProfileFrame& frame = gProfiler.lastFrame;
+        INGA_LOG(eINFO, "PROFILER", "Frame %llu: %.3f ms", (unsigned long long)frame.frameIndex, (F64)frame.durationNs * 1e-6);
+
+        // Racines : un noeud de profondeur 0 par thread
+        for (U32 i = 0; i < frame.nodeCount; ++i)
+        {
+            if (frame.nodes[i].depth == 0) logNode(frame, i, maxDepth);
+        }
+    }
+
+    // --- Cycle de vie ---
+
+    static B8 startLocked(U32 eventsPerThread, U32 maxNodesPerFrame)
+    {
+        std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+        if (gProfiler.started) return INGA_TRUE;
+
+        gProfiler.eventsPerThread = eventsPerThread > 0 ? eventsPerThread : 64 * 1024;
+        gProfiler.maxNodes = maxNodesPerFrame > 0 ? maxNodesPerFrame : 4096;
+
+        const U64 perThread = sizeof(ProfileThreadData) + sizeof(ProfileEvent) * (U64)queueRoundCapacity(gProfiler.eventsPerThread) + 256;
+        const U64 groupSize = perThread * 16 + sizeof(ProfileNode) * (U64)gProfiler.maxNodes * 2 + 64 * 1024;
+        gProfiler.groupId = Allocator::findGroupId("Profiler");
+        if (gProfiler.groupId == 0xFFFF)
+        {
+            AllocationGroupInfo info = { "Profiler", groupSize };
+            gProfiler.groupId = Allocator::addGroup(info);
+        }
+        if (gProfiler.groupId == 0xFFFF)
+        {
+            INGA_LOG(eERROR, "PROFILER", "Unable to create the 'Profiler' memory group.");
+            return INGA_FALSE;
+        }
+
+        for (ProfileTree& tree : gProfiler.trees)
+        {
+            tree.nodes = (ProfileNode*)Allocator::alloc(sizeof(ProfileNode) * (U64)gProfiler.maxNodes, 16, gProfiler.groupId, __FILE__, __LINE__);
+            tree.count = 0;
+            if (!tree.nodes)
+            {
+                INGA_LOG(eERROR, "PROFILER", "Unable to allocate %u profiler nodes.", gProfiler.maxNodes);
+                return INGA_FALSE;
+            }
+        }
+
+        gProfiler.building = 0;
+        gProfiler.lastFrame = {};
+        gProfiler.lastFrame.nodes = gProfiler.trees[1].nodes;
+        gProfiler.frameIndex = 0;
+        gProfiler.droppedNodes = 0;
+        gProfiler.frameStartTicks = Time::now();
+        gProfiler.frameStartNs = Time::ticksToTimestampNs(gProfiler.frameStartTicks);
+
+        gProfiler.started = true;
+        Profiler::s_enabled.store(true, std::memory_order_relaxed);
+        return INGA_TRUE;
+    }
+
+    B8 Profiler::start(U32 eventsPerThread, U32 maxNodesPerFrame)
+    {
+        if (!startLocked(eventsPerThread, maxNodesPerFrame)) return INGA_FALSE;
+
+        // start() est appelé depuis le thread principal (INGA_BEGIN)
+        setThreadName("Main");
+        return INGA_TRUE;
+    }
+
+    void Profiler::stop()
+    {
+        s_enabled.store(false, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(gProfiler.registryMutex);
+        if (!gProfiler.started) return;
+
+        // Capture interrompue : on écrit ce qui a été enregistré
+        if (gProfiler.capture.active) finishCapture(Time::now());
+        gProfiler.capture.pendingFrames = 0;
+
+        // Les threads encore vivants réenregistreront un buffer si on redémarre.
+        // Ceux qui ont relu l'ancienne génération finissent leur push avant qu'on libère.
+        gProfiler.generation.fetch_add(1, std::memory_order_seq_cst);
+        for (U32 i = 0; i < gProfiler.threadCount; ++i)
+        {
+            const std::atomic<bool>* busy = gProfiler.threads[i]->busy;
+            while (busy && busy->load(std::memory_order_seq_cst)) Thread::yield();
+        }
+        for (U32 i = 0; i < gProfiler.threadCount; ++i)
+        {
+            destroyThread(gProfiler.threads[i]);
+            gProfiler.threads[i] = nullptr;
+        }
+        gProfiler.threadCount = 0;
+
+        for (ProfileTree& tree : gProfiler.trees)
+        {
+            Allocator::free(tree.nodes);
+            tree.nodes = nullptr;
+            tree.count = 0;
+        }
+        gProfiler.lastFrame = {};
+        gProfiler.started = false;
+    }
+
+    void Profiler::setEnabled(bool enabled)
+    {
+        s_enabled.store(enabled && gProfiler.started, std::memory_order_relaxed);
+    }
+}
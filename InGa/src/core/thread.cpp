@@ -0,0 +1,59 @@
+#include <InGa/core/thread.h>
+#include <atomic>
+#include <thread>
+
+#if defined(INGA_PLATFORM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace Inga
+{
+    static std::atomic<U32> g_next_thread_id{1};
+    static thread_local U32 t_thread_id = 0;
+
+    U32 Thread::getCurrentId()
+    {
+        if (t_thread_id == 0)
+        {
+            t_thread_id = g_next_thread_id.fetch_add(1, std::memory_order_relaxed);
+        }
+        return t_thread_id;
+    }
+
+    void Thread::setCurrentName(const char* name)
+    {
+#if defined(INGA_PLATFORM_WINDOWS)
+        wchar_t wide[64];
+        size_t i = 0;
+        for (; name[i] && i < 63; ++i) wide[i] = (wchar_t)name[i];
+        wide[i] = 0;
+        SetThreadDescription(GetCurrentThread(), wide);
+#elif defined(INGA_PLATFORM_LINUX)
+        char shortName[16];
+        snprintf(shortName, sizeof(shortName), "%s", name);
+        pthread_setname_np(pthread_self(), shortName);
+#elif defined(INGA_PLATFORM_MACOS)
+        pthread_setname_np(name);
+#else
+        (void)name;
+#endif
+    }
+
+    U32 Thread::getHardwareThreadCount()
+    {
+        U32 count = std::thread::hardware_concurrency();
+        return count > 0 ? count : 1;
+    }
+
+    void Thread::yield()
+    {
+#if defined(INGA_PLATFORM_WINDOWS)
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+}
@@ -0,0 +1,231 @@
+#include <InGa/core/time.h>
+#include <InGa/core/thread.h>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <cpuid.h>
+#endif
+
+#if !defined(INGA_PLATFORM_WINDOWS)
+    #include <time.h>
+#endif
+
+namespace Inga
+{
+    // Fenêtre de la première calibration, puis période des recalibrations
+    static const U64 g_time_initial_window_ns = 5000000;
+    static const U64 g_time_recalibration_period_ns = 1000000000;
+
+    // Correction de dérive max appliquée à la pente (0.1 %) : l'horloge ne recule jamais
+    static const F64 g_time_max_slew = 0.001;
+
+    std::atomic<Time::Source> Time::s_source{Time::eSOURCE_NONE};
+
+    // Conversion ticks -> ns : baseNs + (ticks - baseTicks) * nsPerTick
+    struct TimeCalibration
+    {
+        U64 baseTicks;
+        U64 baseNs;
+        F64 nsPerTick;
+    };
+
+    /*
+     * Double buffer : recalibrate() écrit le slot inactif puis le publie.
+     * Un slot n'est réécrit qu'une seconde plus tard, bien après que les
+     * lecteurs l'ont quitté.
+     */
+    struct TimeInternal
+    {
+        std::mutex mutex;
+        TimeCalibration slots[2] = {};
+        std::atomic<U32> current{0};
+        std::atomic<U64> nextCalibrationTicks{0};
+
+        // Origine de la mesure de fréquence : la fenêtre grandit à chaque recalibration
+        U64 referenceTicks = 0;
+        U64 referenceNs = 0;
+    } gTime;
+
+    U64 Time::monotonicNs()
+    {
+#if defined(INGA_PLATFORM_WINDOWS)
+        return (U64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (U64)ts.tv_sec * 1000000000ull + (U64)ts.tv_nsec;
+#endif
+    }
+
+    static inline U64 readTsc()
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    // TSC invariant (CPUID 0x80000007, EDX bit 8) et, sous Linux, retenu par le noyau
+    static bool detectInvariantTsc()
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int regs[4] = {};
+        __cpuid(regs, (int)0x80000000);
+        if ((unsigned)regs[0] < 0x80000007u) return false;
+        __cpuid(regs, (int)0x80000007);
+        return (regs[3] & (1 << 8)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u) return false;
+        __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+        if (!(edx & (1u << 8))) return false;
+
+    #if defined(INGA_PLATFORM_LINUX)
+        // Le noyau déclasse le TSC quand il le juge instable (multi-socket, certaines VM)
+        FILE* file = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+        if (file)
+        {
+            char name[32] = {};
+            const bool read = fgets(name, sizeof(name), file) != nullptr;
+            fclose(file);
+            if (read && strncmp(name, "tsc", 3) != 0) return false;
+        }
+    #endif
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Paire (TSC, horloge OS) : on garde la lecture la plus serrée sur quelques essais
+    static void sampleReference(U64& ticks, U64& ns)
+    {
+        U64 best = ~0ull;
+        for (U32 i = 0; i < 5; ++i)
+        {
+            const U64 before = readTsc();
+            const U64 osNs = Time::monotonicNs();
+            const U64 after = readTsc();
+            if (after - before < best)
+            {
+                best = after - before;
+                ticks = before + (after - before) / 2;
+                ns = osNs;
+            }
+        }
+    }
+
+    static void publish(U64 baseTicks, U64 baseNs, F64 nsPerTick)
+    {
+        const U32 next = gTime.current.load(std::memory_order_relaxed) ^ 1;
+        gTime.slots[next] = TimeCalibration{ baseTicks, baseNs, nsPerTick };
+        gTime.current.store(next, std::memory_order_release);
+        gTime.nextCalibrationTicks.store(baseTicks + (U64)((F64)g_time_recalibration_period_ns / nsPerTick),
+                                         std::memory_order_relaxed);
+    }
+
+    static inline const TimeCalibration& calibration()
+    {
+        if (Time::getSource() == Time::eSOURCE_NONE) Time::init();
+        return gTime.slots[gTime.current.load(std::memory_order_acquire)];
+    }
+
+    void Time::init()
+    {
+        std::lock_guard<std::mutex> lock(gTime.mutex);
+        if (s_source.load(std::memory_order_relaxed) != eSOURCE_NONE) return;
+
+        if (detectInvariantTsc())
+        {
+            U64 ticks0 = 0, ns0 = 0, ticks1 = 0, ns1 = 0;
+            sampleReference(ticks0, ns0);
+            while (monotonicNs() - ns0 < g_time_initial_window_ns) Thread::spinPause();
+            sampleReference(ticks1, ns1);
+
+            // Garde-fou : une fréquence hors de [100 MHz, 10 GHz] trahit un TSC inutilisable
+            const F64 nsPerTick = ticks1 > ticks0 ? (F64)(ns1 - ns0) / (F64)(ticks1 - ticks0) : 0.0;
+            if (nsPerTick > 0.1 && nsPerTick < 10.0)
+            {
+                gTime.referenceTicks = ticks0;
+                gTime.referenceNs = ns0;
+                publish(ticks1, ns1, nsPerTick);
+                s_source.store(eSOURCE_TSC, std::memory_order_release);
+                return;
+            }
+        }
+
+        // Repli : les ticks sont directement les ns de l'horloge monotone
+        publish(0, 0, 1.0);
+        gTime.nextCalibrationTicks.store(~0ull, std::memory_order_relaxed);
+        s_source.store(eSOURCE_MONOTONIC, std::memory_order_release);
+    }
+
+    U64 Time::nowFallback()
+    {
+        Source source = s_source.load(std::memory_order_acquire);
+        if (source == eSOURCE_NONE)
+        {
+            init();
+            source = s_source.load(std::memory_order_acquire);
+        }
+        return source == eSOURCE_TSC ? readTsc() : monotonicNs();
+    }
+
+    U64 Time::ticksToTimestampNs(U64 ticks)
+    {
+        const TimeCalibration& c = calibration();
+        return c.baseNs + (U64)((F64)(I64)(ticks - c.baseTicks) * c.nsPerTick);
+    }
+
+    F64 Time::nsPerTick()
+    {
+        return calibration().nsPerTick;
+    }
+
+    /*
+     * Nouvelle pente mesurée depuis la référence d'init (fenêtre de plus en
+     * plus longue, donc de plus en plus précise). La conversion repart de la
+     * valeur actuelle pour rester continue ; l'écart avec l'horloge de l'OS
+     * est rattrapé progressivement sur la période suivante.
+     */
+    void Time::recalibrate()
+    {
+        if (s_source.load(std::memory_order_acquire) != eSOURCE_TSC) return;
+        if (readTsc() < gTime.nextCalibrationTicks.load(std::memory_order_relaxed)) return;
+
+        std::unique_lock<std::mutex> lock(gTime.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) return;
+
+        U64 ticks = 0, ns = 0;
+        sampleReference(ticks, ns);
+        if (ticks <= gTime.referenceTicks) return;
+
+        const F64 nsPerTick = (F64)(ns - gTime.referenceNs) / (F64)(ticks - gTime.referenceTicks);
+        const U64 currentNs = ticksToTimestampNs(ticks);
+
+        const F64 periodTicks = (F64)g_time_recalibration_period_ns / nsPerTick;
+        F64 slew = (F64)((I64)ns - (I64)currentNs) / periodTicks;
+        if (slew > nsPerTick * g_time_max_slew) slew = nsPerTick * g_time_max_slew;
+        if (slew < -nsPerTick * g_time_max_slew) slew = -nsPerTick * g_time_max_slew;
+
+        publish(ticks, currentNs, nsPerTick + slew);
+    }
+
+    Time::Source Time::getSource()
+    {
+        return s_source.load(std::memory_order_acquire);
+    }
+
+    U64 Time::getFrequency()
+    {
+        return (U64)(1e9 / nsPerTick());
+    }
+}
@@ -0,0 +1,388 @@
+#include <InGa/gfx/BindlessTable.h>
+#include <InGa/gfx/RenderDevice.h>
+#include <InGa/core/log.h>
+
+namespace Inga
+{
+    static const char* s_typeNames[eBINDLESS_TYPE_COUNT] = { "textures", "samplers", "storage images", "buffers" };
+
+    static U32 minU32(U32 a, U32 b)
+    {
+        return a < b ? a : b;
+    }
+
+    CBindlessTable::~CBindlessTable()
+    {
+        if (m_device != VK_NULL_HANDLE) shutdown();
+    }
+
+    bool CBindlessTable::initialize(CRenderDevice* device, const SBindlessLimits& limits)
+    {
+        if (!device || device->getDevice() == VK_NULL_HANDLE) return false;
+
+        m_device = device->getDevice();
+        m_stats = SBindlessStats{};
+
+        // Limites UPDATE_AFTER_BIND : par set et par stage (tous les stages voient la table)
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProps = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES };
+        VkPhysicalDeviceProperties2 props2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+        props2.pNext = &indexingProps;
+        vkGetPhysicalDeviceProperties2(device->getPhysicalDevice(), &props2);
+
+        const U32 maxIndex = 1u << SBindlessHandle::INDEX_BITS;
+        U32 capacity[eBINDLESS_TYPE_COUNT];
+        capacity[eBINDLESS_TEXTURE] = minU32(limits.textures, minU32(indexingProps.maxDescriptorSetUpdateAfterBindSampledImages,
+                                                                     indexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages));
+        capacity[eBINDLESS_SAMPLER] = minU32(limits.samplers, minU32(indexingProps.maxDescriptorSetUpdateAfterBindSamplers,
+                                                                     indexingProps.maxPerStageDescriptorUpdateAfterBindSamplers));
+        capacity[eBINDLESS_STORAGE_IMAGE] = minU32(limits.storageImages, minU32(indexingProps.maxDescriptorSetUpdateAfterBindStorageImages,
+                                                                               indexingProps.maxPerStageDescriptorUpdateAfterBindStorageImages));
+        capacity[eBINDLESS_BUFFER] = minU32(limits.buffers, minU32(indexingProps.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                                                   indexingProps.maxPerStageDescriptorUpdateAfterBindStorageBuffers));
+
+        // Le total par stage est borné aussi : on réduit chaque tableau au prorata
+        U64 total = 0;
+        for (U32 t = 0; t < eBINDLESS_TYPE_COUNT; ++t) total += capacity[t];
+        const U64 maxResources = indexingProps.maxPerStageUpdateAfterBindResources;
+        for (U32 t = 0; t < eBINDLESS_TYPE_COUNT; ++t)
+        {
+            if (total > maxResources) capacity[t] = (U32)((U64)capacity[t] * maxResources / total);
+            capacity[t] = minU32(capacity[t], maxIndex);
+            if (capacity[t] == 0)
+            {
+                INGA_LOG(eERROR, "VULKAN", "Bindless table: no UPDATE_AFTER_BIND room for %s.", s_typeNames[t]);
+                shutdown();
+                return false;
+            }
+        }
+
+        static const VkDescriptorType descriptorTypes[eBINDLESS_TYPE_COUNT] =
+        {
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            VK_DESCRIPTOR_TYPE_SAMPLER,
+            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        };
+
+        VkDescriptorSetLayoutBinding bindings[eBINDLESS_TYPE_COUNT];
+        VkDescriptorBindingFlags bindingFlags[eBINDLESS_TYPE_COUNT];
+        VkDescriptorPoolSize poolSizes[eBINDLESS_TYPE_COUNT];
+        for (U32 t = 0; t < eBINDLESS_TYPE_COUNT; ++t)
+        {
+            SSlots& slots = m_slots[t];
+            slots.descriptorType = descriptorTypes[t];
+            slots.capacity = capacity[t];
+            slots.highWater = 0;
+            slots.used = 0;
+            slots.generations.assign(capacity[t], 1);
+            slots.freeSlots.clear();
+
+            bindings[t] = {};
+            bindings[t].binding = t;
+            bindings[t].descriptorType = descriptorTypes[t];
+            bindings[t].descriptorCount = capacity[t];
+            bindings[t].stageFlags = VK_SHADER_STAGE_ALL;
+
+            // Slots vides ou libérés jamais lus : PARTIALLY_BOUND ; écritures pendant qu'un cmd est en vol : UPDATE_AFTER_BIND
+            bindingFlags[t] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                              VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+                              VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+            poolSizes[t] = { descriptorTypes[t], capacity[t] };
+            m_stats.capacity[t] = capacity[t];
+        }
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO };
+        flagsInfo.bindingCount = eBINDLESS_TYPE_COUNT;
+        flagsInfo.pBindingFlags = bindingFlags;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+        layoutInfo.pNext = &flagsInfo;
+        layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = eBINDLESS_TYPE_COUNT;
+        layoutInfo.pBindings = bindings;
+        if (vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr, &m_setLayout) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Bindless table: failed to create descriptor set layout.");
+            shutdown();
+            return false;
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = eBINDLESS_TYPE_COUNT;
+        poolInfo.pPoolSizes = poolSizes;
+        if (vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_pool) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Bindless table: failed to create descriptor pool.");
+            shutdown();
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        allocInfo.descriptorPool = m_pool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &m_setLayout;
+        if (vkAllocateDescriptorSets(m_device, &allocInfo, &m_set) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Bindless table: failed to allocate descriptor set.");
+            shutdown();
+            return false;
+        }
+
+        VkPushConstantRange pushRange = { VK_SHADER_STAGE_ALL, 0, PUSH_CONSTANT_SIZE };
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &m_setLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+        if (vkCreatePipelineLayout(m_device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Bindless table: failed to create pipeline layout.");
+            shutdown();
+            return false;
+        }
+
+        INGA_LOG(eINFO, "VULKAN", "Bindless table ready: %u textures, %u samplers, %u storage images, %u buffers.",
+                 capacity[eBINDLESS_TEXTURE], capacity[eBINDLESS_SAMPLER], capacity[eBINDLESS_STORAGE_IMAGE], capacity[eBINDLESS_BUFFER]);
+        return true;
+    }
+
+    void CBindlessTable::shutdown()
+    {
+        if (m_device == VK_NULL_HANDLE) return;
+
+        // Le set part avec son pool
+        if (m_pipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+        if (m_pool != VK_NULL_HANDLE) vkDestroyDescriptorPool(m_device, m_pool, nullptr);
+        if (m_setLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(m_device, m_setLayout, nullptr);
+        m_pipelineLayout = VK_NULL_HANDLE;
+        m_pool = VK_NULL_HANDLE;
+        m_set = VK_NULL_HANDLE;
+        m_setLayout = VK_NULL_HANDLE;
+
+        // Rend aussi la capacité : les Vector vivent dans l'allocateur moteur
+        for (SSlots& slots : m_slots)
+        {
+            Vector<U16>().swap(slots.generations);
+            Vector<U32>().swap(slots.freeSlots);
+            slots.capacity = 0;
+            slots.highWater = 0;
+            slots.used = 0;
+        }
+        Vector<SPendingRelease>().swap(m_pendingReleases);
+        for (SFrameSource& source : m_sources) source = SFrameSource{};
+        m_activeSources = 0;
+
+        m_device = VK_NULL_HANDLE;
+    }
+
+    SBindlessHandle CBindlessTable::addTexture(VkImageView view, VkImageLayout layout)
+    {
+        VkDescriptorImageInfo info = { VK_NULL_HANDLE, view, layout };
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SBindlessHandle handle = allocateLocked(eBINDLESS_TEXTURE);
+        if (handle.isValid()) writeLocked(handle, &info, nullptr);
+        return handle;
+    }
+
+    SBindlessHandle CBindlessTable::addSampler(VkSampler sampler)
+    {
+        VkDescriptorImageInfo info = { sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SBindlessHandle handle = allocateLocked(eBINDLESS_SAMPLER);
+        if (handle.isValid()) writeLocked(handle, &info, nullptr);
+        return handle;
+    }
+
+    SBindlessHandle CBindlessTable::addStorageImage(VkImageView view)
+    {
+        VkDescriptorImageInfo info = { VK_NULL_HANDLE, view, VK_IMAGE_LAYOUT_GENERAL };
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SBindlessHandle handle = allocateLocked(eBINDLESS_STORAGE_IMAGE);
+        if (handle.isValid()) writeLocked(handle, &info, nullptr);
+        return handle;
+    }
+
+    SBindlessHandle CBindlessTable::addBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+    {
+        VkDescriptorBufferInfo info = { buffer, offset, range };
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SBindlessHandle handle = allocateLocked(eBINDLESS_BUFFER);
+        if (handle.isValid()) writeLocked(handle, nullptr, &info);
+        return handle;
+    }
+
+    // Slots libérés d'abord (déjà sortis de la latence), puis les jamais distribués
+    SBindlessHandle CBindlessTable::allocateLocked(EBindlessType type)
+    {
+        SBindlessHandle handle;
+        if (m_device == VK_NULL_HANDLE) return handle;
+
+        SSlots& slots = m_slots[type];
+        U32 index;
+        if (!slots.freeSlots.empty())
+        {
+            index = slots.freeSlots.back();
+            slots.freeSlots.pop_back();
+        }
+        else if (slots.highWater < slots.capacity)
+        {
+            index = slots.highWater++;
+        }
+        else
+        {
+            INGA_LOG(eERROR, "VULKAN", "Bindless table: all %u %s slots are in use.", slots.capacity, s_typeNames[type]);
+            return handle;
+        }
+
+        slots.generations[index] |= LIVE_BIT;
+        ++slots.used;
+
+        const U32 generation = slots.generations[index] & ~LIVE_BIT;
+        handle.value = index | ((U32)type << SBindlessHandle::INDEX_BITS) |
+                       (generation << (SBindlessHandle::INDEX_BITS + SBindlessHandle::TYPE_BITS));
+        return handle;
+    }
+
+    void CBindlessTable::writeLocked(SBindlessHandle handle, const VkDescriptorImageInfo* image, const VkDescriptorBufferInfo* buffer)
+    {
+        VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+        write.dstSet = m_set;
+        write.dstBinding = handle.type();
+        write.dstArrayElement = handle.index();
+        write.descriptorCount = 1;
+        write.descriptorType = m_slots[handle.type()].descriptorType;
+        write.pImageInfo = image;
+        write.pBufferInfo = buffer;
+        vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+        ++m_stats.descriptorWrites;
+    }
+
+    bool CBindlessTable::isValidLocked(SBindlessHandle handle) const
+    {
+        if (!handle.isValid() || handle.type() >= eBINDLESS_TYPE_COUNT) return false;
+
+        const SSlots& slots = m_slots[handle.type()];
+        if (handle.index() >= slots.highWater) return false;
+        return slots.generations[handle.index()] == (U16)(handle.generation() | LIVE_BIT);
+    }
+
+    bool CBindlessTable::isValid(SBindlessHandle handle) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return isValidLocked(handle);
+    }
+
+    // La génération avance tout de suite : le handle ne résout plus, le slot attend la fin des frames en vol
+    void CBindlessTable::release(SBindlessHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!isValidLocked(handle))
+        {
+            if (handle.isValid()) ++m_stats.staleHandles;
+            return;
+        }
+
+        SSlots& slots = m_slots[handle.type()];
+        U16 generation = (U16)((handle.generation() + 1) & ((1u << SBindlessHandle::GENERATION_BITS) - 1));
+        if (generation == 0) generation = 1;
+        slots.generations[handle.index()] = generation;
+        --slots.used;
+
+        // Aucune source : aucun command buffer ne lit la table, le slot est libre tout de suite
+        if (m_activeSources == 0)
+        {
+            slots.freeSlots.push_back(handle.index());
+            return;
+        }
+
+        SPendingRelease pending;
+        pending.value = handle.value;
+        for (U32 i = 0; i < MAX_FRAME_SOURCES; ++i) pending.frames[i] = m_sources[i].frame;
+        m_pendingReleases.push_back(pending);
+    }
+
+    U32 CBindlessTable::addFrameSource(U32 flightCount)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) return INVALID_FRAME_SOURCE;
+        for (U32 i = 0; i < MAX_FRAME_SOURCES; ++i)
+        {
+            // Le compteur d'une source retirée continue : les releases en attente restent comparables
+            if (m_sources[i].active) continue;
+            m_sources[i].active = true;
+            m_sources[i].latency = flightCount;
+            ++m_activeSources;
+            return i;
+        }
+        INGA_LOG(eERROR, "VULKAN", "Bindless table: more than %u frame sources.", MAX_FRAME_SOURCES);
+        return INVALID_FRAME_SOURCE;
+    }
+
+    void CBindlessTable::removeFrameSource(U32 source)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (source >= MAX_FRAME_SOURCES || !m_sources[source].active) return;
+        m_sources[source].active = false;
+        --m_activeSources;
+        retireLocked();
+    }
+
+    void CBindlessTable::nextFrame(U32 source)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (source >= MAX_FRAME_SOURCES || !m_sources[source].active) return;
+        ++m_sources[source].frame;
+        retireLocked();
+    }
+
+    // Chaque source active a soumis autant de frames que de vols depuis le release()
+    bool CBindlessTable::isRetiredLocked(const SPendingRelease& release) const
+    {
+        for (U32 i = 0; i < MAX_FRAME_SOURCES; ++i)
+        {
+            const SFrameSource& source = m_sources[i];
+            if (source.active && source.frame - release.frames[i] < source.latency) return false;
+        }
+        return true;
+    }
+
+    void CBindlessTable::retireLocked()
+    {
+        // Compteurs croissants : le début de la file est toujours le premier retirable
+        U32 retired = 0;
+        while (retired < m_pendingReleases.size() && isRetiredLocked(m_pendingReleases[retired]))
+        {
+            SBindlessHandle handle;
+            handle.value = m_pendingReleases[retired].value;
+            m_slots[handle.type()].freeSlots.push_back(handle.index());
+            ++retired;
+        }
+        if (retired > 0) m_pendingReleases.erase(m_pendingReleases.begin(), m_pendingReleases.begin() + retired);
+    }
+
+    void CBindlessTable::bind(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint) const
+    {
+        vkCmdBindDescriptorSets(cmd, bindPoint, m_pipelineLayout, 0, 1, &m_set, 0, nullptr);
+    }
+
+    void CBindlessTable::pushConstants(VkCommandBuffer cmd, const void* data, U32 size, U32 offset) const
+    {
+        vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_ALL, offset, size, data);
+    }
+
+    SBindlessStats CBindlessTable::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SBindlessStats stats = m_stats;
+        for (U32 t = 0; t < eBINDLESS_TYPE_COUNT; ++t) stats.used[t] = m_slots[t].used;
+        stats.pendingReleases = (U32)m_pendingReleases.size();
+        return stats;
+    }
+}
@@ -1,6 +1,9 @@
 #include <InGa/gfx/Context.h>
 #include <InGa/gfx/vulkan/vk_types.h>
 #include <InGa/core/log.h>
+#include <InGa/core/time.h>
+#include <InGa/core/profiler.h>
+#include <InGa/core/job.h>
 #include <algorithm>
 
 
@@ -56,13 +59,13 @@ bool CContext::initialize(CRenderDevice * pSharedGPU, const SContextConf& info)
     }
 
     this->initCommandResources();
+    m_renderGraph.initialize(m_renderDevice);
     return true;
 }
 
 bool CContext::setupSwapchain(const Window& window)
 {
     if (!m_renderDevice) return false;
-    VkDevice device =  m_renderDevice->getDevice();
     
     // 1. Création de la Surface (Multi-backend)
     if (!createSurface(window, m_renderDevice->getInstance()))
@@ -85,6 +88,12 @@ bool CContext::setupSwapchain(const Window& window)
         return false;
     }
 
+    return createSwapchain(VK_NULL_HANDLE);
+}
+
+bool CContext::createSwapchain(VkSwapchainKHR oldSwapchain)
+{
+    VkDevice device =  m_renderDevice->getDevice();
 
     // 2. Configuration (On pourra automatiser la sélection du format plus tard)
     m_swapchain.m_format = VK_FORMAT_B8G8R8A8_SRGB;
@@ -97,8 +106,14 @@ bool CContext::setupSwapchain(const Window& window)
     else
     {
         // If we have freedom, we clamp our desired size (1280x720) to the allowed bounds
-        m_swapchain.m_extent.width = std::clamp(window.getWidth(), capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
-        m_swapchain.m_extent.height = std::clamp(window.getHeight(), capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+        m_swapchain.m_extent.width = std::clamp(m_window.getWidth(), capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        m_swapchain.m_extent.height = std::clamp(m_window.getHeight(), capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+
+    // Fenêtre minimisée : pas de swapchain possible, on réessaiera à la frame suivante
+    if (m_swapchain.m_extent.width == 0 || m_swapchain.m_extent.height == 0)
+    {
+        return false;
     }
 
   VkSwapchainCreateInfoKHR createInfo = {};
@@ -130,6 +145,7 @@ bool CContext::setupSwapchain(const Window& window)
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR; 
     createInfo.clipped = VK_TRUE;
+    createInfo.oldSwapchain = oldSwapchain;
 
     if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &m_swapchain.m_handle) != VK_SUCCESS)
     {
@@ -196,6 +212,7 @@ bool CRenderDevice::findPresentQueue(VkSurfaceKHR surface)
     }
 
     vkGetDeviceQueue(m_logicalDevice, m_presentQueueFamily, 0, &m_presentQueue);
+    updateQueueLocks();
 
     return true;
 }
@@ -248,7 +265,12 @@ bool CContext::createSurface(const Window& window, VkInstance instance)
 void CContext::setupSyncObjects()
 {
     U32 imageCount = static_cast<U32>(m_swapchain.m_images.size());
-    m_swapchain.m_maxImageInFlight = (imageCount > 1) ? imageCount - 1 : 1;
+
+    // Le nombre de vols est fixé par initCommandResources : une recréation ne le change pas
+    if (m_cmdFrames.empty())
+    {
+        m_swapchain.m_maxImageInFlight = (imageCount > 1) ? imageCount - 1 : 1;
+    }
 
     m_swapchain.m_renderFinishedSemaphores.resize(imageCount);
     m_swapchain.m_imagesInFlight.resize(imageCount);
@@ -263,18 +285,15 @@ void CContext::setupSyncObjects()
 
 void CContext::initCommandResources()
 {
-    m_cmdPoolGFX.queueIndex = m_renderDevice->getGraphicsQueueFamily();
-    m_cmdPoolGFX.resetable = 1;
+    VkDevice device = m_renderDevice->getDevice();
 
+    // Pools TRANSIENT remis à zéro d'un bloc quand le vol revient : pas de reset par buffer
     VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
-    poolInfo.queueFamilyIndex = m_cmdPoolGFX.queueIndex;
-    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = m_renderDevice->getGraphicsQueueFamily();
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
 
-    if (vkCreateCommandPool(m_renderDevice->getDevice(), &poolInfo, nullptr, &m_cmdPoolGFX.commandPool) != VK_SUCCESS)
-    {
-		INGA_LOG(eINFO, "VULKAN", "Vulkan Context cleaned up successfully.");
-        return;
-    }
+    // Secondaires : un pool par thread du JobSystem (un pool n'est utilisable que par un thread à la fois)
+    const U32 threadPoolCount = JobSystem::isRunning() ? JobSystem::getThreadCount() + 1 : 0;
 
     // 2. Initialize the Frames (2 flights)
     U32 flightCount = m_swapchain.m_maxImageInFlight;
@@ -284,20 +303,488 @@ void CContext::initCommandResources()
     {
         SCommandBufferFrame& frame = m_cmdFrames[i];
 
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &frame.pool) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Failed to create frame command pool.");
+            return;
+        }
+
         VkCommandBufferAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
-        allocInfo.commandPool = m_cmdPoolGFX.commandPool;
+        allocInfo.commandPool = frame.pool;
         allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         allocInfo.commandBufferCount = 1;
-        vkAllocateCommandBuffers(m_renderDevice->getDevice(), &allocInfo, &frame.cmd);
+        vkAllocateCommandBuffers(device, &allocInfo, &frame.cmd);
 
         VkFenceCreateInfo fenceInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
         fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-        vkCreateFence(m_renderDevice->getDevice(), &fenceInfo, nullptr, &frame.inFlight);
+        vkCreateFence(device, &fenceInfo, nullptr, &frame.inFlight);
 
         // GPU Semaphore
         VkSemaphoreCreateInfo semInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
-        vkCreateSemaphore(m_renderDevice->getDevice(), &semInfo, nullptr, &frame.imageAvailable);
+        vkCreateSemaphore(device, &semInfo, nullptr, &frame.imageAvailable);
+
+        frame.threadPools.resize(threadPoolCount);
+        for (SThreadCommandPool& threadPool : frame.threadPools)
+        {
+            if (vkCreateCommandPool(device, &poolInfo, nullptr, &threadPool.pool) != VK_SUCCESS)
+            {
+                INGA_LOG(eERROR, "VULKAN", "Failed to create thread command pool.");
+                return;
+            }
+        }
+    }
+
+    // Un slot bindless libéré peut être lu jusqu'à ce que tous nos vols aient tourné
+    m_bindlessSource = m_renderDevice->getBindlessTable().addFrameSource(flightCount);
+
+    INGA_LOG(eINFO, "VULKAN", "Command resources: %u flights, %u recording threads.", flightCount, threadPoolCount);
+}
+
+/*
+ * Soumission ratée : la fence du vol est déjà reset et imageAvailable reste signalé par
+ * l'acquire. Une soumission vide consomme le sémaphore et signale la fence ; si elle
+ * échoue aussi, les deux objets sont recréés. L'image acquise n'est jamais présentée :
+ * la swapchain est recréée pour la rendre.
+ */
+void CContext::recoverFailedSubmit(SCommandBufferFrame& frame)
+{
+    VkSemaphoreSubmitInfo waitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO };
+    waitInfo.semaphore = frame.imageAvailable;
+    waitInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo2 submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO_2 };
+    submitInfo.waitSemaphoreInfoCount = 1;
+    submitInfo.pWaitSemaphoreInfos = &waitInfo;
+
+    m_swapchainDirty = true;
+    if (m_renderDevice->submit(eQUEUE_GRAPHICS, 1, &submitInfo, frame.inFlight) == VK_SUCCESS) return;
+
+    VkDevice device = m_renderDevice->getDevice();
+    vkDeviceWaitIdle(device);
+    for (VkFence& imageFence : m_swapchain.m_imagesInFlight)
+    {
+        if (imageFence == frame.inFlight) imageFence = VK_NULL_HANDLE;
+    }
+    vkDestroyFence(device, frame.inFlight, nullptr);
+    vkDestroySemaphore(device, frame.imageAvailable, nullptr);
+
+    VkFenceCreateInfo fenceInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    vkCreateFence(device, &fenceInfo, nullptr, &frame.inFlight);
+
+    VkSemaphoreCreateInfo semInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    vkCreateSemaphore(device, &semInfo, nullptr, &frame.imageAvailable);
+    INGA_LOG(eWARNING, "VULKAN", "Frame sync objects recreated after a failed submit.");
+}
+
+void CContext::setRecordCallback(RecordFrameCallback callback, void* userData)
+{
+    m_recordCallback = callback;
+    m_recordUserData = userData;
+}
+
+void CContext::setParallelRecordCallback(RecordRangeCallback callback, U32 itemCount, U32 batchSize, void* userData)
+{
+    m_parallelCallback = callback;
+    m_parallelUserData = userData;
+    m_parallelItemCount = itemCount;
+    m_parallelBatchSize = batchSize > 0 ? batchSize : 1;
+}
+
+void CContext::setClearColor(F32 r, F32 g, F32 b, F32 a)
+{
+    m_clearColor = { { r, g, b, a } };
+}
+
+void CContext::setRenderGraphCallback(BuildRenderGraphCallback callback, void* userData)
+{
+    m_graphCallback = callback;
+    m_graphUserData = userData;
+}
+
+void CContext::update()
+{
+    m_window.pollEvents();
+
+    // Libère les lots d'upload terminés sans attendre le prochain upload
+    CUploadService& uploads = m_renderDevice->getUploadService();
+    if (uploads.isInitialized()) uploads.collect();
+
+    // Sauvegarde périodique du cache de pipelines (si un intervalle est configuré)
+    m_renderDevice->getPipelineCache().update();
+}
+
+/*
+ * Frame pipelinée sur m_maxImageInFlight vols :
+ *   fence du vol -> acquire -> fence de l'image si un autre vol la tient
+ *   -> enregistrement -> submit (signale la fence du vol) -> present.
+ * Seule la fence du vol courant est attendue : le CPU enregistre la frame
+ * N+1 pendant que le GPU exécute encore les frames précédentes.
+ */
+void CContext::draw()
+{
+    if (!m_renderDevice || m_cmdFrames.empty()) return;
+    INGA_PROFILE_ZONE("CContext::draw");
+
+    if (m_swapchainDirty || m_swapchain.m_handle == VK_NULL_HANDLE)
+    {
+        if (!recreateSwapchain()) return;
+    }
+
+    VkDevice device = m_renderDevice->getDevice();
+    const U32 flightIndex = m_swapchain.m_currentFrame % (U32)m_cmdFrames.size();
+    SCommandBufferFrame& frame = m_cmdFrames[flightIndex];
+
+    SFrameTiming timing{};
+    timing.frameIndex = m_frameIndex;
+
+    // 1. Le vol a-t-il fini sa frame précédente ?
+    const U64 waitStart = Time::now();
+    vkWaitForFences(device, 1, &frame.inFlight, VK_TRUE, UINT64_MAX);
+    const U64 acquireStart = Time::now();
+
+    // 2. Image suivante ; imageAvailable sera signalé quand le moteur de présentation l'aura rendue
+    U32 imageIndex = 0;
+    VkResult result = vkAcquireNextImageKHR(device, m_swapchain.m_handle, UINT64_MAX, frame.imageAvailable, VK_NULL_HANDLE, &imageIndex);
+    const U64 acquireEnd = Time::now();
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        // Rien n'est soumis : la fence reste signalée, le vol est réutilisable tel quel
+        m_swapchainDirty = true;
+        return;
+    }
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+    {
+        INGA_LOG(eERROR, "VULKAN", "vkAcquireNextImageKHR failed with VkResult: %d", result);
+        return;
+    }
+
+    // 3. L'ordre des images n'est pas celui des vols : l'image peut encore appartenir à un autre vol
+    VkFence& imageFence = m_swapchain.m_imagesInFlight[imageIndex];
+    if (imageFence != VK_NULL_HANDLE && imageFence != frame.inFlight)
+    {
+        vkWaitForFences(device, 1, &imageFence, VK_TRUE, UINT64_MAX);
+    }
+    imageFence = frame.inFlight;
+    const U64 recordStart = Time::now();
+
+    timing.fenceWaitNs = Time::toNs(acquireStart - waitStart) + Time::toNs(recordStart - acquireEnd);
+    timing.acquireNs = Time::toNs(acquireEnd - acquireStart);
+
+    // Plus aucun retour avant la soumission ; si elle échoue, recoverFailedSubmit() re-signale la fence
+    vkResetFences(device, 1, &frame.inFlight);
+
+    // 4. Enregistrement
+    SFrameTarget target;
+    target.image = m_swapchain.m_images[imageIndex];
+    target.view = m_swapchain.m_imageViews[imageIndex];
+    target.extent = m_swapchain.m_extent;
+    target.format = m_swapchain.m_format;
+    target.imageIndex = imageIndex;
+    target.flightIndex = flightIndex;
+
+    U64 uploadWaitValue = 0;
+    timing.secondaryCount = recordFrame(frame, target, uploadWaitValue);
+    const U64 submitStart = Time::now();
+    timing.recordNs = Time::toNs(submitStart - recordStart);
+
+    // 5. Soumission : attend l'image (et les uploads consommés), signale renderFinished + la fence du vol
+    VkSemaphoreSubmitInfo waitInfos[2] = {};
+    waitInfos[0].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    waitInfos[0].semaphore = frame.imageAvailable;
+    waitInfos[0].stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    U32 waitCount = 1;
+
+    if (uploadWaitValue != 0)
+    {
+        waitInfos[1].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        waitInfos[1].semaphore = m_renderDevice->getUploadService().getTimelineSemaphore();
+        waitInfos[1].value = uploadWaitValue;
+        waitInfos[1].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        waitCount = 2;
+    }
+
+    VkCommandBufferSubmitInfo cmdInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO };
+    cmdInfo.commandBuffer = frame.cmd;
+
+    VkSemaphore renderFinished = m_swapchain.m_renderFinishedSemaphores[imageIndex];
+    VkSemaphoreSubmitInfo signalInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO };
+    signalInfo.semaphore = renderFinished;
+    signalInfo.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+    VkSubmitInfo2 submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO_2 };
+    submitInfo.waitSemaphoreInfoCount = waitCount;
+    submitInfo.pWaitSemaphoreInfos = waitInfos;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &cmdInfo;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+
+    result = m_renderDevice->submit(eQUEUE_GRAPHICS, 1, &submitInfo, frame.inFlight);
+    if (result != VK_SUCCESS)
+    {
+        INGA_LOG(eERROR, "VULKAN", "Frame submit failed with VkResult: %d", result);
+        imageFence = VK_NULL_HANDLE;
+        recoverFailedSubmit(frame);
+        return;
+    }
+
+    // 6. Présentation
+    VkPresentInfoKHR presentInfo = { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &renderFinished;
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = &m_swapchain.m_handle;
+    presentInfo.pImageIndices = &imageIndex;
+
+    result = m_renderDevice->present(&presentInfo);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    {
+        m_swapchainDirty = true;
+    }
+    else if (result != VK_SUCCESS)
+    {
+        INGA_LOG(eERROR, "VULKAN", "vkQueuePresentKHR failed with VkResult: %d", result);
+    }
+
+    timing.submitNs = Time::toNs(Time::now() - submitStart);
+    timing.cpuWaitNs = timing.fenceWaitNs + timing.acquireNs;
+    m_lastTiming = timing;
+    m_cpuWaitStats.addFrame(timing.cpuWaitNs);
+
+    m_swapchain.m_currentFrame = (flightIndex + 1) % (U32)m_cmdFrames.size();
+    ++m_frameIndex;
+    m_renderDevice->getBindlessTable().nextFrame(m_bindlessSource);
+}
+
+// Lots d'un enregistrement réparti ; vit sur la pile de recordFrame jusqu'au JobSystem::wait
+struct SParallelRecord
+{
+    CContext*            context;
+    SCommandBufferFrame* frame;
+    const SFrameTarget*  target;
+    RecordRangeCallback  callback;
+    void*                userData;
+    U32                  batchSize;
+    U32                  firstSlot;
+};
+
+U32 CContext::recordFrame(SCommandBufferFrame& frame, const SFrameTarget& target, U64& uploadWaitValue)
+{
+    VkDevice device = m_renderDevice->getDevice();
+
+    // La fence du vol est passée : un reset par pool au lieu d'un par buffer
+    vkResetCommandPool(device, frame.pool, 0);
+    for (SThreadCommandPool& threadPool : frame.threadPools)
+    {
+        if (threadPool.used == 0) continue;
+        vkResetCommandPool(device, threadPool.pool, 0);
+        threadPool.used = 0;
+    }
+
+    // Secondaires : le callback simple (slot 0) puis un par lot, dans l'ordre des lots
+    const bool useGraph = m_graphCallback && m_renderGraph.isInitialized();
+    const bool parallel = !useGraph && m_parallelCallback && m_parallelItemCount > 0 && !frame.threadPools.empty();
+    const U32 batchCount = parallel ? (m_parallelItemCount + m_parallelBatchSize - 1) / m_parallelBatchSize : 0;
+    const U32 firstSlot = (parallel && m_recordCallback) ? 1 : 0;
+
+    frame.secondaries.clear();
+    frame.secondaries.resize(firstSlot + batchCount, VK_NULL_HANDLE);
+
+    // Les workers enregistrent pendant que ce thread prépare le primaire
+    JobCounter counter;
+    SParallelRecord work = { this, &frame, &target, m_parallelCallback, m_parallelUserData, m_parallelBatchSize, firstSlot };
+    if (parallel)
+    {
+        JobSystem::runRange(m_parallelItemCount, m_parallelBatchSize, &CContext::recordRangeJob, &work, &counter);
+    }
+
+    VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(frame.cmd, &beginInfo);
+
+    // Table bindless liée une fois pour toute la frame : les draws n'indexent que par push constants
+    const CBindlessTable& bindless = m_renderDevice->getBindlessTable();
+    if (bindless.isInitialized()) bindless.bind(frame.cmd, VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+    // Uploads soumis d'ici là : acquires côté graphics, la soumission attendra leur jeton
+    CUploadService& uploads = m_renderDevice->getUploadService();
+    if (uploads.isInitialized())
+    {
+        uploads.flush();
+        uploadWaitValue = uploads.recordAcquireBarriers(frame.cmd, m_renderDevice->getGraphicsQueueFamily());
+    }
+
+    // Graphe de frame : barrières et rendu à sa charge ; s'il ne compile pas, on retombe sur l'effacement
+    if (useGraph)
+    {
+        const SRenderResourceState initial = { VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE };
+        const SRenderResourceState final = { VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE };
+
+        m_renderGraph.reset();
+        RenderResource backbuffer = m_renderGraph.importImage("backbuffer", target.image, target.view, target.format, target.extent,
+                                                              initial, final);
+        m_graphCallback(m_renderGraph, backbuffer, target, m_graphUserData);
+        if (m_renderGraph.compile())
+        {
+            m_renderGraph.execute(frame.cmd);
+            vkEndCommandBuffer(frame.cmd);
+            return 0;
+        }
+    }
+
+    const VkImageSubresourceRange colorRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    // UNDEFINED : l'image est effacée ; l'étape source se chaîne sur l'attente d'imageAvailable
+    VkImageMemoryBarrier2 toAttachment = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+    toAttachment.srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    toAttachment.srcAccessMask = VK_ACCESS_2_NONE;
+    toAttachment.dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    toAttachment.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    toAttachment.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    toAttachment.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    toAttachment.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toAttachment.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toAttachment.image = target.image;
+    toAttachment.subresourceRange = colorRange;
+
+    VkDependencyInfo dependency = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    dependency.imageMemoryBarrierCount = 1;
+    dependency.pImageMemoryBarriers = &toAttachment;
+    vkCmdPipelineBarrier2(frame.cmd, &dependency);
+
+    VkRenderingAttachmentInfo colorAttachment = { VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO };
+    colorAttachment.imageView = target.view;
+    colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.clearValue.color = m_clearColor;
+
+    VkRenderingInfo renderingInfo = { VK_STRUCTURE_TYPE_RENDERING_INFO };
+    renderingInfo.flags = parallel ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
+    renderingInfo.renderArea = { { 0, 0 }, target.extent };
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+
+    if (parallel)
+    {
+        if (m_recordCallback)
+        {
+            VkCommandBuffer cmd = beginSecondary(frame, target);
+            m_recordCallback(cmd, target, m_recordUserData);
+            vkEndCommandBuffer(cmd);
+            frame.secondaries[0] = cmd;
+        }
+
+        // Ce thread exécute aussi des lots en attendant
+        JobSystem::wait(&counter);
     }
+
+    vkCmdBeginRendering(frame.cmd, &renderingInfo);
+    if (parallel)
+    {
+        vkCmdExecuteCommands(frame.cmd, (U32)frame.secondaries.size(), frame.secondaries.data());
+    }
+    else
+    {
+        if (m_recordCallback) m_recordCallback(frame.cmd, target, m_recordUserData);
+        if (m_parallelCallback && m_parallelItemCount > 0)
+        {
+            m_parallelCallback(frame.cmd, 0, m_parallelItemCount, target, m_parallelUserData);
+        }
+    }
+    vkCmdEndRendering(frame.cmd);
+
+    // La présentation attend renderFinished : pas d'étape ni d'accès destination
+    VkImageMemoryBarrier2 toPresent = toAttachment;
+    toPresent.srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    toPresent.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    toPresent.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+    toPresent.dstAccessMask = VK_ACCESS_2_NONE;
+    toPresent.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    toPresent.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    dependency.pImageMemoryBarriers = &toPresent;
+    vkCmdPipelineBarrier2(frame.cmd, &dependency);
+
+    vkEndCommandBuffer(frame.cmd);
+    return (U32)frame.secondaries.size();
+}
+
+void CContext::recordRangeJob(U32 begin, U32 end, void* userData)
+{
+    SParallelRecord* work = static_cast<SParallelRecord*>(userData);
+
+    VkCommandBuffer cmd = work->context->beginSecondary(*work->frame, *work->target);
+    work->callback(cmd, begin, end, *work->target, work->userData);
+    vkEndCommandBuffer(cmd);
+
+    // runRange découpe par lots de batchSize : begin identifie le lot
+    work->frame->secondaries[work->firstSlot + begin / work->batchSize] = cmd;
+}
+
+// Secondaire du pool du thread appelant, hérite du rendu dynamique de la frame
+VkCommandBuffer CContext::beginSecondary(SCommandBufferFrame& frame, const SFrameTarget& target)
+{
+    const U32 threadIndex = JobSystem::getCurrentThreadIndex();
+    const U32 externalSlot = (U32)frame.threadPools.size() - 1;
+    SThreadCommandPool& threadPool = frame.threadPools[threadIndex < externalSlot ? threadIndex : externalSlot];
+
+    if (threadPool.used == threadPool.secondaries.size())
+    {
+        VkCommandBufferAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        allocInfo.commandPool = threadPool.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        vkAllocateCommandBuffers(m_renderDevice->getDevice(), &allocInfo, &cmd);
+        threadPool.secondaries.push_back(cmd);
+    }
+    VkCommandBuffer cmd = threadPool.secondaries[threadPool.used++];
+
+    VkCommandBufferInheritanceRenderingInfo renderingInheritance = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO };
+    renderingInheritance.colorAttachmentCount = 1;
+    renderingInheritance.pColorAttachmentFormats = &target.format;
+    renderingInheritance.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritance = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+    inheritance.pNext = &renderingInheritance;
+
+    VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritance;
+    vkBeginCommandBuffer(cmd, &beginInfo);
+
+    // L'état lié n'est pas hérité du primaire
+    const CBindlessTable& bindless = m_renderDevice->getBindlessTable();
+    if (bindless.isInitialized()) bindless.bind(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    return cmd;
+}
+
+bool CContext::recreateSwapchain()
+{
+    VkDevice device = m_renderDevice->getDevice();
+
+    // Les vols en cours référencent les images et les semaphores de l'ancienne swapchain
+    vkDeviceWaitIdle(device);
+
+    VkSwapchainKHR oldSwapchain = m_swapchain.m_handle;
+    m_swapchain.destroyImageResources(device);
+    m_swapchain.m_handle = VK_NULL_HANDLE;
+
+    const bool created = createSwapchain(oldSwapchain);
+    if (oldSwapchain != VK_NULL_HANDLE) vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
+
+    // En cas d'échec (fenêtre minimisée) : nouvel essai à la prochaine frame
+    m_swapchainDirty = !created;
+    if (created)
+    {
+        INGA_LOG(eINFO, "VULKAN", "Swapchain recreated: %ux%u.", m_swapchain.m_extent.width, m_swapchain.m_extent.height);
+    }
+    return created;
 }
 
 void CContext::cleanup()
@@ -307,17 +794,24 @@ void CContext::cleanup()
     VkDevice logicalDevice = m_renderDevice->getDevice();
 
     vkDeviceWaitIdle(logicalDevice);
+    m_renderGraph.shutdown();
+    m_renderDevice->getBindlessTable().removeFrameSource(m_bindlessSource);
+    m_bindlessSource = CBindlessTable::INVALID_FRAME_SOURCE;
     for (U32 i = 0; i < m_cmdFrames.size(); i++)
     {
         SCommandBufferFrame& frame = m_cmdFrames[i];
 
         vkDestroyFence(m_renderDevice->getDevice(), frame.inFlight, nullptr);
         vkDestroySemaphore(m_renderDevice->getDevice(), frame.imageAvailable, nullptr);
-        vkFreeCommandBuffers(m_renderDevice->getDevice(), m_cmdPoolGFX.commandPool, 1, &frame.cmd);
-    }
 
-    // 3. Destroy the Pool
-    vkDestroyCommandPool(m_renderDevice->getDevice(), m_cmdPoolGFX.commandPool, nullptr);
+        // 3. Destroy the Pools (leurs command buffers avec)
+        vkDestroyCommandPool(m_renderDevice->getDevice(), frame.pool, nullptr);
+        for (SThreadCommandPool& threadPool : frame.threadPools)
+        {
+            vkDestroyCommandPool(m_renderDevice->getDevice(), threadPool.pool, nullptr);
+        }
+    }
+    Vector<SCommandBufferFrame>().swap(m_cmdFrames);
 
     m_swapchain.cleanup(logicalDevice);
 
@@ -0,0 +1,582 @@
+#include <InGa/gfx/GpuMemory.h>
+#include <InGa/core/allocator.h>
+#include <InGa/core/log.h>
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace Inga
+{
+    static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static VkDeviceSize alignDown(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return value & ~(alignment - 1);
+    }
+
+    // Les blocs vivent dans l'allocateur moteur, comme leurs métadonnées TLSF
+    CGpuMemoryAllocator::SBlock* CGpuMemoryAllocator::createBlock()
+    {
+        void* memory = Allocator::alloc(sizeof(SBlock), alignof(SBlock), 0, __FILE__, __LINE__);
+        return memory ? new (memory) SBlock() : nullptr;
+    }
+
+    void CGpuMemoryAllocator::destroyBlock(SBlock* block)
+    {
+        block->~SBlock();
+        Allocator::free(block);
+    }
+
+    CGpuMemoryAllocator::~CGpuMemoryAllocator()
+    {
+        if (m_device != VK_NULL_HANDLE) shutdown();
+    }
+
+    bool CGpuMemoryAllocator::initialize(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize blockSize)
+    {
+        if (physicalDevice == VK_NULL_HANDLE || device == VK_NULL_HANDLE) return false;
+
+        m_physicalDevice = physicalDevice;
+        m_device = device;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+        VkPhysicalDeviceMaintenance3Properties maintenance3 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_3_PROPERTIES };
+        VkPhysicalDeviceProperties2 props2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+        props2.pNext = &maintenance3;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &props2);
+
+        m_maxDeviceMemoryCount = props2.properties.limits.maxMemoryAllocationCount;
+        m_nonCoherentAtomSize = props2.properties.limits.nonCoherentAtomSize ? props2.properties.limits.nonCoherentAtomSize : 1;
+
+        // Un bloc reste un seul vkAllocateMemory : borné par maxMemoryAllocationSize
+        m_blockSize = blockSize;
+        if (maintenance3.maxMemoryAllocationSize && m_blockSize > maintenance3.maxMemoryAllocationSize)
+        {
+            m_blockSize = maintenance3.maxMemoryAllocationSize;
+        }
+        m_blockSize = alignDown(m_blockSize, ALLOCATION_UNIT);
+
+        m_deviceMemoryCount = 0;
+        m_dedicatedCount = 0;
+        m_dedicatedBytes = 0;
+        m_warnedAllocationCount = false;
+        for (U32 i = 0; i < VK_MAX_MEMORY_HEAPS; ++i) m_heapUsage[i] = 0;
+
+        INGA_LOG(eINFO, "VULKAN", "GPU memory allocator ready: %u types, %u heaps, blocks of %llu MB, max %u device allocations.",
+                 m_memoryProperties.memoryTypeCount, m_memoryProperties.memoryHeapCount,
+                 (unsigned long long)(m_blockSize >> 20), m_maxDeviceMemoryCount);
+        return true;
+    }
+
+    void CGpuMemoryAllocator::shutdown()
+    {
+        if (m_device == VK_NULL_HANDLE) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        U32 leakedAllocations = 0;
+        for (U32 type = 0; type < VK_MAX_MEMORY_TYPES; ++type)
+        {
+            for (U32 kind = 0; kind < 2; ++kind)
+            {
+                SPool& pool = m_pools[type][kind];
+                for (SBlock* block : pool.blocks)
+                {
+                    if (!block) continue;
+                    leakedAllocations += block->allocator.getStats().allocationCount;
+
+                    if (block->mapped) vkUnmapMemory(m_device, block->memory);
+                    vkFreeMemory(m_device, block->memory, nullptr);
+                    destroyBlock(block);
+                }
+                // Rend aussi la capacité : le Vector vit dans l'allocateur moteur
+                Vector<SBlock*>().swap(pool.blocks);
+            }
+        }
+
+        if (leakedAllocations > 0 || m_dedicatedCount > 0)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "GPU memory allocator shutdown with %u sub-allocations and %u dedicated allocations still alive.",
+                     leakedAllocations, m_dedicatedCount);
+        }
+
+        m_device = VK_NULL_HANDLE;
+        m_physicalDevice = VK_NULL_HANDLE;
+        m_deviceMemoryCount = 0;
+        m_dedicatedCount = 0;
+        m_dedicatedBytes = 0;
+    }
+
+    bool CGpuMemoryAllocator::allocate(const VkMemoryRequirements& requirements, EGpuMemoryUsage usage, bool linear, SGpuAllocation& allocation)
+    {
+        return allocateInternal(requirements, usage, linear, false, VK_NULL_HANDLE, VK_NULL_HANDLE, allocation);
+    }
+
+    void CGpuMemoryAllocator::free(SGpuAllocation& allocation)
+    {
+        if (!allocation.isValid() || m_device == VK_NULL_HANDLE) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (allocation.blockIndex == SGpuAllocation::DEDICATED)
+        {
+            freeDeviceMemory(allocation.memory, allocation.size, allocation.memoryType, allocation.mapped != nullptr);
+            --m_dedicatedCount;
+            m_dedicatedBytes -= allocation.size;
+        }
+        else
+        {
+            SPool& pool = m_pools[allocation.memoryType][allocation.linear ? 1 : 0];
+            SBlock* block = pool.blocks[allocation.blockIndex];
+            block->allocator.free(allocation.slot);
+
+            // Un bloc vide est rendu s'il en reste un autre dans le pool : pas d'aller-retour
+            // vkAllocateMemory / vkFreeMemory quand une seule ressource va et vient
+            if (block->allocator.isEmpty())
+            {
+                U32 liveBlocks = 0;
+                for (SBlock* other : pool.blocks) liveBlocks += other ? 1 : 0;
+
+                if (liveBlocks > 1)
+                {
+                    freeDeviceMemory(block->memory, block->size, allocation.memoryType, block->mapped != nullptr);
+                    destroyBlock(block);
+                    pool.blocks[allocation.blockIndex] = nullptr;
+                }
+            }
+        }
+
+        allocation = SGpuAllocation();
+    }
+
+    bool CGpuMemoryAllocator::createBuffer(const VkBufferCreateInfo& info, EGpuMemoryUsage usage, VkBuffer& buffer, SGpuAllocation& allocation)
+    {
+        if (vkCreateBuffer(m_device, &info, nullptr, &buffer) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "vkCreateBuffer failed (%llu bytes).", (unsigned long long)info.size);
+            buffer = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkMemoryDedicatedRequirements dedicatedReqs = { VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS };
+        VkMemoryRequirements2 requirements = { VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2 };
+        requirements.pNext = &dedicatedReqs;
+
+        VkBufferMemoryRequirementsInfo2 reqInfo = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2 };
+        reqInfo.buffer = buffer;
+        vkGetBufferMemoryRequirements2(m_device, &reqInfo, &requirements);
+
+        const bool dedicated = dedicatedReqs.prefersDedicatedAllocation || dedicatedReqs.requiresDedicatedAllocation;
+        if (!allocateInternal(requirements.memoryRequirements, usage, true, dedicated, VK_NULL_HANDLE, buffer, allocation))
+        {
+            vkDestroyBuffer(m_device, buffer, nullptr);
+            buffer = VK_NULL_HANDLE;
+            return false;
+        }
+
+        if (vkBindBufferMemory(m_device, buffer, allocation.memory, allocation.offset) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "vkBindBufferMemory failed.");
+            destroyBuffer(buffer, allocation);
+            return false;
+        }
+        return true;
+    }
+
+    void CGpuMemoryAllocator::destroyBuffer(VkBuffer& buffer, SGpuAllocation& allocation)
+    {
+        if (buffer != VK_NULL_HANDLE) vkDestroyBuffer(m_device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        free(allocation);
+    }
+
+    bool CGpuMemoryAllocator::createImage(const VkImageCreateInfo& info, EGpuMemoryUsage usage, VkImage& image, SGpuAllocation& allocation)
+    {
+        if (vkCreateImage(m_device, &info, nullptr, &image) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "vkCreateImage failed (%ux%u).", info.extent.width, info.extent.height);
+            image = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkMemoryDedicatedRequirements dedicatedReqs = { VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS };
+        VkMemoryRequirements2 requirements = { VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2 };
+        requirements.pNext = &dedicatedReqs;
+
+        VkImageMemoryRequirementsInfo2 reqInfo = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2 };
+        reqInfo.image = image;
+        vkGetImageMemoryRequirements2(m_device, &reqInfo, &requirements);
+
+        // Les pilotes le demandent surtout pour les render targets (compression, tuiles)
+        const bool dedicated = dedicatedReqs.prefersDedicatedAllocation || dedicatedReqs.requiresDedicatedAllocation;
+        const bool linear = info.tiling == VK_IMAGE_TILING_LINEAR;
+        if (!allocateInternal(requirements.memoryRequirements, usage, linear, dedicated, image, VK_NULL_HANDLE, allocation))
+        {
+            vkDestroyImage(m_device, image, nullptr);
+            image = VK_NULL_HANDLE;
+            return false;
+        }
+
+        if (vkBindImageMemory(m_device, image, allocation.memory, allocation.offset) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "vkBindImageMemory failed.");
+            destroyImage(image, allocation);
+            return false;
+        }
+        return true;
+    }
+
+    void CGpuMemoryAllocator::destroyImage(VkImage& image, SGpuAllocation& allocation)
+    {
+        if (image != VK_NULL_HANDLE) vkDestroyImage(m_device, image, nullptr);
+        image = VK_NULL_HANDLE;
+        free(allocation);
+    }
+
+    void CGpuMemoryAllocator::flush(const SGpuAllocation& allocation, VkDeviceSize offset, VkDeviceSize size)
+    {
+        if (!allocation.mapped) return;
+        if (m_memoryProperties.memoryTypes[allocation.memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) return;
+
+        const VkMappedMemoryRange range = mappedRange(allocation, offset, size);
+        vkFlushMappedMemoryRanges(m_device, 1, &range);
+    }
+
+    void CGpuMemoryAllocator::invalidate(const SGpuAllocation& allocation, VkDeviceSize offset, VkDeviceSize size)
+    {
+        if (!allocation.mapped) return;
+        if (m_memoryProperties.memoryTypes[allocation.memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) return;
+
+        const VkMappedMemoryRange range = mappedRange(allocation, offset, size);
+        vkInvalidateMappedMemoryRanges(m_device, 1, &range);
+    }
+
+    SGpuMemoryStats CGpuMemoryAllocator::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        SGpuMemoryStats stats{};
+        stats.dedicatedBytes = m_dedicatedBytes;
+        stats.dedicatedCount = m_dedicatedCount;
+        stats.deviceMemoryCount = m_deviceMemoryCount;
+        stats.maxDeviceMemoryCount = m_maxDeviceMemoryCount;
+        stats.heapCount = m_memoryProperties.memoryHeapCount;
+
+        for (U32 heap = 0; heap < m_memoryProperties.memoryHeapCount; ++heap)
+        {
+            stats.heapUsage[heap] = m_heapUsage[heap];
+            stats.heapSize[heap] = m_memoryProperties.memoryHeaps[heap].size;
+        }
+
+        for (U32 type = 0; type < m_memoryProperties.memoryTypeCount; ++type)
+        {
+            for (U32 kind = 0; kind < 2; ++kind)
+            {
+                for (SBlock* block : m_pools[type][kind].blocks)
+                {
+                    if (!block) continue;
+                    const OffsetAllocatorStats blockStats = block->allocator.getStats();
+                    stats.blockBytes += block->size;
+                    stats.usedBytes += (U64)(block->allocator.getSize() - blockStats.totalFree) * ALLOCATION_UNIT;
+                    stats.allocationCount += blockStats.allocationCount;
+                    ++stats.blockCount;
+                }
+            }
+        }
+        return stats;
+    }
+
+    void CGpuMemoryAllocator::logStats() const
+    {
+        const SGpuMemoryStats stats = getStats();
+
+        INGA_LOG(eINFO, "VULKAN", "GPU memory: %u blocks (%llu MB, %llu MB used, %u allocations), %u dedicated (%llu MB), %u / %u device allocations.",
+                 stats.blockCount, (unsigned long long)(stats.blockBytes >> 20), (unsigned long long)(stats.usedBytes >> 20),
+                 stats.allocationCount, stats.dedicatedCount, (unsigned long long)(stats.dedicatedBytes >> 20),
+                 stats.deviceMemoryCount, stats.maxDeviceMemoryCount);
+
+        for (U32 heap = 0; heap < stats.heapCount; ++heap)
+        {
+            INGA_LOG(eINFO, "VULKAN", "  heap %u : %llu / %llu MB", heap,
+                     (unsigned long long)(stats.heapUsage[heap] >> 20), (unsigned long long)(stats.heapSize[heap] >> 20));
+        }
+    }
+
+    // --- Interne ---
+
+    U32 CGpuMemoryAllocator::findMemoryType(U32 typeBits, EGpuMemoryUsage usage) const
+    {
+        VkMemoryPropertyFlags required = 0;
+        VkMemoryPropertyFlags preferred = 0;
+        VkMemoryPropertyFlags avoided = 0;
+
+        switch (usage)
+        {
+            case eGPU_MEMORY_DEVICE:
+                required = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+                avoided = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;     // garde le BAR pour l'upload
+                break;
+            case eGPU_MEMORY_UPLOAD:
+                required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+                avoided = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+                break;
+            case eGPU_MEMORY_READBACK:
+                required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+                preferred = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+                break;
+        }
+
+        U32 bestType = 0xFFFFFFFF;
+        I32 bestScore = -1000;
+        for (U32 i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+        {
+            if (!(typeBits & (1u << i))) continue;
+
+            const VkMemoryPropertyFlags flags = m_memoryProperties.memoryTypes[i].propertyFlags;
+            if ((flags & required) != required) continue;
+
+            const I32 score = std::popcount((U32)(flags & preferred)) - std::popcount((U32)(flags & avoided));
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestType = i;
+            }
+        }
+
+        // Pas de DEVICE_LOCAL compatible (rare) : n'importe quel type accepté par la ressource
+        if (bestType == 0xFFFFFFFF && usage == eGPU_MEMORY_DEVICE)
+        {
+            for (U32 i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+            {
+                if (typeBits & (1u << i)) return i;
+            }
+        }
+        return bestType;
+    }
+
+    bool CGpuMemoryAllocator::isHostVisible(U32 memoryType) const
+    {
+        return (m_memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    }
+
+    bool CGpuMemoryAllocator::allocateDeviceMemory(VkDeviceSize size, U32 memoryType, bool linear,
+                                                   VkImage dedicatedImage, VkBuffer dedicatedBuffer,
+                                                   VkDeviceMemory& memory, void*& mapped)
+    {
+        memory = VK_NULL_HANDLE;
+        mapped = nullptr;
+
+        if (m_deviceMemoryCount >= m_maxDeviceMemoryCount)
+        {
+            INGA_LOG(eERROR, "VULKAN", "maxMemoryAllocationCount reached (%u device allocations).", m_maxDeviceMemoryCount);
+            return false;
+        }
+        if (!m_warnedAllocationCount && m_deviceMemoryCount >= m_maxDeviceMemoryCount - m_maxDeviceMemoryCount / 10)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "%u / %u device allocations: too many dedicated allocations?",
+                     m_deviceMemoryCount, m_maxDeviceMemoryCount);
+            m_warnedAllocationCount = true;
+        }
+
+        VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        // bufferDeviceAddress est activé par CRenderDevice : requis pour vkGetBufferDeviceAddress
+        VkMemoryAllocateFlagsInfo flagsInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO };
+        flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+        VkMemoryDedicatedAllocateInfo dedicatedInfo = { VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO };
+        dedicatedInfo.image = dedicatedImage;
+        dedicatedInfo.buffer = dedicatedBuffer;
+
+        const void** next = &allocInfo.pNext;
+        if (linear && dedicatedImage == VK_NULL_HANDLE)
+        {
+            *next = &flagsInfo;
+            next = &flagsInfo.pNext;
+        }
+        if (dedicatedImage != VK_NULL_HANDLE || dedicatedBuffer != VK_NULL_HANDLE)
+        {
+            *next = &dedicatedInfo;
+        }
+
+        const VkResult result = vkAllocateMemory(m_device, &allocInfo, nullptr, &memory);
+        if (result != VK_SUCCESS)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "vkAllocateMemory(%llu bytes, type %u) failed with VkResult: %d",
+                     (unsigned long long)size, memoryType, result);
+            memory = VK_NULL_HANDLE;
+            return false;
+        }
+
+        if (isHostVisible(memoryType) && vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "vkMapMemory failed on memory type %u.", memoryType);
+            vkFreeMemory(m_device, memory, nullptr);
+            memory = VK_NULL_HANDLE;
+            mapped = nullptr;
+            return false;
+        }
+
+        ++m_deviceMemoryCount;
+        m_heapUsage[m_memoryProperties.memoryTypes[memoryType].heapIndex] += size;
+        return true;
+    }
+
+    void CGpuMemoryAllocator::freeDeviceMemory(VkDeviceMemory memory, VkDeviceSize size, U32 memoryType, bool mapped)
+    {
+        if (mapped) vkUnmapMemory(m_device, memory);
+        vkFreeMemory(m_device, memory, nullptr);
+
+        --m_deviceMemoryCount;
+        m_heapUsage[m_memoryProperties.memoryTypes[memoryType].heapIndex] -= size;
+    }
+
+    bool CGpuMemoryAllocator::allocateInternal(const VkMemoryRequirements& requirements, EGpuMemoryUsage usage, bool linear,
+                                               bool dedicated, VkImage dedicatedImage, VkBuffer dedicatedBuffer,
+                                               SGpuAllocation& allocation)
+    {
+        allocation = SGpuAllocation();
+        if (m_device == VK_NULL_HANDLE || requirements.size == 0) return false;
+
+        const U32 memoryType = findMemoryType(requirements.memoryTypeBits, usage);
+        if (memoryType == 0xFFFFFFFF)
+        {
+            INGA_LOG(eERROR, "VULKAN", "No memory type for usage %u (type bits 0x%x).", (U32)usage, requirements.memoryTypeBits);
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Au-delà d'un demi-bloc, un bloc partagé gaspillerait plus qu'il n'économise
+        const VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[memoryType].heapIndex].size;
+        const VkDeviceSize blockSize = std::min(m_blockSize, alignDown(heapSize / 8, ALLOCATION_UNIT));
+        if (requirements.size > blockSize / 2) dedicated = true;
+
+        if (!dedicated && allocateFromPool(requirements.size, requirements.alignment, memoryType, linear, allocation)) return true;
+
+        // Dédiée, ou plus de place pour un nouveau bloc : une allocation à la taille exacte
+        void* mapped = nullptr;
+        if (!allocateDeviceMemory(requirements.size, memoryType, linear, dedicatedImage, dedicatedBuffer, allocation.memory, mapped))
+        {
+            INGA_LOG(eERROR, "VULKAN", "Out of GPU memory (%llu bytes, type %u).", (unsigned long long)requirements.size, memoryType);
+            return false;
+        }
+
+        allocation.offset = 0;
+        allocation.size = requirements.size;
+        allocation.mapped = mapped;
+        allocation.memoryType = memoryType;
+        allocation.blockIndex = SGpuAllocation::DEDICATED;
+        allocation.linear = linear ? 1 : 0;
+
+        ++m_dedicatedCount;
+        m_dedicatedBytes += requirements.size;
+        return true;
+    }
+
+    bool CGpuMemoryAllocator::allocateFromPool(VkDeviceSize size, VkDeviceSize alignment, U32 memoryType, bool linear, SGpuAllocation& allocation)
+    {
+        // Les offsets sont des multiples de ALLOCATION_UNIT : un alignement plus grand
+        // se paie en marge, récupérée à free() avec le reste du slot
+        const VkDeviceSize units = alignUp(size, ALLOCATION_UNIT) / ALLOCATION_UNIT;
+        const VkDeviceSize paddingUnits = alignment > ALLOCATION_UNIT ? alignment / ALLOCATION_UNIT - 1 : 0;
+        const U32 slotUnits = (U32)(units + paddingUnits);
+
+        SPool& pool = m_pools[memoryType][linear ? 1 : 0];
+
+        U32 blockIndex = 0xFFFFFFFF;
+        OffsetAllocation slot;
+        for (U32 i = 0; i < (U32)pool.blocks.size(); ++i)
+        {
+            if (!pool.blocks[i]) continue;
+            slot = pool.blocks[i]->allocator.allocate(slotUnits);
+            if (slot.isValid())
+            {
+                blockIndex = i;
+                break;
+            }
+        }
+
+        if (blockIndex == 0xFFFFFFFF)
+        {
+            const VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[memoryType].heapIndex].size;
+            const VkDeviceSize blockSize = std::min(m_blockSize, alignDown(heapSize / 8, ALLOCATION_UNIT));
+            if ((VkDeviceSize)slotUnits * ALLOCATION_UNIT > blockSize) return false;
+
+            SBlock* block = createBlock();
+            if (!block) return false;
+            block->size = blockSize;
+            if (!block->allocator.init((U32)(blockSize / ALLOCATION_UNIT), MAX_ALLOCATIONS_PER_BLOCK) ||
+                !allocateDeviceMemory(blockSize, memoryType, linear, VK_NULL_HANDLE, VK_NULL_HANDLE, block->memory, block->mapped))
+            {
+                destroyBlock(block);
+                return false;
+            }
+
+            // Réutilise un emplacement rendu : les index des allocations vivantes restent stables
+            for (U32 i = 0; i < (U32)pool.blocks.size(); ++i)
+            {
+                if (!pool.blocks[i])
+                {
+                    blockIndex = i;
+                    break;
+                }
+            }
+            if (blockIndex == 0xFFFFFFFF)
+            {
+                blockIndex = (U32)pool.blocks.size();
+                pool.blocks.push_back(block);
+            }
+            else
+            {
+                pool.blocks[blockIndex] = block;
+            }
+
+            INGA_LOG(eDEBUG, "VULKAN", "New GPU memory block: type %u, %s, %llu MB.", memoryType,
+                     linear ? "linear" : "optimal", (unsigned long long)(blockSize >> 20));
+
+            slot = block->allocator.allocate(slotUnits);
+        }
+
+        SBlock* block = pool.blocks[blockIndex];
+        const VkDeviceSize offset = alignUp((VkDeviceSize)slot.offset * ALLOCATION_UNIT, alignment ? alignment : 1);
+
+        allocation.memory = block->memory;
+        allocation.offset = offset;
+        allocation.size = size;
+        allocation.mapped = block->mapped ? (U8*)block->mapped + offset : nullptr;
+        allocation.memoryType = memoryType;
+        allocation.blockIndex = blockIndex;
+        allocation.linear = linear ? 1 : 0;
+        allocation.slot = slot;
+        return true;
+    }
+
+    VkMappedMemoryRange CGpuMemoryAllocator::mappedRange(const SGpuAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const
+    {
+        VkDeviceSize memorySize = allocation.size;
+        if (allocation.blockIndex != SGpuAllocation::DEDICATED)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            memorySize = m_pools[allocation.memoryType][allocation.linear ? 1 : 0].blocks[allocation.blockIndex]->size;
+        }
+
+        if (size == VK_WHOLE_SIZE || offset + size > allocation.size) size = allocation.size - offset;
+
+        // Bornes alignées sur nonCoherentAtomSize, sans dépasser la VkDeviceMemory
+        const VkDeviceSize begin = alignDown(allocation.offset + offset, m_nonCoherentAtomSize);
+        VkDeviceSize end = alignUp(allocation.offset + offset + size, m_nonCoherentAtomSize);
+        if (end > memorySize) end = memorySize;
+
+        VkMappedMemoryRange range = { VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE };
+        range.memory = allocation.memory;
+        range.offset = begin;
+        range.size = end - begin;
+        return range;
+    }
+}
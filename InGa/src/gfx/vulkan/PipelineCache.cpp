@@ -0,0 +1,327 @@
+#include <InGa/gfx/PipelineCache.h>
+#include <InGa/core/log.h>
+#include <InGa/core/time.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace Inga
+{
+    static const U32 PIPELINE_CACHE_MAGIC = 0x43504749;    // "IGPC"
+    static const U32 PIPELINE_CACHE_VERSION = 1;
+
+    // FNV-1a par mots de 64 bits : détecte un fichier tronqué ou abîmé, pas une attaque
+    static U64 hashBlob(const U8* data, U64 size)
+    {
+        U64 hash = 0xCBF29CE484222325ull;
+        U64 i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            U64 word;
+            memcpy(&word, data + i, 8);
+            hash = (hash ^ word) * 0x100000001B3ull;
+        }
+        for (; i < size; ++i) hash = (hash ^ data[i]) * 0x100000001B3ull;
+        return hash;
+    }
+
+    CPipelineCache::~CPipelineCache()
+    {
+        if (m_device != VK_NULL_HANDLE) shutdown();
+    }
+
+    bool CPipelineCache::initialize(VkPhysicalDevice physicalDevice, VkDevice device, const char* path)
+    {
+        shutdown();
+        if (physicalDevice == VK_NULL_HANDLE || device == VK_NULL_HANDLE || !path) return false;
+
+        const U64 start = Time::now();
+        m_device = device;
+        vkGetPhysicalDeviceProperties(physicalDevice, &m_properties);
+        snprintf(m_path, sizeof(m_path), "%s", path);
+        m_stats = SPipelineCacheStats{};
+
+        Vector<U8> data;
+        const bool loaded = loadFile(data);
+
+        VkPipelineCacheCreateInfo info = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+        info.initialDataSize = loaded ? (size_t)data.size() : 0;
+        info.pInitialData = loaded ? data.data() : nullptr;
+
+        VkResult result = vkCreatePipelineCache(m_device, &info, nullptr, &m_cache);
+        if (result != VK_SUCCESS && loaded)
+        {
+            // Blob refusé par le pilote malgré un en-tête valide : cache vide
+            m_stats.loadResult = ePIPELINE_CACHE_REJECTED;
+            info.initialDataSize = 0;
+            info.pInitialData = nullptr;
+            result = vkCreatePipelineCache(m_device, &info, nullptr, &m_cache);
+        }
+
+        if (result != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Failed to create pipeline cache. VkResult: %d", result);
+            m_cache = VK_NULL_HANDLE;
+            m_device = VK_NULL_HANDLE;
+            return false;
+        }
+
+        if (m_stats.loadResult == ePIPELINE_CACHE_LOADED)
+        {
+            m_stats.loadedBytes = data.size();
+            m_initialData.swap(data);
+        }
+
+        size_t size = 0;
+        vkGetPipelineCacheData(m_device, m_cache, &size, nullptr);
+        m_lastSavedSize = size;
+        m_lastSaveTicks = Time::now();
+        m_stats.loadTimeNs = Time::toNs(m_lastSaveTicks - start);
+
+        switch (m_stats.loadResult)
+        {
+            case ePIPELINE_CACHE_LOADED:
+                INGA_LOG(eINFO, "VULKAN", "Pipeline cache loaded from '%s': %llu KB in %.2f ms.", m_path,
+                         (unsigned long long)(m_stats.loadedBytes >> 10), m_stats.loadTimeNs * 1e-6);
+                break;
+            case ePIPELINE_CACHE_REJECTED:
+                INGA_LOG(eWARNING, "VULKAN", "Pipeline cache '%s' discarded (other GPU/driver or corrupted): cold start.", m_path);
+                break;
+            default:
+                INGA_LOG(eINFO, "VULKAN", "No pipeline cache at '%s': cold start.", m_path);
+                break;
+        }
+        return true;
+    }
+
+    void CPipelineCache::shutdown()
+    {
+        if (m_device == VK_NULL_HANDLE) return;
+
+        save();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (VkPipelineCache cache : m_workerCaches) vkDestroyPipelineCache(m_device, cache, nullptr);
+        if (m_cache != VK_NULL_HANDLE) vkDestroyPipelineCache(m_device, m_cache, nullptr);
+
+        // Rend aussi la capacité : les Vector vivent dans l'allocateur moteur
+        Vector<VkPipelineCache>().swap(m_workerCaches);
+        Vector<U8>().swap(m_initialData);
+
+        m_cache = VK_NULL_HANDLE;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    VkPipelineCache CPipelineCache::createWorkerCache()
+    {
+        if (m_device == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+
+        // m_initialData ne bouge plus après initialize() : pas de verrou
+        VkPipelineCacheCreateInfo info = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+        info.initialDataSize = (size_t)m_initialData.size();
+        info.pInitialData = m_initialData.empty() ? nullptr : m_initialData.data();
+
+        VkPipelineCache cache = VK_NULL_HANDLE;
+        if (vkCreatePipelineCache(m_device, &info, nullptr, &cache) != VK_SUCCESS)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "Failed to create worker pipeline cache.");
+            return VK_NULL_HANDLE;
+        }
+        return cache;
+    }
+
+    void CPipelineCache::submitWorkerCache(VkPipelineCache cache)
+    {
+        if (m_device == VK_NULL_HANDLE || cache == VK_NULL_HANDLE) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_workerCaches.push_back(cache);
+    }
+
+    bool CPipelineCache::merge()
+    {
+        if (m_device == VK_NULL_HANDLE) return false;
+
+        std::unique_lock<std::shared_mutex> use(m_useMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return mergeLocked();
+    }
+
+    bool CPipelineCache::save()
+    {
+        if (m_device == VK_NULL_HANDLE) return false;
+
+        const U64 start = Time::now();
+        std::unique_lock<std::shared_mutex> use(m_useMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return saveLocked(start);
+    }
+
+    // m_useMutex (exclusif) et m_mutex tenus
+    bool CPipelineCache::saveLocked(U64 start)
+    {
+        mergeLocked();
+
+        size_t size = 0;
+        if (vkGetPipelineCacheData(m_device, m_cache, &size, nullptr) != VK_SUCCESS || size == 0) return false;
+
+        // VK_INCOMPLETE si le cache a grossi entre les deux appels : le début reste un cache valide
+        Vector<U8> data(size);
+        const VkResult result = vkGetPipelineCacheData(m_device, m_cache, &size, data.data());
+        if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || !validateBlob(data.data(), size)) return false;
+
+        SFileHeader header{};
+        header.magic = PIPELINE_CACHE_MAGIC;
+        header.version = PIPELINE_CACHE_VERSION;
+        header.dataSize = size;
+        header.dataHash = hashBlob(data.data(), size);
+        header.vendorID = m_properties.vendorID;
+        header.deviceID = m_properties.deviceID;
+        header.driverVersion = m_properties.driverVersion;
+        memcpy(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+        char tempPath[520];
+        snprintf(tempPath, sizeof(tempPath), "%s.tmp", m_path);
+
+        FILE* file = fopen(tempPath, "wb");
+        if (!file)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "Cannot write pipeline cache '%s'.", tempPath);
+            return false;
+        }
+
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(data.data(), 1, size, file) == size;
+        written = fflush(file) == 0 && written;
+        written = fclose(file) == 0 && written;
+
+        // Le rename remplace l'ancien fichier d'un coup : jamais de fichier à moitié écrit
+        std::error_code error;
+        if (written) fs::rename(tempPath, m_path, error);
+        if (!written || error)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "Failed to save pipeline cache '%s'.", m_path);
+            remove(tempPath);
+            return false;
+        }
+
+        m_lastSavedSize = size;
+        m_lastSaveTicks = Time::now();
+        m_stats.savedBytes = size;
+        m_stats.saveTimeNs = Time::toNs(m_lastSaveTicks - start);
+        ++m_stats.saveCount;
+
+        INGA_LOG(eDEBUG, "VULKAN", "Pipeline cache saved: %llu KB in %.2f ms.",
+                 (unsigned long long)(size >> 10), m_stats.saveTimeNs * 1e-6);
+        return true;
+    }
+
+    void CPipelineCache::setAutoSaveInterval(F64 seconds)
+    {
+        m_autoSaveTicks = seconds > 0.0 ? Time::fromNs((U64)(seconds * 1e9)) : 0;
+    }
+
+    void CPipelineCache::update()
+    {
+        if (m_device == VK_NULL_HANDLE || m_autoSaveTicks == 0) return;
+
+        const U64 now = Time::now();
+        if (now - m_lastSaveTicks < m_autoSaveTicks) return;
+
+        // Un thread crée des pipelines avec le cache : on réessaie à la prochaine frame
+        std::unique_lock<std::shared_mutex> use(m_useMutex, std::try_to_lock);
+        if (!use.owns_lock()) return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Rien de neuf depuis la dernière sauvegarde : pas d'écriture disque
+        size_t size = 0;
+        vkGetPipelineCacheData(m_device, m_cache, &size, nullptr);
+        if (m_workerCaches.empty() && size == m_lastSavedSize)
+        {
+            m_lastSaveTicks = now;
+            return;
+        }
+
+        saveLocked(now);
+    }
+
+    SPipelineCacheStats CPipelineCache::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    // --- Interne ---
+
+    bool CPipelineCache::loadFile(Vector<U8>& data)
+    {
+        m_stats.loadResult = ePIPELINE_CACHE_COLD;
+
+        FILE* file = fopen(m_path, "rb");
+        if (!file) return false;
+
+        m_stats.loadResult = ePIPELINE_CACHE_REJECTED;
+
+        SFileHeader header{};
+        bool valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                     header.magic == PIPELINE_CACHE_MAGIC &&
+                     header.version == PIPELINE_CACHE_VERSION &&
+                     header.dataSize > 0 && header.dataSize <= MAX_FILE_SIZE &&
+                     header.vendorID == m_properties.vendorID &&
+                     header.deviceID == m_properties.deviceID &&
+                     header.driverVersion == m_properties.driverVersion &&
+                     memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+
+        if (valid)
+        {
+            data.resize((size_t)header.dataSize);
+            valid = fread(data.data(), 1, data.size(), file) == data.size() &&
+                    hashBlob(data.data(), header.dataSize) == header.dataHash &&
+                    validateBlob(data.data(), header.dataSize);
+        }
+        fclose(file);
+
+        if (!valid)
+        {
+            Vector<U8>().swap(data);
+            return false;
+        }
+
+        m_stats.loadResult = ePIPELINE_CACHE_LOADED;
+        return true;
+    }
+
+    // En-tête Vulkan du blob (VkPipelineCacheHeaderVersionOne), indépendant de notre préfixe
+    bool CPipelineCache::validateBlob(const U8* data, U64 size) const
+    {
+        VkPipelineCacheHeaderVersionOne header;
+        if (size < sizeof(header)) return false;
+        memcpy(&header, data, sizeof(header));
+
+        return header.headerSize >= sizeof(header) && header.headerSize <= size &&
+               header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+               header.vendorID == m_properties.vendorID &&
+               header.deviceID == m_properties.deviceID &&
+               memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    bool CPipelineCache::mergeLocked()
+    {
+        if (m_workerCaches.empty()) return false;
+
+        const VkResult result = vkMergePipelineCaches(m_device, m_cache, (U32)m_workerCaches.size(), m_workerCaches.data());
+        if (result != VK_SUCCESS)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "vkMergePipelineCaches failed with VkResult: %d", result);
+        }
+        else
+        {
+            m_stats.mergedCaches += (U32)m_workerCaches.size();
+        }
+
+        for (VkPipelineCache cache : m_workerCaches) vkDestroyPipelineCache(m_device, cache, nullptr);
+        m_workerCaches.clear();
+        return result == VK_SUCCESS;
+    }
+}
@@ -2,6 +2,7 @@
 #include <InGa/core/log.h>
 #include <InGa/core/container.h>
 #include <cstring>
+#include <cstdio>
 
 namespace Inga
 {
@@ -43,6 +44,33 @@ namespace Inga
             return false;
         }
 
+        if (!m_memoryAllocator.initialize(m_physicalDevice, m_logicalDevice))
+        {
+            INGA_LOG(eFATAL, "VULKAN", "Failed to initialize GPU memory allocator.");
+            return false;
+        }
+
+        if (!m_uploadService.initialize(this))
+        {
+            INGA_LOG(eFATAL, "VULKAN", "Failed to initialize upload service.");
+            return false;
+        }
+
+        // Un cache par application, dans le répertoire courant ; rejeté s'il vient d'un autre GPU / pilote
+        char cachePath[256];
+        snprintf(cachePath, sizeof(cachePath), "%s.pipeline_cache", appName ? appName : "inga");
+        if (!m_pipelineCache.initialize(m_physicalDevice, m_logicalDevice, cachePath))
+        {
+            INGA_LOG(eFATAL, "VULKAN", "Failed to initialize pipeline cache.");
+            return false;
+        }
+
+        if (!m_bindlessTable.initialize(this))
+        {
+            INGA_LOG(eFATAL, "VULKAN", "Failed to initialize bindless table.");
+            return false;
+        }
+
         INGA_LOG(eINFO, "VULKAN", "RenderDevice initialized successfully.");
         m_isInitialized = 1;
         return true;
@@ -53,6 +81,10 @@ void CRenderDevice::shutdown()
 	if (m_logicalDevice != VK_NULL_HANDLE)
 	{
 		vkDeviceWaitIdle(m_logicalDevice);
+        m_uploadService.shutdown();
+        m_pipelineCache.shutdown();
+        m_bindlessTable.shutdown();
+        m_memoryAllocator.shutdown();
         vkDestroyDevice(m_logicalDevice, nullptr);
         m_logicalDevice = VK_NULL_HANDLE;
 	}
@@ -63,6 +95,52 @@ void CRenderDevice::shutdown()
 	}
 }
 
+VkQueue CRenderDevice::getQueue(EQueueType type) const
+{
+    switch (type)
+    {
+        case eQUEUE_GRAPHICS: return m_graphicsQueue;
+        case eQUEUE_COMPUTE:  return m_computeQueue;
+        case eQUEUE_TRANSFER: return m_transferQueue;
+        case eQUEUE_PRESENT:  return m_presentQueue;
+        default:              return VK_NULL_HANDLE;
+    }
+}
+
+VkResult CRenderDevice::submit(EQueueType type, U32 submitCount, const VkSubmitInfo2* submits, VkFence fence)
+{
+    VkQueue queue = getQueue(type);
+    if (queue == VK_NULL_HANDLE) return VK_ERROR_INITIALIZATION_FAILED;
+
+    std::lock_guard<std::mutex> lock(m_queueMutex[m_queueLock[type]]);
+    return vkQueueSubmit2(queue, submitCount, submits, fence);
+}
+
+VkResult CRenderDevice::present(const VkPresentInfoKHR* presentInfo)
+{
+    if (m_presentQueue == VK_NULL_HANDLE) return VK_ERROR_INITIALIZATION_FAILED;
+
+    std::lock_guard<std::mutex> lock(m_queueMutex[m_queueLock[eQUEUE_PRESENT]]);
+    return vkQueuePresentKHR(m_presentQueue, presentInfo);
+}
+
+void CRenderDevice::updateQueueLocks()
+{
+    // Sans famille dédiée, plusieurs types reçoivent la même VkQueue : même verrou
+    for (U32 i = 0; i < eQUEUE_COUNT; ++i)
+    {
+        m_queueLock[i] = (U8)i;
+        for (U32 j = 0; j < i; ++j)
+        {
+            if (getQueue((EQueueType)j) == getQueue((EQueueType)i))
+            {
+                m_queueLock[i] = m_queueLock[j];
+                break;
+            }
+        }
+    }
+}
+
 bool CRenderDevice::checkDeviceExtensionSupport(VkPhysicalDevice device)
     {
         U32 extensionCount;
@@ -139,16 +217,35 @@ bool CRenderDevice::createLogicalDevice()
   // 3.1. Initialize all to zero first
   VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES };
   VkPhysicalDeviceBufferDeviceAddressFeatures bdaFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES };
+  VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES };
+  VkPhysicalDeviceSynchronization2Features sync2Features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES };
+  VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES };
   VkPhysicalDeviceFeatures2 deviceFeatures2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
 
   //3.2 set feature
   dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
   bdaFeatures.bufferDeviceAddress = VK_TRUE;
+  timelineFeatures.timelineSemaphore = VK_TRUE;     // jetons de l'upload service
+  sync2Features.synchronization2 = VK_TRUE;         // vkQueueSubmit2 / vkCmdPipelineBarrier2
+
+  // Table bindless : tableaux indexés par entier, mis à jour après bind, partiellement remplis
+  indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+  indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+  indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+  indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+  indexingFeatures.descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
+  indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+  indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+  indexingFeatures.shaderStorageImageArrayNonUniformIndexing = VK_TRUE;
+  indexingFeatures.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
 
   // 3.3. Link the chain (Top -> Down)
   deviceFeatures2.pNext = &bdaFeatures;
   bdaFeatures.pNext = &dynamicRenderingFeatures;
-  dynamicRenderingFeatures.pNext = nullptr; // Explicitly terminate
+  dynamicRenderingFeatures.pNext = &timelineFeatures;
+  timelineFeatures.pNext = &sync2Features;
+  sync2Features.pNext = &indexingFeatures;
+  indexingFeatures.pNext = nullptr; // Explicitly terminate
 
   // 4. Extensions (InGa::Vector utilisé ici)
   Vector<const char*> deviceExtensions;
@@ -186,6 +283,7 @@ bool CRenderDevice::createLogicalDevice()
   vkGetDeviceQueue(m_logicalDevice, m_computeQueueFamily,  0, &m_computeQueue);
   vkGetDeviceQueue(m_logicalDevice, m_transferQueueFamily, 0, &m_transferQueue);
   vkGetDeviceQueue(m_logicalDevice, m_presentQueueFamily, 0, &m_presentQueue);
+  updateQueueLocks();
 
   INGA_LOG(eINFO, "VULKAN", "Logical Device Ready. G:%d C:%d T:%d", 
            m_graphicsQueueFamily, m_computeQueueFamily, m_transferQueueFamily);
@@ -203,7 +301,9 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
     if (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) level = eWARNING;
     if (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)   level = eFATAL;
 
-    INGA_LOG(level, "VULKAN_VALIDATION", "%s", pCallbackData->pMessage);
+    // Une frame fautive peut produire des milliers de messages identiques :
+    // limités par site, les doublons consécutifs sont fusionnés par le Log
+    INGA_LOG_RATE(level, "VULKAN_VALIDATION", 20, "%s", pCallbackData->pMessage);
     
     return VK_FALSE; // Toujours retourner False
 }
@@ -419,8 +519,17 @@ I32 CRenderDevice::rateDeviceSuitability(VkPhysicalDevice device)
     vkGetPhysicalDeviceProperties(device, &props);
     vkGetPhysicalDeviceFeatures(device, &features);
 
+    VkPhysicalDeviceDescriptorIndexingFeatures indexing_features = {};
+    indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    VkPhysicalDeviceSynchronization2Features sync2_features = {};
+    sync2_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    sync2_features.pNext = &indexing_features;
+    VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features = {};
+    timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timeline_features.pNext = &sync2_features;
     VkPhysicalDeviceDynamicRenderingFeatures dynamic_features = {};
     dynamic_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+    dynamic_features.pNext = &timeline_features;
     VkPhysicalDeviceBufferDeviceAddressFeatures bda_features {};
     bda_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
     bda_features.pNext = &dynamic_features;
@@ -431,7 +540,7 @@ I32 CRenderDevice::rateDeviceSuitability(VkPhysicalDevice device)
 
     vkGetPhysicalDeviceFeatures2(device, &device_features);
     
-    // Pas de Buffer Device Address = Pas de 3ème voie (Arena/Offset Allocator)
+    // Pas de Buffer Device Address = Pas de 3ème voie (CGpuMemoryAllocator alloue avec DEVICE_ADDRESS)
     if (!bda_features.bufferDeviceAddress)
     {
         INGA_LOG(eWARNING, "VULKAN", "GPU rejected: Missing Buffer Device Address support.");
@@ -445,6 +554,27 @@ I32 CRenderDevice::rateDeviceSuitability(VkPhysicalDevice device)
         return -1;
     }
 
+    // Uploads asynchrones : jetons timeline, soumissions et barrières sync2
+    if (!timeline_features.timelineSemaphore || !sync2_features.synchronization2)
+    {
+        INGA_LOG(eWARNING, "VULKAN", "GPU rejected: Missing Timeline Semaphore or Synchronization2 support.");
+        return -1;
+    }
+
+    // Table bindless : UPDATE_AFTER_BIND sur les trois types de tableaux, slots vides tolérés
+    if (!indexing_features.runtimeDescriptorArray || !indexing_features.descriptorBindingPartiallyBound ||
+        !indexing_features.descriptorBindingUpdateUnusedWhilePending ||
+        !indexing_features.descriptorBindingSampledImageUpdateAfterBind ||
+        !indexing_features.descriptorBindingStorageImageUpdateAfterBind ||
+        !indexing_features.descriptorBindingStorageBufferUpdateAfterBind ||
+        !indexing_features.shaderSampledImageArrayNonUniformIndexing ||
+        !indexing_features.shaderStorageImageArrayNonUniformIndexing ||
+        !indexing_features.shaderStorageBufferArrayNonUniformIndexing)
+    {
+        INGA_LOG(eWARNING, "VULKAN", "GPU rejected: Missing Descriptor Indexing (bindless) support.");
+        return -1;
+    }
+
     I32 score = 0;
 
     // 1. Privilégier les GPU Discrets (Performance)
@@ -0,0 +1,1058 @@
+#include <InGa/gfx/RenderGraph.h>
+#include <InGa/gfx/RenderDevice.h>
+#include <InGa/core/log.h>
+#include <InGa/core/profiler.h>
+#include <algorithm>
+
+namespace Inga
+{
+    static const U32 NONE = 0xFFFFFFFF;
+
+    static const VkAccessFlags2 WRITE_ACCESS_MASK = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                                                    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+                                                    VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+    struct SAccessInfo
+    {
+        VkPipelineStageFlags2 stages;
+        VkAccessFlags2        access;
+        VkImageLayout         layout;
+        VkImageUsageFlags     usage;
+        bool                  write;
+        bool                  shaderStages;   // étapes shader selon le type de passe
+        bool                  image;
+        bool                  buffer;
+    };
+
+    static const SAccessInfo s_accessInfos[eACCESS_COUNT] =
+    {
+        // eACCESS_COLOR_ATTACHMENT
+        { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, true, false, true, false },
+        // eACCESS_DEPTH_ATTACHMENT
+        { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+          VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+          VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, true, false, true, false },
+        // eACCESS_DEPTH_READ
+        { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+          VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+          VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, false, false, true, false },
+        // eACCESS_SAMPLED
+        { 0, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, false, true, true, false },
+        // eACCESS_STORAGE_READ
+        { 0, VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+          VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, false, true, true, true },
+        // eACCESS_STORAGE_WRITE
+        { 0, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+          VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, true, true, true, true },
+        // eACCESS_TRANSFER_SRC
+        { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT,
+          VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT, false, false, true, true },
+        // eACCESS_TRANSFER_DST
+        { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT, true, false, true, true },
+        // eACCESS_VERTEX_BUFFER
+        { VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT,
+          VK_IMAGE_LAYOUT_UNDEFINED, 0, false, false, false, true },
+        // eACCESS_INDEX_BUFFER
+        { VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_INDEX_READ_BIT,
+          VK_IMAGE_LAYOUT_UNDEFINED, 0, false, false, false, true },
+        // eACCESS_INDIRECT_BUFFER
+        { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
+          VK_IMAGE_LAYOUT_UNDEFINED, 0, false, false, false, true },
+        // eACCESS_UNIFORM_BUFFER
+        { 0, VK_ACCESS_2_UNIFORM_READ_BIT,
+          VK_IMAGE_LAYOUT_UNDEFINED, 0, false, true, false, true },
+    };
+
+    static SAccessInfo accessInfo(ERenderAccess access, ERenderPassType type)
+    {
+        SAccessInfo info = s_accessInfos[access];
+        if (info.shaderStages)
+        {
+            switch (type)
+            {
+            case eRENDER_PASS_GRAPHICS: info.stages = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT; break;
+            case eRENDER_PASS_COMPUTE:  info.stages = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT; break;
+            default:                    info.stages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT; break;
+            }
+        }
+        return info;
+    }
+
+    static bool isAttachment(ERenderAccess access)
+    {
+        return access == eACCESS_COLOR_ATTACHMENT || access == eACCESS_DEPTH_ATTACHMENT || access == eACCESS_DEPTH_READ;
+    }
+
+    static VkImageAspectFlags aspectOf(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_S8_UINT:
+            return VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+        }
+    }
+
+    static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static bool sameDesc(const SRenderImageDesc& a, const SRenderImageDesc& b)
+    {
+        return a.format == b.format && a.extent.width == b.extent.width && a.extent.height == b.extent.height &&
+               a.mipLevels == b.mipLevels && a.samples == b.samples;
+    }
+
+    CRenderGraph::~CRenderGraph()
+    {
+        if (m_device) shutdown();
+    }
+
+    bool CRenderGraph::initialize(CRenderDevice* device)
+    {
+        if (!device || device->getDevice() == VK_NULL_HANDLE) return false;
+
+        m_device = device;
+        m_stats = SRenderGraphStats{};
+        reset();
+        return true;
+    }
+
+    void CRenderGraph::shutdown()
+    {
+        if (!m_device) return;
+
+        destroyPhysical(m_physical, m_heaps);
+
+        // Rend aussi la capacité : les Vector vivent dans l'allocateur moteur
+        Vector<SResource>().swap(m_resources);
+        Vector<SUse>().swap(m_uses);
+        Vector<SPass>().swap(m_passes);
+        Vector<U32>().swap(m_passUses);
+        Vector<SEdge>().swap(m_edges);
+        Vector<U32>().swap(m_order);
+        Vector<U32>().swap(m_lastWriter);
+        Vector<U32>().swap(m_readerHead);
+        Vector<U32>().swap(m_readerLinks);
+        Vector<U32>().swap(m_indegree);
+        Vector<U32>().swap(m_ready);
+        Vector<U32>().swap(m_resourceUses);
+        Vector<U32>().swap(m_resourceUseBegin);
+        Vector<U8>().swap(m_covered);
+        Vector<VkImageMemoryBarrier2>().swap(m_imageBarriers);
+        Vector<SPhysicalImage>().swap(m_physical);
+        Vector<SHeap>().swap(m_heaps);
+
+        m_compiled = false;
+        m_device = nullptr;
+    }
+
+    void CRenderGraph::reset()
+    {
+        m_resources.clear();
+        m_uses.clear();
+        m_passes.clear();
+        m_compiled = false;
+    }
+
+    RenderResource CRenderGraph::createImage(const char* name, const SRenderImageDesc& desc)
+    {
+        if (desc.format == VK_FORMAT_UNDEFINED || desc.extent.width == 0 || desc.extent.height == 0 || desc.mipLevels == 0)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Render graph: invalid description for transient image '%s'.", name ? name : "?");
+            return INVALID_RESOURCE;
+        }
+
+        SResource resource{};
+        resource.name = name;
+        resource.desc = desc;
+        resource.physical = NONE;
+        m_resources.push_back(resource);
+        return (RenderResource)(m_resources.size() - 1);
+    }
+
+    RenderResource CRenderGraph::importImage(const char* name, VkImage image, VkImageView view, VkFormat format, VkExtent2D extent,
+                                             const SRenderResourceState& initial, const SRenderResourceState& final)
+    {
+        if (image == VK_NULL_HANDLE)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Render graph: null image imported as '%s'.", name ? name : "?");
+            return INVALID_RESOURCE;
+        }
+
+        SResource resource{};
+        resource.name = name;
+        resource.imported = true;
+        resource.desc.format = format;
+        resource.desc.extent = extent;
+        resource.image = image;
+        resource.view = view;
+        resource.initial = initial;
+        resource.final = final;
+        resource.physical = NONE;
+        m_resources.push_back(resource);
+        return (RenderResource)(m_resources.size() - 1);
+    }
+
+    RenderResource CRenderGraph::importBuffer(const char* name, VkBuffer buffer, const SRenderResourceState& initial)
+    {
+        if (buffer == VK_NULL_HANDLE)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Render graph: null buffer imported as '%s'.", name ? name : "?");
+            return INVALID_RESOURCE;
+        }
+
+        SResource resource{};
+        resource.name = name;
+        resource.imported = true;
+        resource.isBuffer = true;
+        resource.buffer = buffer;
+        resource.initial = initial;
+        resource.physical = NONE;
+        m_resources.push_back(resource);
+        return (RenderResource)(m_resources.size() - 1);
+    }
+
+    U32 CRenderGraph::addPass(const char* name, ERenderPassType type, RenderPassCallback callback, void* userData)
+    {
+        SPass pass{};
+        pass.name = name;
+        pass.type = type;
+        pass.callback = callback;
+        pass.userData = userData;
+        m_passes.push_back(pass);
+        return (U32)(m_passes.size() - 1);
+    }
+
+    void CRenderGraph::use(U32 pass, RenderResource resource, ERenderAccess access)
+    {
+        if (pass >= m_passes.size() || resource >= m_resources.size() || access >= eACCESS_COUNT) return;
+
+        const SResource& res = m_resources[resource];
+        const SAccessInfo& info = s_accessInfos[access];
+        if (res.isBuffer ? !info.buffer : !info.image)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Render graph: pass '%s' uses '%s' with an access that does not fit a %s.",
+                     m_passes[pass].name, res.name, res.isBuffer ? "buffer" : "image");
+            return;
+        }
+
+        SUse use{};
+        use.pass = pass;
+        use.resource = resource;
+        use.access = access;
+        use.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        use.storeOp = access == eACCESS_DEPTH_READ ? VK_ATTACHMENT_STORE_OP_NONE : VK_ATTACHMENT_STORE_OP_STORE;
+        m_uses.push_back(use);
+    }
+
+    void CRenderGraph::clear(U32 pass, RenderResource resource, const VkClearValue& value)
+    {
+        for (SUse& use : m_uses)
+        {
+            // Un attachment en lecture seule ne s'efface pas
+            if (use.pass == pass && use.resource == resource && isAttachment(use.access) && s_accessInfos[use.access].write)
+            {
+                use.clear = true;
+                use.clearValue = value;
+                return;
+            }
+        }
+        INGA_LOG(eWARNING, "VULKAN", "Render graph: clear() without a matching attachment use.");
+    }
+
+    void CRenderGraph::setSideEffect(U32 pass)
+    {
+        if (pass < m_passes.size()) m_passes[pass].sideEffect = true;
+    }
+
+    bool CRenderGraph::compile()
+    {
+        INGA_PROFILE_ZONE("CRenderGraph::compile");
+
+        m_compiled = false;
+        if (!m_device) return false;
+
+        const U32 rebuilds = m_stats.physicalRebuilds;
+        m_stats = SRenderGraphStats{};
+        m_stats.physicalRebuilds = rebuilds;
+        m_stats.passCount = (U32)m_passes.size();
+
+        buildPassUses();
+        buildEdges();
+        cullPasses();
+        schedulePasses();
+        if (!realizeTransients()) return false;
+        computeBarriers();
+
+        m_compiled = true;
+        return true;
+    }
+
+    // Usages regroupés par passe, dans l'ordre des use()
+    void CRenderGraph::buildPassUses()
+    {
+        for (SPass& pass : m_passes) pass.useCount = 0;
+        for (const SUse& use : m_uses) ++m_passes[use.pass].useCount;
+
+        U32 begin = 0;
+        for (SPass& pass : m_passes)
+        {
+            pass.useBegin = begin;
+            begin += pass.useCount;
+            pass.useCount = 0;
+        }
+
+        m_passUses.resize(m_uses.size());
+        for (U32 i = 0; i < m_uses.size(); ++i)
+        {
+            SPass& pass = m_passes[m_uses[i].pass];
+            m_passUses[pass.useBegin + pass.useCount++] = i;
+        }
+    }
+
+    // Arêtes entrantes, par ordre de déclaration : les sources sont toujours déclarées avant
+    void CRenderGraph::buildEdges()
+    {
+        const U32 resourceCount = (U32)m_resources.size();
+        m_edges.clear();
+        m_lastWriter.assign(resourceCount, NONE);
+        m_readerHead.assign(resourceCount, NONE);
+        m_readerLinks.clear();
+
+        auto addEdge = [this](U32 from, U32 to, bool strong)
+        {
+            if (from == to) return;
+            SPass& pass = m_passes[to];
+            for (U32 e = pass.edgeBegin; e < m_edges.size(); ++e)
+            {
+                if (m_edges[e].from == from)
+                {
+                    m_edges[e].strong |= strong;
+                    return;
+                }
+            }
+            m_edges.push_back({ from, to, strong });
+        };
+
+        for (U32 p = 0; p < m_passes.size(); ++p)
+        {
+            SPass& pass = m_passes[p];
+            pass.edgeBegin = (U32)m_edges.size();
+
+            for (U32 i = 0; i < pass.useCount; ++i)
+            {
+                const SUse& use = m_uses[m_passUses[pass.useBegin + i]];
+                const U32 r = use.resource;
+
+                // RAW / WAW : la dernière écriture
+                if (m_lastWriter[r] != NONE) addEdge(m_lastWriter[r], p, true);
+
+                if (s_accessInfos[use.access].write)
+                {
+                    // WAR : les lectures depuis cette écriture passent avant
+                    for (U32 link = m_readerHead[r]; link != NONE; link = m_readerLinks[link * 2 + 1])
+                    {
+                        addEdge(m_readerLinks[link * 2], p, false);
+                    }
+                    m_readerHead[r] = NONE;
+                    m_lastWriter[r] = p;
+                }
+                else
+                {
+                    m_readerLinks.push_back(p);
+                    m_readerLinks.push_back(m_readerHead[r]);
+                    m_readerHead[r] = (U32)(m_readerLinks.size() / 2 - 1);
+                }
+            }
+            pass.edgeCount = (U32)m_edges.size() - pass.edgeBegin;
+        }
+    }
+
+    // Racines : écrivent une ressource importée ou ont un effet de bord ; on remonte les arêtes fortes
+    void CRenderGraph::cullPasses()
+    {
+        for (SPass& pass : m_passes)
+        {
+            pass.alive = pass.sideEffect;
+            for (U32 i = 0; i < pass.useCount && !pass.alive; ++i)
+            {
+                const SUse& use = m_uses[m_passUses[pass.useBegin + i]];
+                pass.alive = s_accessInfos[use.access].write && m_resources[use.resource].imported;
+            }
+        }
+
+        for (U32 p = (U32)m_passes.size(); p-- > 0;)
+        {
+            const SPass& pass = m_passes[p];
+            if (!pass.alive) continue;
+
+            for (U32 e = pass.edgeBegin; e < pass.edgeBegin + pass.edgeCount; ++e)
+            {
+                if (m_edges[e].strong) m_passes[m_edges[e].from].alive = true;
+            }
+        }
+
+        for (const SPass& pass : m_passes)
+        {
+            if (!pass.alive) ++m_stats.culledPassCount;
+        }
+    }
+
+    // Kahn ; parmi les passes prêtes, la première déclarée qui ne dépend pas de la précédente
+    void CRenderGraph::schedulePasses()
+    {
+        const U32 passCount = (U32)m_passes.size();
+        m_order.clear();
+        m_ready.clear();
+        m_indegree.assign(passCount, 0);
+
+        for (const SEdge& edge : m_edges)
+        {
+            if (m_passes[edge.from].alive && m_passes[edge.to].alive) ++m_indegree[edge.to];
+        }
+        for (U32 p = 0; p < passCount; ++p)
+        {
+            if (m_passes[p].alive && m_indegree[p] == 0) m_ready.push_back(p);
+        }
+
+        U32 last = NONE;
+        while (!m_ready.empty())
+        {
+            U32 pick = 0;
+            if (last != NONE)
+            {
+                for (U32 i = 0; i < m_ready.size(); ++i)
+                {
+                    const SPass& candidate = m_passes[m_ready[i]];
+                    bool dependsOnLast = false;
+                    for (U32 e = candidate.edgeBegin; e < candidate.edgeBegin + candidate.edgeCount; ++e)
+                    {
+                        if (m_edges[e].from == last) { dependsOnLast = true; break; }
+                    }
+                    if (!dependsOnLast) { pick = i; break; }
+                }
+            }
+
+            const U32 p = m_ready[pick];
+            m_ready.erase(m_ready.begin() + pick);
+            m_order.push_back(p);
+            last = p;
+
+            for (const SEdge& edge : m_edges)
+            {
+                if (edge.from != p || !m_passes[edge.to].alive) continue;
+                if (--m_indegree[edge.to] == 0)
+                {
+                    m_ready.insert(std::lower_bound(m_ready.begin(), m_ready.end(), edge.to), edge.to);
+                }
+            }
+        }
+    }
+
+    // Durées de vie, usages et images physiques des transitoires
+    bool CRenderGraph::realizeTransients()
+    {
+        for (SResource& resource : m_resources)
+        {
+            resource.firstOrder = NONE;
+            resource.lastOrder = 0;
+            resource.usage = resource.desc.usage;
+        }
+
+        for (U32 k = 0; k < m_order.size(); ++k)
+        {
+            const SPass& pass = m_passes[m_order[k]];
+            for (U32 i = 0; i < pass.useCount; ++i)
+            {
+                const SUse& use = m_uses[m_passUses[pass.useBegin + i]];
+                SResource& resource = m_resources[use.resource];
+                if (resource.firstOrder == NONE) resource.firstOrder = k;
+                resource.lastOrder = k;
+                resource.usage |= s_accessInfos[use.access].usage;
+            }
+        }
+
+        // Une image par transitoire vivante, dans l'ordre de déclaration
+        Vector<SPhysicalImage> images;
+        for (SResource& resource : m_resources)
+        {
+            resource.physical = NONE;
+            if (resource.imported || resource.firstOrder == NONE) continue;
+
+            SPhysicalImage image{};
+            image.desc = resource.desc;
+            image.usage = resource.usage;
+            image.firstOrder = resource.firstOrder;
+            image.lastOrder = resource.lastOrder;
+            resource.physical = (U32)images.size();
+            images.push_back(image);
+        }
+
+        // Mêmes images et même placement : on garde celles de la compilation précédente
+        bool reuse = images.size() == m_physical.size();
+        for (U32 i = 0; reuse && i < images.size(); ++i)
+        {
+            reuse = sameDesc(images[i].desc, m_physical[i].desc) && images[i].usage == m_physical[i].usage;
+            images[i].requirements = m_physical[i].requirements;
+        }
+
+        Vector<SHeap> heaps;
+        if (reuse)
+        {
+            placeTransients(images, heaps);
+            reuse = heaps.size() == m_heaps.size();
+            for (U32 i = 0; reuse && i < heaps.size(); ++i)
+            {
+                reuse = heaps[i].memoryTypeBits == m_heaps[i].memoryTypeBits && heaps[i].size == m_heaps[i].size;
+            }
+            for (U32 i = 0; reuse && i < images.size(); ++i)
+            {
+                reuse = images[i].heap == m_physical[i].heap && images[i].offset == m_physical[i].offset;
+            }
+        }
+
+        if (!reuse)
+        {
+            // Les frames en vol utilisent encore les anciennes images
+            if (!m_physical.empty())
+            {
+                vkDeviceWaitIdle(m_device->getDevice());
+                destroyPhysical(m_physical, m_heaps);
+            }
+
+            for (SPhysicalImage& image : images)
+            {
+                image.image = VK_NULL_HANDLE;
+                image.view = VK_NULL_HANDLE;
+            }
+            heaps.clear();
+
+            if (!createPhysical(images, heaps)) return false;
+            m_physical.swap(images);
+            m_heaps.swap(heaps);
+            ++m_stats.physicalRebuilds;
+        }
+
+        m_stats.transientImages = (U32)m_physical.size();
+        for (const SHeap& heap : m_heaps) m_stats.transientBytes += heap.size;
+        for (const SPhysicalImage& image : m_physical) m_stats.unaliasedBytes += alignUp(image.requirements.size, image.requirements.alignment);
+
+        for (SResource& resource : m_resources)
+        {
+            if (resource.physical == NONE) continue;
+            resource.image = m_physical[resource.physical].image;
+            resource.view = m_physical[resource.physical].view;
+        }
+
+        if (!reuse)
+        {
+            INGA_LOG(eINFO, "VULKAN", "Render graph: %u transient images in %u heaps, %llu KB (%llu KB without aliasing).",
+                     m_stats.transientImages, (U32)m_heaps.size(),
+                     (unsigned long long)(m_stats.transientBytes >> 10), (unsigned long long)(m_stats.unaliasedBytes >> 10));
+        }
+        return true;
+    }
+
+    // Un tas par memoryTypeBits ; les plus grosses d'abord, au plus petit décalage libre pendant leur vie
+    void CRenderGraph::placeTransients(Vector<SPhysicalImage>& images, Vector<SHeap>& heaps) const
+    {
+        heaps.clear();
+
+        Vector<U32> sorted(images.size());
+        for (U32 i = 0; i < images.size(); ++i) sorted[i] = i;
+        std::sort(sorted.begin(), sorted.end(), [&images](U32 a, U32 b)
+        {
+            if (images[a].requirements.size != images[b].requirements.size) return images[a].requirements.size > images[b].requirements.size;
+            return a < b;
+        });
+
+        for (U32 s = 0; s < sorted.size(); ++s)
+        {
+            SPhysicalImage& image = images[sorted[s]];
+            const VkMemoryRequirements& req = image.requirements;
+
+            U32 h = 0;
+            while (h < heaps.size() && heaps[h].memoryTypeBits != req.memoryTypeBits) ++h;
+            if (h == heaps.size()) heaps.push_back({ req.memoryTypeBits, 0, 1, SGpuAllocation() });
+
+            // Repousse l'offset derrière chaque image placée qui le chevauche en mémoire et dans le temps
+            VkDeviceSize offset = 0;
+            bool moved = true;
+            while (moved)
+            {
+                moved = false;
+                for (U32 t = 0; t < s; ++t)
+                {
+                    const SPhysicalImage& other = images[sorted[t]];
+                    if (other.heap != h) continue;
+                    if (other.lastOrder < image.firstOrder || image.lastOrder < other.firstOrder) continue;
+                    if (offset >= other.offset + other.requirements.size || other.offset >= offset + req.size) continue;
+
+                    offset = alignUp(other.offset + other.requirements.size, req.alignment);
+                    moved = true;
+                }
+            }
+
+            image.heap = h;
+            image.offset = offset;
+            if (offset + req.size > heaps[h].size) heaps[h].size = offset + req.size;
+            if (req.alignment > heaps[h].alignment) heaps[h].alignment = req.alignment;
+        }
+    }
+
+    bool CRenderGraph::createPhysical(Vector<SPhysicalImage>& images, Vector<SHeap>& heaps)
+    {
+        VkDevice device = m_device->getDevice();
+        CGpuMemoryAllocator& allocator = m_device->getMemoryAllocator();
+
+        for (SPhysicalImage& image : images)
+        {
+            VkImageCreateInfo info = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+            info.imageType = VK_IMAGE_TYPE_2D;
+            info.format = image.desc.format;
+            info.extent = { image.desc.extent.width, image.desc.extent.height, 1 };
+            info.mipLevels = image.desc.mipLevels;
+            info.arrayLayers = 1;
+            info.samples = image.desc.samples;
+            info.tiling = VK_IMAGE_TILING_OPTIMAL;
+            info.usage = image.usage;
+            info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            if (vkCreateImage(device, &info, nullptr, &image.image) != VK_SUCCESS)
+            {
+                INGA_LOG(eERROR, "VULKAN", "Render graph: failed to create transient image %ux%u.",
+                         image.desc.extent.width, image.desc.extent.height);
+                image.image = VK_NULL_HANDLE;
+                destroyPhysical(images, heaps);
+                return false;
+            }
+            vkGetImageMemoryRequirements(device, image.image, &image.requirements);
+        }
+
+        placeTransients(images, heaps);
+
+        for (SHeap& heap : heaps)
+        {
+            VkMemoryRequirements requirements = { heap.size, heap.alignment, heap.memoryTypeBits };
+            if (!allocator.allocate(requirements, eGPU_MEMORY_DEVICE, false, heap.allocation))
+            {
+                INGA_LOG(eERROR, "VULKAN", "Render graph: failed to allocate %llu KB of transient memory.",
+                         (unsigned long long)(heap.size >> 10));
+                destroyPhysical(images, heaps);
+                return false;
+            }
+        }
+
+        for (SPhysicalImage& image : images)
+        {
+            const SHeap& heap = heaps[image.heap];
+            if (vkBindImageMemory(device, image.image, heap.allocation.memory, heap.allocation.offset + image.offset) != VK_SUCCESS)
+            {
+                INGA_LOG(eERROR, "VULKAN", "Render graph: vkBindImageMemory failed.");
+                destroyPhysical(images, heaps);
+                return false;
+            }
+
+            VkImageViewCreateInfo viewInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+            viewInfo.image = image.image;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = image.desc.format;
+            viewInfo.subresourceRange = { aspectOf(image.desc.format), 0, image.desc.mipLevels, 0, 1 };
+            if (vkCreateImageView(device, &viewInfo, nullptr, &image.view) != VK_SUCCESS)
+            {
+                INGA_LOG(eERROR, "VULKAN", "Render graph: failed to create transient image view.");
+                image.view = VK_NULL_HANDLE;
+                destroyPhysical(images, heaps);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void CRenderGraph::destroyPhysical(Vector<SPhysicalImage>& images, Vector<SHeap>& heaps)
+    {
+        VkDevice device = m_device->getDevice();
+        for (SPhysicalImage& image : images)
+        {
+            if (image.view != VK_NULL_HANDLE) vkDestroyImageView(device, image.view, nullptr);
+            if (image.image != VK_NULL_HANDLE) vkDestroyImage(device, image.image, nullptr);
+            image.view = VK_NULL_HANDLE;
+            image.image = VK_NULL_HANDLE;
+        }
+        for (SHeap& heap : heaps)
+        {
+            if (heap.allocation.isValid()) m_device->getMemoryAllocator().free(heap.allocation);
+        }
+        images.clear();
+        heaps.clear();
+    }
+
+    void CRenderGraph::addImageBarrier(const SResource& resource, VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+                                       VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess, VkImageLayout oldLayout, VkImageLayout newLayout)
+    {
+        VkImageMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+        barrier.srcStageMask = srcStage;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstStageMask = dstStage;
+        barrier.dstAccessMask = dstAccess;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = resource.image;
+        barrier.subresourceRange = { aspectOf(resource.desc.format), 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS };
+        m_imageBarriers.push_back(barrier);
+    }
+
+    /*
+     * Un état par ressource, mis à jour dans l'ordre d'exécution :
+     *  - écriture : attend les écritures et lectures précédentes (WAW / WAR) ;
+     *  - lecture : rend visible la dernière écriture à toutes les lectures
+     *    suivantes de même layout d'un coup (elles n'ont plus de barrière) ;
+     *  - première écriture d'une transitoire : part d'UNDEFINED et attend les
+     *    derniers usages des images qui partagent sa mémoire, dans ce graphe et
+     *    dans le précédent si les images sont gardées (retenus sur l'image
+     *    physique : une barrière couvre tout ce qui a été soumis avant).
+     */
+    void CRenderGraph::computeBarriers()
+    {
+        struct SState
+        {
+            VkImageLayout         layout;
+            VkPipelineStageFlags2 writeStages;
+            VkAccessFlags2        writeAccess;
+            VkPipelineStageFlags2 readStages;
+            bool                  hasContent;
+        };
+
+        const U32 resourceCount = (U32)m_resources.size();
+        m_imageBarriers.clear();
+
+        // Usages par ressource, dans l'ordre d'exécution
+        m_resourceUseBegin.assign(resourceCount + 1, 0);
+        for (U32 p : m_order)
+        {
+            const SPass& pass = m_passes[p];
+            for (U32 i = 0; i < pass.useCount; ++i) ++m_resourceUseBegin[m_uses[m_passUses[pass.useBegin + i]].resource + 1];
+        }
+        for (U32 r = 0; r < resourceCount; ++r) m_resourceUseBegin[r + 1] += m_resourceUseBegin[r];
+
+        m_resourceUses.resize(m_resourceUseBegin[resourceCount]);
+        m_lastWriter.assign(m_resourceUseBegin.begin(), m_resourceUseBegin.end() - 1);     // curseurs
+        for (U32 p : m_order)
+        {
+            const SPass& pass = m_passes[p];
+            for (U32 i = 0; i < pass.useCount; ++i)
+            {
+                const U32 u = m_passUses[pass.useBegin + i];
+                m_resourceUses[m_lastWriter[m_uses[u].resource]++] = u;
+            }
+        }
+
+        // Derniers usages : étapes des lectures finales et de l'écriture qui les précède
+        for (SResource& resource : m_resources)
+        {
+            resource.lastStages = VK_PIPELINE_STAGE_2_NONE;
+            resource.lastWrites = VK_ACCESS_2_NONE;
+        }
+        for (U32 r = 0; r < resourceCount; ++r)
+        {
+            for (U32 i = m_resourceUseBegin[r + 1]; i-- > m_resourceUseBegin[r];)
+            {
+                const SUse& use = m_uses[m_resourceUses[i]];
+                const SAccessInfo info = accessInfo(use.access, m_passes[use.pass].type);
+                m_resources[r].lastStages |= info.stages;
+                if (info.write)
+                {
+                    m_resources[r].lastWrites = info.access & WRITE_ACCESS_MASK;
+                    break;
+                }
+            }
+        }
+
+        Vector<SState> states(resourceCount);
+        for (U32 r = 0; r < resourceCount; ++r)
+        {
+            const SResource& resource = m_resources[r];
+            SState& state = states[r];
+            state.readStages = VK_PIPELINE_STAGE_2_NONE;
+
+            if (resource.imported)
+            {
+                state.layout = resource.initial.layout;
+                state.writeStages = resource.initial.stageMask;
+                state.writeAccess = resource.initial.accessMask & WRITE_ACCESS_MASK;
+                state.hasContent = resource.isBuffer || resource.initial.layout != VK_IMAGE_LAYOUT_UNDEFINED;
+                continue;
+            }
+
+            state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            state.writeStages = VK_PIPELINE_STAGE_2_NONE;
+            state.writeAccess = VK_ACCESS_2_NONE;
+            state.hasContent = false;
+            if (resource.physical == NONE) continue;
+
+            // Alias : toutes les images dont la mémoire recouvre la sienne, elle-même comprise
+            const SPhysicalImage& image = m_physical[resource.physical];
+            for (const SResource& other : m_resources)
+            {
+                if (other.physical == NONE) continue;
+                const SPhysicalImage& otherImage = m_physical[other.physical];
+                if (otherImage.heap != image.heap) continue;
+                if (otherImage.offset >= image.offset + image.requirements.size ||
+                    image.offset >= otherImage.offset + otherImage.requirements.size) continue;
+
+                state.writeStages |= other.lastStages | otherImage.lastStages;
+                state.writeAccess |= other.lastWrites | otherImage.lastWrites;
+            }
+        }
+
+        // Sources de la prochaine compilation si elle garde ces images (images neuves : rien)
+        for (const SResource& resource : m_resources)
+        {
+            if (resource.physical == NONE) continue;
+            m_physical[resource.physical].lastStages = resource.lastStages;
+            m_physical[resource.physical].lastWrites = resource.lastWrites;
+        }
+
+        m_covered.assign(m_resourceUses.size(), 0);
+        m_lastWriter.assign(m_resourceUseBegin.begin(), m_resourceUseBegin.end() - 1);     // curseurs
+
+        for (U32 p : m_order)
+        {
+            SPass& pass = m_passes[p];
+            pass.barrierBegin = (U32)m_imageBarriers.size();
+            pass.memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+            pass.hasMemoryBarrier = false;
+
+            for (U32 i = 0; i < pass.useCount; ++i)
+            {
+                SUse& use = m_uses[m_passUses[pass.useBegin + i]];
+                const U32 r = use.resource;
+                const U32 position = m_lastWriter[r]++;
+                SResource& resource = m_resources[r];
+                SState& state = states[r];
+                const SAccessInfo info = accessInfo(use.access, pass.type);
+
+                const bool laterUse = position + 1 < m_resourceUseBegin[r + 1];
+                if (use.access == eACCESS_DEPTH_READ)
+                {
+                    // Lecture seule : LOAD et STORE_OP_NONE n'écrivent pas, l'accès reste une lecture
+                    use.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+                    use.storeOp = VK_ATTACHMENT_STORE_OP_NONE;
+                }
+                else
+                {
+                    use.storeOp = (!resource.imported && !laterUse) ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+                    use.loadOp = use.clear ? VK_ATTACHMENT_LOAD_OP_CLEAR
+                                           : (state.hasContent ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+                }
+
+                if (m_covered[position]) continue;
+
+                VkPipelineStageFlags2 srcStage;
+                VkAccessFlags2 srcAccess = state.writeAccess;
+                VkPipelineStageFlags2 dstStage = info.stages;
+                VkAccessFlags2 dstAccess = info.access;
+                VkImageLayout oldLayout = state.layout;
+
+                if (info.write)
+                {
+                    srcStage = state.writeStages | state.readStages;
+                    if (!state.hasContent || use.clear) oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+                    state.writeStages = info.stages;
+                    state.writeAccess = info.access & WRITE_ACCESS_MASK;
+                    state.readStages = VK_PIPELINE_STAGE_2_NONE;
+                    state.hasContent = true;
+                }
+                else
+                {
+                    const bool layoutChange = !resource.isBuffer && state.layout != info.layout;
+                    srcStage = state.writeStages | (layoutChange ? state.readStages : VK_PIPELINE_STAGE_2_NONE);
+
+                    // Lectures suivantes jusqu'à la prochaine écriture ou un autre layout
+                    for (U32 j = position + 1; j < m_resourceUseBegin[r + 1]; ++j)
+                    {
+                        const SUse& next = m_uses[m_resourceUses[j]];
+                        const SAccessInfo nextInfo = accessInfo(next.access, m_passes[next.pass].type);
+                        if (nextInfo.write || (!resource.isBuffer && nextInfo.layout != info.layout)) break;
+
+                        dstStage |= nextInfo.stages;
+                        dstAccess |= nextInfo.access;
+                        m_covered[j] = 1;
+                    }
+
+                    // Écriture déjà visible et layout en place : rien à faire
+                    if (srcStage == VK_PIPELINE_STAGE_2_NONE && !layoutChange)
+                    {
+                        state.readStages |= dstStage;
+                        continue;
+                    }
+
+                    state.writeStages = VK_PIPELINE_STAGE_2_NONE;
+                    state.writeAccess = VK_ACCESS_2_NONE;
+                    state.readStages |= dstStage;
+                }
+
+                if (resource.isBuffer)
+                {
+                    if (srcStage == VK_PIPELINE_STAGE_2_NONE) continue;
+                    pass.memoryBarrier.srcStageMask |= srcStage;
+                    pass.memoryBarrier.srcAccessMask |= srcAccess;
+                    pass.memoryBarrier.dstStageMask |= dstStage;
+                    pass.memoryBarrier.dstAccessMask |= dstAccess;
+                    pass.hasMemoryBarrier = true;
+                    continue;
+                }
+
+                addImageBarrier(resource, srcStage, srcAccess, dstStage, dstAccess, oldLayout, info.layout);
+                state.layout = info.layout;
+            }
+
+            pass.barrierCount = (U32)m_imageBarriers.size() - pass.barrierBegin;
+            if (pass.barrierCount > 0 || pass.hasMemoryBarrier) ++m_stats.barrierBatches;
+            if (pass.hasMemoryBarrier) ++m_stats.memoryBarriers;
+        }
+
+        // Sorties : les images importées rejoignent leur état final
+        m_finalBarrierBegin = (U32)m_imageBarriers.size();
+        for (U32 r = 0; r < resourceCount; ++r)
+        {
+            const SResource& resource = m_resources[r];
+            if (!resource.imported || resource.isBuffer) continue;
+
+            const SState& state = states[r];
+            const VkImageLayout finalLayout = resource.final.layout != VK_IMAGE_LAYOUT_UNDEFINED ? resource.final.layout : state.layout;
+            if (finalLayout == state.layout && resource.final.stageMask == VK_PIPELINE_STAGE_2_NONE) continue;
+
+            addImageBarrier(resource, state.writeStages | state.readStages, state.writeAccess,
+                            resource.final.stageMask, resource.final.accessMask, state.layout, finalLayout);
+        }
+        if (m_imageBarriers.size() > m_finalBarrierBegin) ++m_stats.barrierBatches;
+        m_stats.imageBarriers = (U32)m_imageBarriers.size();
+    }
+
+    void CRenderGraph::execute(VkCommandBuffer cmd)
+    {
+        INGA_PROFILE_ZONE("CRenderGraph::execute");
+
+        if (!m_compiled)
+        {
+            INGA_LOG(eWARNING, "VULKAN", "Render graph: execute() without a successful compile().");
+            return;
+        }
+
+        for (U32 p : m_order)
+        {
+            const SPass& pass = m_passes[p];
+
+            if (pass.barrierCount > 0 || pass.hasMemoryBarrier)
+            {
+                VkDependencyInfo dependency = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+                dependency.memoryBarrierCount = pass.hasMemoryBarrier ? 1 : 0;
+                dependency.pMemoryBarriers = &pass.memoryBarrier;
+                dependency.imageMemoryBarrierCount = pass.barrierCount;
+                dependency.pImageMemoryBarriers = m_imageBarriers.data() + pass.barrierBegin;
+                vkCmdPipelineBarrier2(cmd, &dependency);
+            }
+
+            // Passe graphics : rendu dynamique sur ses attachments
+            VkRenderingAttachmentInfo colors[MAX_COLOR_ATTACHMENTS];
+            VkRenderingAttachmentInfo depth = { VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO };
+            U32 colorCount = 0;
+            bool hasDepth = false;
+            VkExtent2D area = { 0, 0 };
+
+            if (pass.type == eRENDER_PASS_GRAPHICS)
+            {
+                for (U32 i = 0; i < pass.useCount; ++i)
+                {
+                    const SUse& use = m_uses[m_passUses[pass.useBegin + i]];
+                    if (!isAttachment(use.access)) continue;
+
+                    const SResource& resource = m_resources[use.resource];
+                    VkRenderingAttachmentInfo attachment = { VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO };
+                    attachment.imageView = resource.view;
+                    attachment.imageLayout = s_accessInfos[use.access].layout;
+                    attachment.loadOp = use.loadOp;
+                    attachment.storeOp = use.storeOp;
+                    attachment.clearValue = use.clearValue;
+
+                    if (use.access == eACCESS_COLOR_ATTACHMENT)
+                    {
+                        if (colorCount == MAX_COLOR_ATTACHMENTS) continue;
+                        colors[colorCount++] = attachment;
+                    }
+                    else
+                    {
+                        depth = attachment;
+                        hasDepth = true;
+                    }
+                    if (area.width == 0) area = resource.desc.extent;
+                }
+            }
+
+            const bool rendering = colorCount > 0 || hasDepth;
+            if (rendering)
+            {
+                VkRenderingInfo renderingInfo = { VK_STRUCTURE_TYPE_RENDERING_INFO };
+                renderingInfo.renderArea = { { 0, 0 }, area };
+                renderingInfo.layerCount = 1;
+                renderingInfo.colorAttachmentCount = colorCount;
+                renderingInfo.pColorAttachments = colors;
+                renderingInfo.pDepthAttachment = hasDepth ? &depth : nullptr;
+                vkCmdBeginRendering(cmd, &renderingInfo);
+            }
+
+            if (pass.callback) pass.callback(cmd, *this, pass.userData);
+
+            if (rendering) vkCmdEndRendering(cmd);
+        }
+
+        const U32 finalCount = (U32)m_imageBarriers.size() - m_finalBarrierBegin;
+        if (finalCount > 0)
+        {
+            VkDependencyInfo dependency = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+            dependency.imageMemoryBarrierCount = finalCount;
+            dependency.pImageMemoryBarriers = m_imageBarriers.data() + m_finalBarrierBegin;
+            vkCmdPipelineBarrier2(cmd, &dependency);
+        }
+    }
+
+    VkImage CRenderGraph::getImage(RenderResource resource) const
+    {
+        return resource < m_resources.size() ? m_resources[resource].image : VK_NULL_HANDLE;
+    }
+
+    VkImageView CRenderGraph::getImageView(RenderResource resource) const
+    {
+        return resource < m_resources.size() ? m_resources[resource].view : VK_NULL_HANDLE;
+    }
+
+    VkBuffer CRenderGraph::getBuffer(RenderResource resource) const
+    {
+        return resource < m_resources.size() ? m_resources[resource].buffer : VK_NULL_HANDLE;
+    }
+
+    VkExtent2D CRenderGraph::getExtent(RenderResource resource) const
+    {
+        return resource < m_resources.size() ? m_resources[resource].desc.extent : VkExtent2D{ 0, 0 };
+    }
+}
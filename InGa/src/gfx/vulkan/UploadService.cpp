@@ -0,0 +1,670 @@
+#include <InGa/gfx/UploadService.h>
+#include <InGa/gfx/RenderDevice.h>
+#include <InGa/core/log.h>
+#include <cstring>
+
+namespace Inga
+{
+    static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Alignement quelconque (texels de 3, 6, 12 octets) : pas de masque possible
+    static VkDeviceSize roundUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static VkDeviceSize gcd(VkDeviceSize a, VkDeviceSize b)
+    {
+        while (b != 0)
+        {
+            const VkDeviceSize r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    CUploadService::~CUploadService()
+    {
+        if (m_device) shutdown();
+    }
+
+    bool CUploadService::initialize(CRenderDevice* device, VkDeviceSize stagingSize)
+    {
+        if (!device || device->getDevice() == VK_NULL_HANDLE) return false;
+
+        m_device = device;
+        m_vkDevice = device->getDevice();
+        m_transferFamily = device->getTransferQueueFamily();
+        m_graphicsFamily = device->getGraphicsQueueFamily();
+
+        // Alignement de base des copies (puissance de 2) ; les images y ajoutent leur taille de texel
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(device->getPhysicalDevice(), &props);
+        m_alignment = 16;
+        while (m_alignment < props.limits.optimalBufferCopyOffsetAlignment) m_alignment <<= 1;
+
+        m_stagingSize = alignUp(stagingSize, m_alignment > 256 ? m_alignment : 256);
+        m_writeCursor = 0;
+        m_retiredCursor = 0;
+        m_submittedValue = 0;
+        m_completedValue = 0;
+        m_current = 0;
+        m_oldest = 0;
+        m_batchBytes = 0;
+        m_stats = SUploadStats{};
+
+        VkSemaphoreTypeCreateInfo typeInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+        semInfo.pNext = &typeInfo;
+        if (vkCreateSemaphore(m_vkDevice, &semInfo, nullptr, &m_timeline) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Upload service: failed to create timeline semaphore.");
+            shutdown();
+            return false;
+        }
+
+        VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferInfo.size = m_stagingSize;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!device->getMemoryAllocator().createBuffer(bufferInfo, eGPU_MEMORY_UPLOAD, m_staging, m_stagingAllocation) ||
+            !m_stagingAllocation.mapped)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Upload service: failed to create %llu MB staging ring.", (unsigned long long)(m_stagingSize >> 20));
+            shutdown();
+            return false;
+        }
+
+        // Un pool TRANSIENT par lot : remis à zéro d'un bloc quand le lot est réutilisé
+        for (U32 i = 0; i < MAX_BATCHES; ++i)
+        {
+            SBatch& batch = m_batches[i];
+
+            VkCommandPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = m_transferFamily;
+            if (vkCreateCommandPool(m_vkDevice, &poolInfo, nullptr, &batch.pool) != VK_SUCCESS)
+            {
+                INGA_LOG(eERROR, "VULKAN", "Upload service: failed to create command pool.");
+                shutdown();
+                return false;
+            }
+
+            VkCommandBufferAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+            allocInfo.commandPool = batch.pool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount = 1;
+            vkAllocateCommandBuffers(m_vkDevice, &allocInfo, &batch.cmd);
+        }
+
+        INGA_LOG(eINFO, "VULKAN", "Upload service ready: %llu MB staging ring on queue family %u (%s).",
+                 (unsigned long long)(m_stagingSize >> 20), m_transferFamily,
+                 m_transferFamily != m_graphicsFamily ? "dedicated" : "shared with graphics");
+        return true;
+    }
+
+    void CUploadService::shutdown()
+    {
+        if (!m_device) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_timeline != VK_NULL_HANDLE && m_submittedValue > m_completedValue)
+        {
+            VkSemaphoreWaitInfo waitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &m_timeline;
+            waitInfo.pValues = &m_submittedValue;
+            vkWaitSemaphores(m_vkDevice, &waitInfo, ~0ull);
+        }
+
+        for (U32 i = 0; i < MAX_BATCHES; ++i)
+        {
+            SBatch& batch = m_batches[i];
+            if (batch.pool != VK_NULL_HANDLE) vkDestroyCommandPool(m_vkDevice, batch.pool, nullptr);
+            batch = SBatch();
+        }
+
+        CGpuMemoryAllocator& memory = m_device->getMemoryAllocator();
+        for (STemporaryBuffer& temporary : m_temporaryBuffers) memory.destroyBuffer(temporary.buffer, temporary.allocation);
+        if (m_staging != VK_NULL_HANDLE) memory.destroyBuffer(m_staging, m_stagingAllocation);
+
+        if (m_timeline != VK_NULL_HANDLE) vkDestroySemaphore(m_vkDevice, m_timeline, nullptr);
+        m_timeline = VK_NULL_HANDLE;
+
+        // Rend aussi la capacité : les Vector vivent dans l'allocateur moteur
+        Vector<VkBufferCopy>().swap(m_copyRegions);
+        Vector<VkBufferMemoryBarrier2>().swap(m_releaseBuffers);
+        Vector<VkImageMemoryBarrier2>().swap(m_releaseImages);
+        Vector<SBufferWrite>().swap(m_batchWrites);
+        Vector<SAcquire>().swap(m_recordedAcquires);
+        Vector<SAcquire>().swap(m_pendingAcquires);
+        Vector<STemporaryBuffer>().swap(m_temporaryBuffers);
+
+        m_copyDst = VK_NULL_HANDLE;
+        m_device = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    U64 CUploadService::uploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size, const SUploadTarget& target)
+    {
+        if (!m_device || dst == VK_NULL_HANDLE || !data || size == 0) return 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        collectLocked();
+
+        // Réserver d'abord : un anneau plein peut soumettre le lot en cours
+        VkDeviceSize srcOffset = 0;
+        STemporaryBuffer temporary{};
+        const bool useRing = size <= m_stagingSize / 2 && reserve(size, m_alignment, srcOffset);
+        if (useRing)
+        {
+            memcpy((U8*)m_stagingAllocation.mapped + srcOffset, data, (size_t)size);
+        }
+        else
+        {
+            VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+            bufferInfo.size = size;
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            if (!m_device->getMemoryAllocator().createBuffer(bufferInfo, eGPU_MEMORY_UPLOAD, temporary.buffer, temporary.allocation))
+            {
+                return 0;
+            }
+            memcpy(temporary.allocation.mapped, data, (size_t)size);
+        }
+
+        SBatch* batch = beginBatch();
+        if (!batch)
+        {
+            if (!useRing) m_device->getMemoryAllocator().destroyBuffer(temporary.buffer, temporary.allocation);
+            return 0;
+        }
+        const U64 token = m_submittedValue + 1;
+
+        // Réécrire une plage déjà copiée dans ce lot : la seconde copie doit attendre la première
+        bool overlaps = false;
+        for (const SBufferWrite& write : m_batchWrites)
+        {
+            if (write.buffer == dst && dstOffset < write.offset + write.size && write.offset < dstOffset + size) overlaps = true;
+        }
+        if (overlaps)
+        {
+            flushCopies();
+
+            VkMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+            VkDependencyInfo dependency = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+            dependency.memoryBarrierCount = 1;
+            dependency.pMemoryBarriers = &barrier;
+            vkCmdPipelineBarrier2(batch->cmd, &dependency);
+        }
+        m_batchWrites.push_back(SBufferWrite{ dst, dstOffset, size });
+
+        if (useRing)
+        {
+            if (m_copyDst != dst) flushCopies();
+            m_copyDst = dst;
+            VkBufferCopy* last = m_copyRegions.empty() ? nullptr : &m_copyRegions.back();
+            if (last && last->srcOffset + last->size == srcOffset && last->dstOffset + last->size == dstOffset)
+            {
+                last->size += size;
+            }
+            else
+            {
+                m_copyRegions.push_back(VkBufferCopy{ srcOffset, dstOffset, size });
+            }
+        }
+        else
+        {
+            flushCopies();
+            VkBufferCopy region = { 0, dstOffset, size };
+            vkCmdCopyBuffer(batch->cmd, temporary.buffer, dst, 1, &region);
+
+            temporary.token = token;
+            m_temporaryBuffers.push_back(temporary);
+            ++m_stats.temporaryBuffers;
+        }
+
+        SAcquire acquire{};
+        acquire.token = token;
+        acquire.queueFamily = resolveFamily(target);
+        acquire.isImage = false;
+        acquire.needsBarrier = acquire.queueFamily != m_transferFamily;
+
+        if (acquire.needsBarrier)
+        {
+            VkBufferMemoryBarrier2 release = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2 };
+            release.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            release.srcQueueFamilyIndex = m_transferFamily;
+            release.dstQueueFamilyIndex = acquire.queueFamily;
+            release.buffer = dst;
+            release.offset = dstOffset;
+            release.size = size;
+            m_releaseBuffers.push_back(release);
+
+            acquire.buffer = release;
+            acquire.buffer.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+            acquire.buffer.srcAccessMask = VK_ACCESS_2_NONE;
+            acquire.buffer.dstStageMask = target.stageMask;
+            acquire.buffer.dstAccessMask = target.accessMask;
+        }
+        m_recordedAcquires.push_back(acquire);
+
+        m_stats.bytesUploaded += size;
+        m_batchBytes += size;
+        if (m_batchBytes >= m_stagingSize / 4) submitBatch();
+        return token;
+    }
+
+    U64 CUploadService::uploadImage(const SImageUpload& region, const void* data, VkDeviceSize size, const SUploadTarget& target)
+    {
+        if (!m_device || region.image == VK_NULL_HANDLE || !data || size == 0) return 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        collectLocked();
+
+        // bufferOffset d'une copie vers image : multiple de 4 et de la taille d'un texel / bloc,
+        // soit ppcm(alignement de base, taille du texel) (48 pour du RGB8 ou du RGB32F)
+        const VkDeviceSize texelBlockSize = region.texelBlockSize ? region.texelBlockSize : 16;
+        const VkDeviceSize alignment = m_alignment / gcd(m_alignment, texelBlockSize) * texelBlockSize;
+
+        VkDeviceSize srcOffset = 0;
+        STemporaryBuffer temporary{};
+        const bool useRing = size <= m_stagingSize / 2 && reserve(size, alignment, srcOffset);
+        if (useRing)
+        {
+            memcpy((U8*)m_stagingAllocation.mapped + srcOffset, data, (size_t)size);
+        }
+        else
+        {
+            VkBufferCreateInfo bufferInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+            bufferInfo.size = size;
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            if (!m_device->getMemoryAllocator().createBuffer(bufferInfo, eGPU_MEMORY_UPLOAD, temporary.buffer, temporary.allocation))
+            {
+                return 0;
+            }
+            memcpy(temporary.allocation.mapped, data, (size_t)size);
+        }
+
+        SBatch* batch = beginBatch();
+        if (!batch)
+        {
+            if (!useRing) m_device->getMemoryAllocator().destroyBuffer(temporary.buffer, temporary.allocation);
+            return 0;
+        }
+        const U64 token = m_submittedValue + 1;
+        flushCopies();
+
+        const VkImageSubresourceRange range = { region.aspectMask, region.mipLevel, 1, region.baseArrayLayer, region.layerCount };
+
+        // UNDEFINED : le contenu est remplacé, pas de dépendance avec un usage précédent
+        VkImageMemoryBarrier2 toTransfer = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+        toTransfer.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        toTransfer.srcAccessMask = VK_ACCESS_2_NONE;
+        toTransfer.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = region.image;
+        toTransfer.subresourceRange = range;
+
+        VkDependencyInfo dependency = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+        dependency.imageMemoryBarrierCount = 1;
+        dependency.pImageMemoryBarriers = &toTransfer;
+        vkCmdPipelineBarrier2(batch->cmd, &dependency);
+
+        VkBufferImageCopy copy{};
+        copy.bufferOffset = useRing ? srcOffset : 0;
+        copy.bufferRowLength = region.bufferRowLength;
+        copy.bufferImageHeight = region.bufferImageHeight;
+        copy.imageSubresource = { region.aspectMask, region.mipLevel, region.baseArrayLayer, region.layerCount };
+        copy.imageOffset = region.offset;
+        copy.imageExtent = region.extent;
+        vkCmdCopyBufferToImage(batch->cmd, useRing ? m_staging : temporary.buffer, region.image,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+
+        if (!useRing)
+        {
+            temporary.token = token;
+            m_temporaryBuffers.push_back(temporary);
+            ++m_stats.temporaryBuffers;
+        }
+
+        SAcquire acquire{};
+        acquire.token = token;
+        acquire.queueFamily = resolveFamily(target);
+        acquire.isImage = true;
+        acquire.needsBarrier = acquire.queueFamily != m_transferFamily;
+
+        // La transition vers finalLayout est faite ici ; entre familles, la release et
+        // l'acquire doivent porter la même transition
+        VkImageMemoryBarrier2 release = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+        release.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        release.dstStageMask = acquire.needsBarrier ? VK_PIPELINE_STAGE_2_NONE : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        release.dstAccessMask = VK_ACCESS_2_NONE;
+        release.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        release.newLayout = region.finalLayout;
+        release.srcQueueFamilyIndex = acquire.needsBarrier ? m_transferFamily : VK_QUEUE_FAMILY_IGNORED;
+        release.dstQueueFamilyIndex = acquire.needsBarrier ? acquire.queueFamily : VK_QUEUE_FAMILY_IGNORED;
+        release.image = region.image;
+        release.subresourceRange = range;
+        m_releaseImages.push_back(release);
+
+        if (acquire.needsBarrier)
+        {
+            acquire.image = release;
+            acquire.image.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+            acquire.image.srcAccessMask = VK_ACCESS_2_NONE;
+            acquire.image.dstStageMask = target.stageMask;
+            acquire.image.dstAccessMask = target.accessMask;
+        }
+        m_recordedAcquires.push_back(acquire);
+
+        m_stats.bytesUploaded += size;
+        m_batchBytes += size;
+        if (m_batchBytes >= m_stagingSize / 4) submitBatch();
+        return token;
+    }
+
+    U64 CUploadService::flush()
+    {
+        if (!m_device) return 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        submitBatch();
+        return m_submittedValue;
+    }
+
+    bool CUploadService::isComplete(U64 token)
+    {
+        if (!m_device) return true;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (token <= m_completedValue) return true;
+        collectLocked();
+        return token <= m_completedValue;
+    }
+
+    bool CUploadService::wait(U64 token, U64 timeoutNs)
+    {
+        if (!m_device) return true;
+
+        VkSemaphore timeline = VK_NULL_HANDLE;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (token <= m_completedValue) return true;
+            if (token > m_submittedValue) submitBatch();     // le jeton est dans le lot en cours
+            if (token > m_submittedValue) return false;
+            timeline = m_timeline;
+        }
+
+        // Attente hors verrou : les autres threads continuent d'uploader
+        VkSemaphoreWaitInfo waitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &token;
+        const bool done = vkWaitSemaphores(m_vkDevice, &waitInfo, timeoutNs) == VK_SUCCESS;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        collectLocked();
+        return done;
+    }
+
+    U64 CUploadService::recordAcquireBarriers(VkCommandBuffer cmd, U32 queueFamily)
+    {
+        if (!m_device) return 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        U64 waitValue = 0;
+        Vector<VkBufferMemoryBarrier2> buffers;
+        Vector<VkImageMemoryBarrier2> images;
+
+        for (U32 i = 0; i < (U32)m_pendingAcquires.size();)
+        {
+            const SAcquire& acquire = m_pendingAcquires[i];
+            if (acquire.queueFamily != queueFamily)
+            {
+                ++i;
+                continue;
+            }
+
+            if (acquire.token > waitValue) waitValue = acquire.token;
+            if (acquire.needsBarrier)
+            {
+                if (acquire.isImage) images.push_back(acquire.image);
+                else buffers.push_back(acquire.buffer);
+            }
+
+            m_pendingAcquires[i] = m_pendingAcquires.back();
+            m_pendingAcquires.pop_back();
+        }
+
+        // Une seule barrière pour toutes les acquires du lot
+        if (!buffers.empty() || !images.empty())
+        {
+            VkDependencyInfo dependency = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+            dependency.bufferMemoryBarrierCount = (U32)buffers.size();
+            dependency.pBufferMemoryBarriers = buffers.data();
+            dependency.imageMemoryBarrierCount = (U32)images.size();
+            dependency.pImageMemoryBarriers = images.data();
+            vkCmdPipelineBarrier2(cmd, &dependency);
+        }
+        return waitValue;
+    }
+
+    void CUploadService::collect()
+    {
+        if (!m_device) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        collectLocked();
+    }
+
+    SUploadStats CUploadService::getStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device) collectLocked();
+
+        m_stats.completedValue = m_completedValue;
+        m_stats.submittedValue = m_submittedValue;
+        return m_stats;
+    }
+
+    // --- Interne (m_mutex tenu) ---
+
+    CUploadService::SBatch* CUploadService::beginBatch()
+    {
+        SBatch& batch = m_batches[m_current];
+        if (batch.recording) return &batch;
+
+        // Tous les lots sont en vol : celui-ci est le plus ancien
+        if (batch.value != 0)
+        {
+            if (!waitOldestBatch()) return nullptr;
+        }
+
+        vkResetCommandPool(m_vkDevice, batch.pool, 0);
+
+        VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkBeginCommandBuffer(batch.cmd, &beginInfo) != VK_SUCCESS)
+        {
+            INGA_LOG(eERROR, "VULKAN", "Upload service: vkBeginCommandBuffer failed.");
+            return nullptr;
+        }
+
+        batch.recording = true;
+        m_batchBytes = 0;
+        return &batch;
+    }
+
+    void CUploadService::submitBatch()
+    {
+        SBatch& batch = m_batches[m_current];
+        if (!batch.recording) return;
+
+        flushCopies();
+
+        // Releases vers les autres familles et transitions finales : une seule barrière
+        if (!m_releaseBuffers.empty() || !m_releaseImages.empty())
+        {
+            VkDependencyInfo dependency = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+            dependency.bufferMemoryBarrierCount = (U32)m_releaseBuffers.size();
+            dependency.pBufferMemoryBarriers = m_releaseBuffers.data();
+            dependency.imageMemoryBarrierCount = (U32)m_releaseImages.size();
+            dependency.pImageMemoryBarriers = m_releaseImages.data();
+            vkCmdPipelineBarrier2(batch.cmd, &dependency);
+
+            m_releaseBuffers.clear();
+            m_releaseImages.clear();
+        }
+        m_batchWrites.clear();
+
+        batch.recording = false;
+        vkEndCommandBuffer(batch.cmd);
+
+        const U64 value = m_submittedValue + 1;
+
+        VkCommandBufferSubmitInfo cmdInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO };
+        cmdInfo.commandBuffer = batch.cmd;
+
+        VkSemaphoreSubmitInfo signalInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO };
+        signalInfo.semaphore = m_timeline;
+        signalInfo.value = value;
+        signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkSubmitInfo2 submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO_2 };
+        submitInfo.commandBufferInfoCount = 1;
+        submitInfo.pCommandBufferInfos = &cmdInfo;
+        submitInfo.signalSemaphoreInfoCount = 1;
+        submitInfo.pSignalSemaphoreInfos = &signalInfo;
+
+        const VkResult result = m_device->submit(eQUEUE_TRANSFER, 1, &submitInfo, VK_NULL_HANDLE);
+        if (result != VK_SUCCESS)
+        {
+            // Les jetons de ce lot ne seront jamais signalés : device perdu dans la plupart des cas
+            INGA_LOG(eERROR, "VULKAN", "Upload service: vkQueueSubmit2 failed with VkResult: %d", result);
+            m_recordedAcquires.clear();
+            return;
+        }
+
+        m_submittedValue = value;
+        batch.value = value;
+        batch.endCursor = m_writeCursor;
+
+        for (const SAcquire& acquire : m_recordedAcquires) m_pendingAcquires.push_back(acquire);
+        m_recordedAcquires.clear();
+
+        m_current = (m_current + 1) % MAX_BATCHES;
+        ++m_stats.batchesSubmitted;
+    }
+
+    void CUploadService::flushCopies()
+    {
+        if (m_copyRegions.empty()) return;
+
+        vkCmdCopyBuffer(m_batches[m_current].cmd, m_staging, m_copyDst, (U32)m_copyRegions.size(), m_copyRegions.data());
+        m_copyRegions.clear();
+        m_copyDst = VK_NULL_HANDLE;
+    }
+
+    bool CUploadService::reserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+    {
+        for (;;)
+        {
+            // L'alignement porte sur la position dans l'anneau : l'anneau n'est pas
+            // forcément multiple d'un alignement non puissance de 2 (ppcm avec 3, 6, 12...)
+            U64 cursor = m_writeCursor;
+            const VkDeviceSize ringOffset = cursor % m_stagingSize;
+            VkDeviceSize alignedOffset = roundUp(ringOffset, alignment);
+
+            // Pas de bloc à cheval sur la fin : on saute au début de l'anneau (offset 0, toujours aligné)
+            if (alignedOffset + size > m_stagingSize) alignedOffset = m_stagingSize;
+            cursor += alignedOffset - ringOffset;
+
+            if (cursor + size - m_retiredCursor <= m_stagingSize)
+            {
+                m_writeCursor = cursor + size;
+                offset = cursor % m_stagingSize;
+                return true;
+            }
+
+            // Anneau plein : attendre le plus ancien lot, quitte à soumettre celui en cours
+            ++m_stats.ringStalls;
+            if (!waitOldestBatch())
+            {
+                submitBatch();
+                if (!waitOldestBatch()) return false;
+            }
+        }
+    }
+
+    bool CUploadService::waitOldestBatch()
+    {
+        SBatch& oldest = m_batches[m_oldest];
+        if (oldest.value == 0) return false;
+
+        VkSemaphoreWaitInfo waitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_timeline;
+        waitInfo.pValues = &oldest.value;
+        if (vkWaitSemaphores(m_vkDevice, &waitInfo, ~0ull) != VK_SUCCESS) return false;
+
+        collectLocked();
+        return true;
+    }
+
+    void CUploadService::collectLocked()
+    {
+        U64 completed = m_completedValue;
+        vkGetSemaphoreCounterValue(m_vkDevice, m_timeline, &completed);
+        m_completedValue = completed;
+
+        // Les lots se terminent dans l'ordre de soumission
+        while (m_batches[m_oldest].value != 0 && m_batches[m_oldest].value <= completed)
+        {
+            SBatch& batch = m_batches[m_oldest];
+            m_retiredCursor = batch.endCursor;
+            batch.value = 0;
+            m_oldest = (m_oldest + 1) % MAX_BATCHES;
+        }
+
+        for (U32 i = 0; i < (U32)m_temporaryBuffers.size();)
+        {
+            STemporaryBuffer& temporary = m_temporaryBuffers[i];
+            if (temporary.token > completed)
+            {
+                ++i;
+                continue;
+            }
+
+            m_device->getMemoryAllocator().destroyBuffer(temporary.buffer, temporary.allocation);
+            m_temporaryBuffers[i] = m_temporaryBuffers.back();
+            m_temporaryBuffers.pop_back();
+        }
+    }
+
+    U32 CUploadService::resolveFamily(const SUploadTarget& target) const
+    {
+        return target.queueFamily == 0xFFFFFFFF ? m_graphicsFamily : target.queueFamily;
+    }
+}
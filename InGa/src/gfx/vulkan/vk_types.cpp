@@ -2,7 +2,7 @@
 
 namespace Inga
 {
-void SSwapchain::cleanup(VkDevice device)
+void SSwapchain::destroyImageResources(VkDevice device)
 {
     if (device == VK_NULL_HANDLE) return;
 
@@ -18,10 +18,24 @@ void SSwapchain::cleanup(VkDevice device)
         vkDestroySemaphore(device, m_renderFinishedSemaphores[i], nullptr);
     }
 
+    // Rend aussi la capacité : les Vector vivent dans l'allocateur moteur
+    Vector<VkImage>().swap(m_images);
+    Vector<VkImageView>().swap(m_imageViews);
+    Vector<VkSemaphore>().swap(m_renderFinishedSemaphores);
+    Vector<VkFence>().swap(m_imagesInFlight);
+}
+
+void SSwapchain::cleanup(VkDevice device)
+{
+    if (device == VK_NULL_HANDLE) return;
+
+    destroyImageResources(device);
+
     // 3. Détruire la swapchain elle-même
     if (m_handle != VK_NULL_HANDLE)
     {
         vkDestroySwapchainKHR(device, m_handle, nullptr);
+        m_handle = VK_NULL_HANDLE;
     }
     
     // Note: La surface est généralement détruite à la toute fin par le Context
@@ -0,0 +1,314 @@
+#include "bench.h"
+#include <InGa/core/perf_counters.h>
+#include <InGa/core/time.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(INGA_PLATFORM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace Inga
+{
+    static const U32 g_bench_max_samples = 256;
+
+    // Rempli par les constructeurs statiques : pas d'allocation avant main()
+    static BenchDesc g_benchmarks[Bench::MAX_BENCHMARKS];
+    static U32 g_benchmark_count = 0;
+
+    static U32 g_failure_count = 0;
+
+    const volatile void* Bench::s_sink = nullptr;
+
+    bool Bench::add(const BenchDesc& desc)
+    {
+        if (g_benchmark_count >= MAX_BENCHMARKS) return false;
+        g_benchmarks[g_benchmark_count++] = desc;
+        return true;
+    }
+
+    void Bench::fail(const char* name, const char* message)
+    {
+        fprintf(stderr, "[BENCH] ECHEC %s : %s\n", name, message);
+        ++g_failure_count;
+    }
+
+    U32 Bench::getFailureCount()
+    {
+        return g_failure_count;
+    }
+
+    U32 Bench::getCount()
+    {
+        return g_benchmark_count;
+    }
+
+    const BenchDesc& Bench::get(U32 index)
+    {
+        return g_benchmarks[index];
+    }
+
+    BenchOptions Bench::getDefaultOptions()
+    {
+        BenchOptions options = {};
+        options.filter = nullptr;
+        options.repetitions = 15;
+        options.warmupMs = 50.0;
+        options.minSampleMs = 5.0;
+        options.cpu = -1;
+        options.counters = true;
+        return options;
+    }
+
+    bool Bench::pinCurrentThread(I32 cpu)
+    {
+        if (cpu < 0) return false;
+#if defined(INGA_PLATFORM_WINDOWS)
+        if (cpu >= 64) return false;
+        return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#elif defined(INGA_PLATFORM_LINUX)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    // --- Mesure ---
+
+    static F64 runSample(const BenchDesc& desc, BenchState& state)
+    {
+        const U64 start = Time::now();
+        desc.run(state);
+        return (F64)Time::toNs(Time::now() - start);
+    }
+
+    /*
+     * Chauffe + calibration : on multiplie le nombre d'itérations jusqu'à ce
+     * qu'un échantillon dépasse minSampleMs, et on continue au moins warmupMs
+     * (caches, prédicteurs, fréquence du CPU).
+     */
+    static U64 calibrate(const BenchDesc& desc, BenchState& state, const BenchOptions& options)
+    {
+        const F64 targetNs = options.minSampleMs * 1e6;
+        const F64 warmupNs = options.warmupMs * 1e6;
+        F64 spentNs = 0.0;
+        state.iterations = 1;
+
+        for (;;)
+        {
+            const F64 elapsed = runSample(desc, state);
+            spentNs += elapsed;
+
+            if (elapsed >= targetNs)
+            {
+                if (spentNs >= warmupNs) return state.iterations;
+                continue;
+            }
+
+            // Extrapolation bornée : un premier échantillon très court est peu fiable
+            F64 factor = elapsed > 0.0 ? targetNs * 1.2 / elapsed : 10.0;
+            factor = factor < 2.0 ? 2.0 : (factor > 10.0 ? 10.0 : factor);
+            state.iterations = (U64)((F64)state.iterations * factor) + 1;
+        }
+    }
+
+    static void runOne(const BenchDesc& desc, const BenchOptions& options, PerfCounterGroup& perf, BenchResult& result)
+    {
+        BenchState state = { 0, nullptr };
+        if (desc.setup) desc.setup(state);
+
+        const U64 iterations = calibrate(desc, state, options);
+        const U32 samples = options.repetitions < g_bench_max_samples ? options.repetitions : g_bench_max_samples;
+
+        F64 perOp[g_bench_max_samples];
+        PerfCounterSample before = {}, after = {};
+        U64 cycles = 0, instructions = 0;
+        for (U32 s = 0; s < samples; ++s)
+        {
+            state.iterations = iterations;
+            perf.read(before);
+            perOp[s] = runSample(desc, state) / (F64)iterations;
+            perf.read(after);
+            cycles += after.values[ePERF_CYCLES] - before.values[ePERF_CYCLES];
+            instructions += after.values[ePERF_INSTRUCTIONS] - before.values[ePERF_INSTRUCTIONS];
+        }
+
+        if (desc.teardown) desc.teardown(state);
+
+        std::sort(perOp, perOp + samples);
+        F64 sum = 0.0;
+        for (U32 s = 0; s < samples; ++s) sum += perOp[s];
+        const F64 mean = sum / (F64)samples;
+        F64 variance = 0.0;
+        for (U32 s = 0; s < samples; ++s) variance += (perOp[s] - mean) * (perOp[s] - mean);
+
+        snprintf(result.name, sizeof(result.name), "%s", desc.name);
+        result.iterations = iterations;
+        result.samples = samples;
+        result.medianNs = samples % 2 ? perOp[samples / 2] : (perOp[samples / 2 - 1] + perOp[samples / 2]) * 0.5;
+        result.minNs = perOp[0];
+        result.meanNs = mean;
+        result.stddevNs = samples > 1 ? std::sqrt(variance / (F64)(samples - 1)) : 0.0;
+        result.p90Ns = perOp[(U32)((F64)(samples - 1) * 0.9)];
+        result.cycles = (F64)cycles / ((F64)iterations * (F64)samples);
+        result.instructions = (F64)instructions / ((F64)iterations * (F64)samples);
+    }
+
+    U32 Bench::run(const BenchOptions& options, BenchResult* results, U32 maxResults)
+    {
+        if (options.cpu >= 0 && !pinCurrentThread(options.cpu))
+        {
+            fprintf(stderr, "[BENCH] Impossible d'epingler le thread sur le coeur %d\n", options.cpu);
+        }
+
+        PerfCounterGroup perf;
+        if (options.counters && !perf.open())
+        {
+            fprintf(stderr, "[BENCH] Compteurs materiels indisponibles : temps seulement\n");
+        }
+
+        printf("%-40s %12s %12s %8s %14s %8s\n", "benchmark", "median", "min", "stddev", "iterations", "cycles");
+
+        U32 count = 0;
+        for (U32 i = 0; i < g_benchmark_count && count < maxResults; ++i)
+        {
+            const BenchDesc& desc = g_benchmarks[i];
+            if (options.filter && !strstr(desc.name, options.filter)) continue;
+
+            BenchResult& result = results[count++];
+            runOne(desc, options, perf, result);
+
+            printf("%-40s %9.2f ns %9.2f ns %7.1f%% %8llu x %-3u",
+                   result.name, result.medianNs, result.minNs,
+                   result.medianNs > 0.0 ? result.stddevNs * 100.0 / result.medianNs : 0.0,
+                   (unsigned long long)result.iterations, result.samples);
+            if (perf.isOpen()) printf(" %8.1f (IPC %.2f)", result.cycles, result.cycles > 0.0 ? result.instructions / result.cycles : 0.0);
+            printf("\n");
+            fflush(stdout);
+        }
+        return count;
+    }
+
+    // --- JSON ---
+
+    bool Bench::writeJson(const char* path, const BenchOptions& options, const BenchResult* results, U32 count)
+    {
+        FILE* out = fopen(path, "wt");
+        if (!out) return false;
+
+        fprintf(out, "{\n\"version\":1,\"repetitions\":%u,\"warmupMs\":%.1f,\"minSampleMs\":%.1f,\"cpu\":%d,\n\"benchmarks\":[\n",
+                options.repetitions, options.warmupMs, options.minSampleMs, options.cpu);
+
+        // Un benchmark par ligne : compare() relit le fichier ligne à ligne
+        for (U32 i = 0; i < count; ++i)
+        {
+            const BenchResult& r = results[i];
+            fprintf(out, "{\"name\":\"%s\",\"iterations\":%llu,\"samples\":%u,\"median_ns\":%.4f,\"min_ns\":%.4f,\"mean_ns\":%.4f,"
+                         "\"stddev_ns\":%.4f,\"p90_ns\":%.4f,\"cycles\":%.2f,\"instructions\":%.2f}%s\n",
+                    r.name, (unsigned long long)r.iterations, r.samples, r.medianNs, r.minNs, r.meanNs,
+                    r.stddevNs, r.p90Ns, r.cycles, r.instructions, i + 1 < count ? "," : "");
+        }
+
+        fputs("]\n}\n", out);
+        const bool ok = ferror(out) == 0;
+        fclose(out);
+        return ok;
+    }
+
+    struct BenchBaseline
+    {
+        char name[64];
+        F64 medianNs;
+        F64 minNs;
+    };
+
+    static bool readNumber(const char* line, const char* key, F64& value)
+    {
+        const char* found = strstr(line, key);
+        if (!found) return false;
+        value = strtod(found + strlen(key), nullptr);
+        return true;
+    }
+
+    static U32 readBaseline(FILE* in, BenchBaseline* entries, U32 maxEntries)
+    {
+        char line[1024];
+        U32 count = 0;
+        while (count < maxEntries && fgets(line, sizeof(line), in))
+        {
+            const char* name = strstr(line, "\"name\":\"");
+            if (!name) continue;
+            name += 8;
+            const char* end = strchr(name, '"');
+            if (!end) continue;
+
+            BenchBaseline& entry = entries[count];
+            const U32 length = (U32)(end - name) < sizeof(entry.name) - 1 ? (U32)(end - name) : (U32)sizeof(entry.name) - 1;
+            memcpy(entry.name, name, length);
+            entry.name[length] = '\0';
+            if (readNumber(line, "\"median_ns\":", entry.medianNs) && readNumber(line, "\"min_ns\":", entry.minNs)) ++count;
+        }
+        return count;
+    }
+
+    U32 Bench::compare(const char* baselinePath, const BenchResult* results, U32 count, F64 threshold)
+    {
+        FILE* in = fopen(baselinePath, "rt");
+        if (!in)
+        {
+            fprintf(stderr, "[BENCH] Impossible d'ouvrir la reference %s\n", baselinePath);
+            return 0;
+        }
+        static BenchBaseline baseline[MAX_BENCHMARKS];
+        const U32 baselineCount = readBaseline(in, baseline, MAX_BENCHMARKS);
+        fclose(in);
+
+        printf("\nComparaison avec %s (seuil %.1f%%)\n", baselinePath, threshold * 100.0);
+        printf("%-40s %12s %12s %9s\n", "benchmark", "reference", "actuel", "ecart");
+
+        U32 regressions = 0;
+        for (U32 i = 0; i < count; ++i)
+        {
+            const BenchResult& r = results[i];
+            const BenchBaseline* base = nullptr;
+            for (U32 b = 0; b < baselineCount && !base; ++b)
+            {
+                if (strcmp(baseline[b].name, r.name) == 0) base = &baseline[b];
+            }
+            if (!base || base->medianNs <= 0.0)
+            {
+                printf("%-40s %12s %9.2f ns %9s  nouveau\n", r.name, "-", r.medianNs, "-");
+                continue;
+            }
+
+            const F64 delta = (r.medianNs - base->medianNs) / base->medianNs;
+            const char* verdict = "";
+            if (delta > threshold && r.minNs > base->medianNs)
+            {
+                verdict = "REGRESSION";
+                ++regressions;
+            }
+            else if (delta > threshold)
+            {
+                verdict = "bruit ?";
+            }
+            else if (delta < -threshold && r.medianNs < base->minNs)
+            {
+                verdict = "plus rapide";
+            }
+            printf("%-40s %9.2f ns %9.2f ns %+8.1f%%  %s\n", r.name, base->medianNs, r.medianNs, delta * 100.0, verdict);
+        }
+
+        printf("%u regression(s)\n", regressions);
+        return regressions;
+    }
+}
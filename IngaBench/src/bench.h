@@ -0,0 +1,147 @@
+#ifndef INGA_BENCH_H
+#define INGA_BENCH_H
+
+#include <InGa/core/inga_platform.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/*
+ * Harnais de micro-benchmarks d'inga_bench.
+ *
+ *   INGA_BENCH("time/now")
+ *   {
+ *       for (U64 i = 0; i < state.iterations; ++i) Inga::Bench::keep(Inga::Time::now());
+ *   }
+ *
+ * Le corps reçoit "state" et doit exécuter state.iterations fois l'opération
+ * mesurée. Le nombre d'itérations est calibré pour qu'un échantillon dure au
+ * moins minSampleMs ; le résultat est le temps par opération sur plusieurs
+ * échantillons (médiane, min, moyenne, écart-type, p90).
+ *
+ * INGA_BENCH_FIXTURE ajoute un setup / teardown appelés une seule fois,
+ * hors mesure ; state.userData est libre pour les faire communiquer.
+ */
+
+// Dossier des logs écrits pendant les benchmarks (mode fichier uniquement)
+#define INGA_BENCH_LOG_FOLDER "bench_logs"
+
+namespace Inga
+{
+    struct BenchState
+    {
+        U64 iterations;
+        void* userData;
+    };
+
+    typedef void (*BenchFunction)(BenchState& state);
+
+    struct BenchDesc
+    {
+        const char* name;          // "module/cas" : le préfixe sert au filtre
+        BenchFunction run;
+        BenchFunction setup;
+        BenchFunction teardown;
+    };
+
+    struct BenchOptions
+    {
+        const char* filter;        // sous-chaîne du nom (nullptr = tout)
+        U32 repetitions;           // échantillons mesurés
+        F64 warmupMs;              // exécution à vide avant la calibration
+        F64 minSampleMs;           // durée minimum d'un échantillon
+        I32 cpu;                   // coeur sur lequel épingler le thread (-1 = aucun)
+        bool counters;             // cycles / instructions par opération (Linux, PMU)
+    };
+
+    // Résultat par opération (ns)
+    struct BenchResult
+    {
+        char name[64];
+        U64 iterations;            // par échantillon
+        U32 samples;
+        F64 medianNs;
+        F64 minNs;
+        F64 meanNs;
+        F64 stddevNs;
+        F64 p90Ns;
+        F64 cycles;                // 0 sans compteurs matériels
+        F64 instructions;
+    };
+
+    class Bench
+    {
+    public:
+        static const U32 MAX_BENCHMARKS = 256;
+
+        // Appelé par INGA_BENCH avant main()
+        static bool add(const BenchDesc& desc);
+
+        static U32 getCount();
+        static const BenchDesc& get(U32 index);
+
+        static BenchOptions getDefaultOptions();
+
+        // Lance les benchmarks retenus par le filtre ; retourne le nombre de résultats
+        static U32 run(const BenchOptions& options, BenchResult* results, U32 maxResults);
+
+        static bool pinCurrentThread(I32 cpu);
+
+        // Vérification ratée dans un benchmark (stress) : signalée, code de retour 1
+        static void fail(const char* name, const char* message);
+        static U32 getFailureCount();
+
+        static bool writeJson(const char* path, const BenchOptions& options, const BenchResult* results, U32 count);
+
+        /*
+         * Compare à un JSON écrit par writeJson. Régression : médiane plus lente
+         * que la référence de plus de threshold (0.05 = 5 %) et minimum lui-même
+         * au-dessus de la médiane de référence (sinon c'est du bruit).
+         * Retourne le nombre de régressions.
+         */
+        static U32 compare(const char* baselinePath, const BenchResult* results, U32 count, F64 threshold);
+
+        // Empêche le compilateur de supprimer un calcul dont le résultat n'est pas utilisé
+        template<typename T>
+        static inline void keep(const T& value)
+        {
+#if defined(_MSC_VER)
+            s_sink = (const volatile void*)&value;
+#else
+            __asm__ __volatile__("" : : "g"(&value) : "memory");
+#endif
+        }
+
+        // Barrière pour les écritures mémoire (le compilateur ne peut plus les ignorer)
+        static inline void clobber()
+        {
+#if defined(_MSC_VER)
+            _ReadWriteBarrier();
+#else
+            __asm__ __volatile__("" : : : "memory");
+#endif
+        }
+
+    private:
+        static const volatile void* s_sink;
+    };
+
+    struct BenchRegistrar
+    {
+        BenchRegistrar(const char* name, BenchFunction run, BenchFunction setup = nullptr, BenchFunction teardown = nullptr)
+        {
+            Bench::add(BenchDesc{ name, run, setup, teardown });
+        }
+    };
+}
+
+#define INGA_BENCH_IMPL(name, setup, teardown, id) \
+    static void INGA_CONCAT(_inga_bench_fn_, id)(Inga::BenchState& state); \
+    static Inga::BenchRegistrar INGA_CONCAT(_inga_bench_reg_, id)(name, INGA_CONCAT(_inga_bench_fn_, id), setup, teardown); \
+    static void INGA_CONCAT(_inga_bench_fn_, id)([[maybe_unused]] Inga::BenchState& state)
+
+#define INGA_BENCH(name) INGA_BENCH_IMPL(name, nullptr, nullptr, __COUNTER__)
+#define INGA_BENCH_FIXTURE(name, setup, teardown) INGA_BENCH_IMPL(name, setup, teardown, __COUNTER__)
+
+#endif
@@ -0,0 +1,61 @@
+#include "bench.h"
+#include <InGa/core/log.h>
+
+using namespace Inga;
+
+/*
+ * Chaque cas réouvre le Log dans son mode (fichier seulement, pas de
+ * terminal), puis revient à la configuration de main(). Les messages
+ * varient à chaque appel : la déduplication ne les fusionne pas.
+ */
+
+static void openBenchLog(LogMode mode, LogLevel level)
+{
+    Log::terminate();
+    Log::init(level, eFILEOUT, INGA_BENCH_LOG_FOLDER, mode, eLOG_BLOCK, 4096);
+    Log::setMaxFileSize(64 * 1024 * 1024);
+    Log::setMaxRotatedFiles(1);
+}
+
+static void setupLogSync(BenchState&)   { openBenchLog(eLOG_SYNC, eINFO); }
+static void setupLogAsync(BenchState&)  { openBenchLog(eLOG_ASYNC, eINFO); }
+static void setupLogBinary(BenchState&) { openBenchLog(eLOG_BINARY, eINFO); }
+static void restoreLog(BenchState&)     { openBenchLog(eLOG_SYNC, eWARNING); }
+
+// Niveau coupé à l'exécution : le test inline du macro, rien d'autre
+INGA_BENCH("log/filtered_runtime")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        INGA_LOG(eINFO, "BENCH", "filtered %llu", (unsigned long long)i);
+        Bench::clobber();
+    }
+}
+
+INGA_BENCH_FIXTURE("log/message_sync", setupLogSync, restoreLog)
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        Log::message(eINFO, "BENCH", nullptr, __FILE__, __FUNCTION__, __LINE__, "frame %llu : %u entities, %.3f ms",
+                     (unsigned long long)i, (U32)(i & 1023), 16.6);
+    }
+}
+
+// Débit soutenu : avec eLOG_BLOCK, le producteur finit par attendre le writer
+INGA_BENCH_FIXTURE("log/async_info", setupLogAsync, restoreLog)
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        INGA_LOG(eINFO, "BENCH", "frame %llu : %u entities, %.3f ms", (unsigned long long)i, (U32)(i & 1023), 16.6);
+    }
+    Log::flush();
+}
+
+INGA_BENCH_FIXTURE("log/binary_info", setupLogBinary, restoreLog)
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        INGA_LOG(eINFO, "BENCH", "frame %llu : %u entities, %.3f ms", (unsigned long long)i, (U32)(i & 1023), 16.6);
+    }
+    Log::flush();
+}
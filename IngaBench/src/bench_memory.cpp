@@ -0,0 +1,222 @@
+#include "bench.h"
+#include <InGa/core/allocator.h>
+#include <InGa/core/container.h>
+#include <InGa/core/offset_allocator.h>
+#include <InGa/core/soa_vector.h>
+#include <InGa/core/string.h>
+
+using namespace Inga;
+
+// --- Allocator ---
+
+INGA_BENCH("allocator/alloc_free_64")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        void* ptr = INGA_ALLOC(64);
+        Bench::keep(ptr);
+        INGA_FREE(ptr);
+    }
+}
+
+INGA_BENCH("allocator/alloc_free_4k")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        void* ptr = INGA_ALLOC(4096);
+        Bench::keep(ptr);
+        INGA_FREE(ptr);
+    }
+}
+
+// 64 blocs vivants en même temps : parcours de la liste libre et fusions
+INGA_BENCH("allocator/alloc_free_batch_64")
+{
+    void* ptrs[64];
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        for (U32 j = 0; j < 64; ++j) ptrs[j] = INGA_ALLOC(32 + j * 8);
+        Bench::keep(ptrs);
+        for (U32 j = 0; j < 64; ++j) INGA_FREE(ptrs[j]);
+    }
+}
+
+INGA_BENCH("allocator/realloc_grow_16_to_4k")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        void* ptr = INGA_ALLOC(16);
+        for (U64 size = 32; size <= 4096; size *= 2) ptr = INGA_REALLOC(ptr, size);
+        Bench::keep(ptr);
+        INGA_FREE(ptr);
+    }
+}
+
+INGA_BENCH("allocator/new_delete")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        U64* value = new U64(i);
+        Bench::keep(value);
+        delete value;
+    }
+}
+
+// --- OffsetAllocator ---
+
+static void setupOffsetAllocator(BenchState& state)
+{
+    OffsetAllocator* allocator = new OffsetAllocator();
+    allocator->init(1u << 20, 4096);
+    state.userData = allocator;
+}
+
+static void teardownOffsetAllocator(BenchState& state)
+{
+    delete (OffsetAllocator*)state.userData;
+}
+
+// 64 slots vivants de tailles variées : découpe puis fusion des voisins
+INGA_BENCH_FIXTURE("offset_allocator/alloc_free_batch_64", setupOffsetAllocator, teardownOffsetAllocator)
+{
+    OffsetAllocator& allocator = *(OffsetAllocator*)state.userData;
+    OffsetAllocation slots[64];
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        for (U32 j = 0; j < 64; ++j) slots[j] = allocator.allocate(16 + j * 24);
+        Bench::keep(slots);
+        for (U32 j = 0; j < 64; ++j) allocator.free(slots[j]);
+    }
+}
+
+// --- String ---
+
+INGA_BENCH("string/construct_short")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        String text("player");
+        Bench::keep(text);
+    }
+}
+
+INGA_BENCH("string/construct_long")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        String text("assets/textures/environment/terrain_albedo.ktx2");
+        Bench::keep(text);
+    }
+}
+
+INGA_BENCH("string/concat")
+{
+    const String folder("assets/textures/");
+    const String file("terrain_albedo.ktx2");
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        String path = folder + file;
+        Bench::keep(path);
+    }
+}
+
+INGA_BENCH("string/format")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        String text = StringFormat("entity %u at (%.2f, %.2f) : %s", (U32)i, 1.5, -3.25, "idle");
+        Bench::keep(text);
+    }
+}
+
+// --- Conteneurs (une opération = 1024 éléments) ---
+
+INGA_BENCH("container/vector_push_back_1k")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        Vector<U32> values;
+        for (U32 j = 0; j < 1024; ++j) values.push_back(j);
+        Bench::keep(values.data());
+    }
+}
+
+INGA_BENCH("container/vector_reserve_push_back_1k")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        Vector<U32> values;
+        values.reserve(1024);
+        for (U32 j = 0; j < 1024; ++j) values.push_back(j);
+        Bench::keep(values.data());
+    }
+}
+
+INGA_BENCH("container/unordered_map_insert_1k")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        UnorderedMap<U32, U32> map;
+        for (U32 j = 0; j < 1024; ++j) map[j * 2654435761u] = j;
+        Bench::keep(map);
+    }
+}
+
+static void setupLookupMap(BenchState& state)
+{
+    UnorderedMap<U32, U32>* map = new UnorderedMap<U32, U32>();
+    for (U32 j = 0; j < 4096; ++j) (*map)[j * 2654435761u] = j;
+    state.userData = map;
+}
+
+static void teardownLookupMap(BenchState& state)
+{
+    delete (UnorderedMap<U32, U32>*)state.userData;
+}
+
+// Une opération = une recherche dans 4096 entrées
+INGA_BENCH_FIXTURE("container/unordered_map_find", setupLookupMap, teardownLookupMap)
+{
+    const UnorderedMap<U32, U32>& map = *(const UnorderedMap<U32, U32>*)state.userData;
+    U32 found = 0;
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        found += map.count((U32)(i & 4095) * 2654435761u) ? 1 : 0;
+    }
+    Bench::keep(found);
+}
+
+INGA_BENCH("container/soa_vector_push_back_1k")
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        SoAVector<F32, F32, F32, U32> particles;
+        for (U32 j = 0; j < 1024; ++j) particles.push_back((F32)j, 0.0f, 1.0f, j);
+        Bench::keep(particles);
+    }
+}
+
+static void setupSoAColumns(BenchState& state)
+{
+    SoAVector<F32, F32, F32, U32>* particles = new SoAVector<F32, F32, F32, U32>();
+    for (U32 j = 0; j < 1024; ++j) particles->push_back((F32)j, (F32)(j & 7), 1.0f, j);
+    state.userData = particles;
+}
+
+static void teardownSoAColumns(BenchState& state)
+{
+    delete (SoAVector<F32, F32, F32, U32>*)state.userData;
+}
+
+// Parcours d'une colonne (vectorisable) : x += y sur 1024 éléments
+INGA_BENCH_FIXTURE("container/soa_column_update_1k", setupSoAColumns, teardownSoAColumns)
+{
+    SoAVector<F32, F32, F32, U32>& particles = *(SoAVector<F32, F32, F32, U32>*)state.userData;
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        std::span<F32> x = particles.column<0>();
+        std::span<const F32> y = particles.column<1>();
+        for (U32 j = 0; j < x.size(); ++j) x[j] += y[j];
+        Bench::clobber();
+    }
+}
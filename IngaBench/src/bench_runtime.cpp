@@ -0,0 +1,385 @@
+#include "bench.h"
+#include <InGa/core/clock.h>
+#include <InGa/core/frame_stats.h>
+#include <InGa/core/job.h>
+#include <InGa/core/perf_counters.h>
+#include <InGa/core/profiler.h>
+#include <InGa/core/queue.h>
+#include <InGa/core/thread.h>
+#include <InGa/core/time.h>
+#include <atomic>
+#include <thread>
+
+using namespace Inga;
+
+// --- Time / Thread ---
+
+INGA_BENCH("time/now")
+{
+    for (U64 i = 0; i < state.iterations; ++i) Bench::keep(Time::now());
+}
+
+INGA_BENCH("time/now_ns")
+{
+    for (U64 i = 0; i < state.iterations; ++i) Bench::keep(Time::nowNs());
+}
+
+INGA_BENCH("time/monotonic_ns")
+{
+    for (U64 i = 0; i < state.iterations; ++i) Bench::keep(Time::monotonicNs());
+}
+
+INGA_BENCH("thread/get_current_id")
+{
+    for (U64 i = 0; i < state.iterations; ++i) Bench::keep(Thread::getCurrentId());
+}
+
+// --- Clock / FrameStats ---
+
+static void setupClock(BenchState& state)
+{
+    state.userData = new Clock();
+}
+
+static void teardownClock(BenchState& state)
+{
+    delete (Clock*)state.userData;
+}
+
+INGA_BENCH_FIXTURE("clock/tick", setupClock, teardownClock)
+{
+    Clock& clock = *(Clock*)state.userData;
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        clock.tick();
+        Bench::keep(clock.getDeltaTime());
+    }
+}
+
+INGA_BENCH_FIXTURE("clock/fixed_step_frame", setupClock, teardownClock)
+{
+    Clock& clock = *(Clock*)state.userData;
+    clock.setFixedTimeStep(1.0 / 60.0);
+    U32 steps = 0;
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        clock.tick();
+        while (clock.consumeFixedStep()) ++steps;
+        Bench::keep(clock.getInterpolationAlpha());
+    }
+    Bench::keep(steps);
+}
+
+static void setupFrameStats(BenchState& state)
+{
+    FrameStats* stats = new FrameStats();
+    for (U32 i = 0; i < FrameStats::WINDOW_SIZE; ++i) stats->addFrame(16000000ull + (i % 97) * 25000ull);
+    state.userData = stats;
+}
+
+static void teardownFrameStats(BenchState& state)
+{
+    delete (FrameStats*)state.userData;
+}
+
+INGA_BENCH_FIXTURE("frame_stats/add_frame", setupFrameStats, teardownFrameStats)
+{
+    FrameStats& stats = *(FrameStats*)state.userData;
+    for (U64 i = 0; i < state.iterations; ++i) stats.addFrame(16000000ull + (i % 97) * 25000ull);
+}
+
+INGA_BENCH_FIXTURE("frame_stats/summary", setupFrameStats, teardownFrameStats)
+{
+    const FrameStats& stats = *(const FrameStats*)state.userData;
+    for (U64 i = 0; i < state.iterations; ++i) Bench::keep(stats.getSummary());
+}
+
+// --- Queues (aller-retour sur un seul thread : coût sans contention) ---
+
+static void setupSpsc(BenchState& state)
+{
+    SpscRing<U64>* ring = new SpscRing<U64>();
+    ring->init(1024);
+    state.userData = ring;
+}
+
+static void teardownSpsc(BenchState& state)
+{
+    delete (SpscRing<U64>*)state.userData;
+}
+
+INGA_BENCH_FIXTURE("queue/spsc_push_pop", setupSpsc, teardownSpsc)
+{
+    SpscRing<U64>& ring = *(SpscRing<U64>*)state.userData;
+    U64 value = 0;
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        ring.push(i);
+        ring.pop(value);
+    }
+    Bench::keep(value);
+}
+
+static void setupMpmc(BenchState& state)
+{
+    MpmcQueue<U64>* queue = new MpmcQueue<U64>();
+    queue->init(1024);
+    state.userData = queue;
+}
+
+static void teardownMpmc(BenchState& state)
+{
+    delete (MpmcQueue<U64>*)state.userData;
+}
+
+INGA_BENCH_FIXTURE("queue/mpmc_push_pop", setupMpmc, teardownMpmc)
+{
+    MpmcQueue<U64>& queue = *(MpmcQueue<U64>*)state.userData;
+    U64 value = 0;
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        queue.push(i);
+        queue.pop(value);
+    }
+    Bench::keep(value);
+}
+
+/*
+ * Stress sous contention : N producteurs / M consommateurs sur une petite queue
+ * (pleine et vide en permanence). Chaque élément porte (producteur, séquence) ;
+ * on vérifie le nombre d'éléments, la somme des séquences par producteur (chaque
+ * élément reçu une fois) et, pour chaque consommateur, l'ordre croissant des
+ * séquences d'un même producteur. Temps par élément transféré.
+ */
+static const U32 g_stress_max_threads = 8;
+
+// Attente active courte puis yield : plus de threads que de coeurs ne doit pas tout bloquer
+static inline void stressBackoff(U32& spins)
+{
+    if (++spins < 64) Thread::spinPause();
+    else
+    {
+        Thread::yield();
+        spins = 0;
+    }
+}
+
+struct QueueStressResult
+{
+    U64 count[g_stress_max_threads];        // par producteur
+    U64 sequenceSum[g_stress_max_threads];
+    bool ordered;
+};
+
+template<typename Queue>
+static void runQueueStress(const char* name, Queue& queue, U32 producers, U32 consumers, U64 items)
+{
+    const U64 perProducer = (items + producers - 1) / producers;
+    const U64 total = perProducer * producers;
+    std::atomic<U64> consumed{0};
+    QueueStressResult perConsumer[g_stress_max_threads] = {};
+
+    std::thread threads[2 * g_stress_max_threads];
+    for (U32 c = 0; c < consumers; ++c)
+    {
+        threads[producers + c] = std::thread([&, c]()
+        {
+            QueueStressResult& result = perConsumer[c];
+            U64 last[g_stress_max_threads];
+            for (U32 p = 0; p < producers; ++p) last[p] = ~0ull;
+            result.ordered = true;
+
+            U64 value;
+            U32 spins = 0;
+            while (consumed.load(std::memory_order_relaxed) < total)
+            {
+                if (!queue.pop(value))
+                {
+                    stressBackoff(spins);
+                    continue;
+                }
+                consumed.fetch_add(1, std::memory_order_relaxed);
+
+                const U32 p = (U32)(value >> 48);
+                const U64 sequence = value & ((1ull << 48) - 1);
+                if (p >= producers) { result.ordered = false; continue; }
+                if (last[p] != ~0ull && sequence <= last[p]) result.ordered = false;
+                last[p] = sequence;
+                ++result.count[p];
+                result.sequenceSum[p] += sequence;
+            }
+        });
+    }
+    for (U32 p = 0; p < producers; ++p)
+    {
+        threads[p] = std::thread([&, p]()
+        {
+            U32 spins = 0;
+            for (U64 i = 0; i < perProducer; ++i)
+            {
+                const U64 value = ((U64)p << 48) | i;
+                while (!queue.push(value)) stressBackoff(spins);
+            }
+        });
+    }
+    for (U32 i = 0; i < producers + consumers; ++i) threads[i].join();
+
+    const U64 expectedSum = perProducer * (perProducer - 1) / 2;
+    for (U32 p = 0; p < producers; ++p)
+    {
+        U64 count = 0;
+        U64 sum = 0;
+        for (U32 c = 0; c < consumers; ++c)
+        {
+            count += perConsumer[c].count[p];
+            sum += perConsumer[c].sequenceSum[p];
+        }
+        if (count != perProducer || sum != expectedSum)
+        {
+            Bench::fail(name, "element perdu ou duplique");
+            return;
+        }
+    }
+    for (U32 c = 0; c < consumers; ++c)
+    {
+        if (!perConsumer[c].ordered)
+        {
+            Bench::fail(name, "ordre d'un producteur non respecte");
+            return;
+        }
+    }
+    U64 value;
+    if (queue.pop(value)) Bench::fail(name, "element en trop dans la queue");
+}
+
+static void setupSpscSmall(BenchState& state)
+{
+    SpscRing<U64>* ring = new SpscRing<U64>();
+    ring->init(64);
+    state.userData = ring;
+}
+
+static void setupMpmcSmall(BenchState& state)
+{
+    MpmcQueue<U64>* queue = new MpmcQueue<U64>();
+    queue->init(64);
+    state.userData = queue;
+}
+
+INGA_BENCH_FIXTURE("queue/spsc_stress_1p1c", setupSpscSmall, teardownSpsc)
+{
+    runQueueStress("queue/spsc_stress_1p1c", *(SpscRing<U64>*)state.userData, 1, 1, state.iterations);
+}
+
+INGA_BENCH_FIXTURE("queue/mpmc_stress_4p4c", setupMpmcSmall, teardownMpmc)
+{
+    runQueueStress("queue/mpmc_stress_4p4c", *(MpmcQueue<U64>*)state.userData, 4, 4, state.iterations);
+}
+
+INGA_BENCH_FIXTURE("queue/mpmc_stress_1p4c", setupMpmcSmall, teardownMpmc)
+{
+    runQueueStress("queue/mpmc_stress_1p4c", *(MpmcQueue<U64>*)state.userData, 1, 4, state.iterations);
+}
+
+INGA_BENCH_FIXTURE("queue/mpmc_stress_4p1c", setupMpmcSmall, teardownMpmc)
+{
+    runQueueStress("queue/mpmc_stress_4p1c", *(MpmcQueue<U64>*)state.userData, 4, 1, state.iterations);
+}
+
+// --- JobSystem ---
+
+static void setupJobs(BenchState&)
+{
+    JobSystem::start(0);
+}
+
+static void teardownJobs(BenchState&)
+{
+    JobSystem::stop();
+}
+
+static void emptyJob(void*)
+{
+}
+
+INGA_BENCH_FIXTURE("job/run_wait_empty", setupJobs, teardownJobs)
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        JobCounter counter;
+        JobSystem::run(JobDecl{ emptyJob, nullptr }, &counter);
+        JobSystem::wait(&counter);
+    }
+}
+
+// Une opération = un parallelFor de 4096 index en lots de 256
+INGA_BENCH_FIXTURE("job/parallel_for_4k", setupJobs, teardownJobs)
+{
+    static U32 values[4096];
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        JobSystem::parallelFor(4096, 256, [](U32 index) { values[index] = values[index] * 3 + 1; });
+    }
+    Bench::keep(values);
+}
+
+// --- Profiler ---
+
+static void setupProfiler(BenchState&)
+{
+    Profiler::start();
+}
+
+static void teardownProfiler(BenchState&)
+{
+    Profiler::stop();
+}
+
+// endFrame toutes les 1024 zones : le coût d'agrégation est inclus, amorti
+INGA_BENCH_FIXTURE("profiler/zone", setupProfiler, teardownProfiler)
+{
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        {
+            INGA_PROFILE_ZONE("bench");
+        }
+        if ((i & 1023) == 1023) Profiler::endFrame();
+    }
+    Profiler::endFrame();
+}
+
+INGA_BENCH_FIXTURE("profiler/zone_disabled", setupProfiler, teardownProfiler)
+{
+    Profiler::setEnabled(false);
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        INGA_PROFILE_ZONE("bench");
+        Bench::clobber();
+    }
+    Profiler::setEnabled(true);
+}
+
+// --- Compteurs matériels (sans PMU, mesure le repli) ---
+
+static void setupPerfCounters(BenchState& state)
+{
+    PerfCounterGroup* group = new PerfCounterGroup();
+    group->open();
+    state.userData = group;
+}
+
+static void teardownPerfCounters(BenchState& state)
+{
+    delete (PerfCounterGroup*)state.userData;
+}
+
+INGA_BENCH_FIXTURE("perf_counters/read", setupPerfCounters, teardownPerfCounters)
+{
+    const PerfCounterGroup& group = *(const PerfCounterGroup*)state.userData;
+    PerfCounterSample sample;
+    for (U64 i = 0; i < state.iterations; ++i)
+    {
+        group.read(sample);
+        Bench::keep(sample);
+    }
+}
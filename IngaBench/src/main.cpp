@@ -0,0 +1,96 @@
+#include "bench.h"
+#include <InGa/core/allocator.h>
+#include <InGa/core/log.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * inga_bench : micro-benchmarks des modules core.
+ *
+ *   inga_bench [--filter log/] [--repetitions 15] [--warmup 50] [--min-time 5]
+ *              [--cpu 2] [--no-counters] [--json out.json]
+ *              [--compare reference.json] [--threshold 5] [--list]
+ *
+ * --json écrit les résultats (un benchmark par ligne) ; --compare relit un
+ * fichier écrit par --json et signale les régressions (code de retour 1).
+ * Pour des mesures stables : --cpu sur un coeur isolé, gouverneur "performance".
+ */
+
+using namespace Inga;
+
+static void usage(const char* program)
+{
+    fprintf(stderr,
+            "usage: %s [--filter <texte>] [--repetitions <n>] [--warmup <ms>] [--min-time <ms>]\n"
+            "          [--cpu <coeur>] [--no-counters] [--json <fichier>]\n"
+            "          [--compare <reference.json>] [--threshold <%%>] [--list]\n",
+            program);
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options = Bench::getDefaultOptions();
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    F64 threshold = 5.0;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (strcmp(arg, "--filter") == 0 && hasValue)           options.filter = argv[++i];
+        else if (strcmp(arg, "--repetitions") == 0 && hasValue) options.repetitions = (U32)atoi(argv[++i]);
+        else if (strcmp(arg, "--warmup") == 0 && hasValue)      options.warmupMs = atof(argv[++i]);
+        else if (strcmp(arg, "--min-time") == 0 && hasValue)    options.minSampleMs = atof(argv[++i]);
+        else if (strcmp(arg, "--cpu") == 0 && hasValue)         options.cpu = atoi(argv[++i]);
+        else if (strcmp(arg, "--no-counters") == 0)             options.counters = false;
+        else if (strcmp(arg, "--json") == 0 && hasValue)        jsonPath = argv[++i];
+        else if (strcmp(arg, "--compare") == 0 && hasValue)     baselinePath = argv[++i];
+        else if (strcmp(arg, "--threshold") == 0 && hasValue)   threshold = atof(argv[++i]);
+        else if (strcmp(arg, "--list") == 0)                    list = true;
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.repetitions == 0) options.repetitions = 1;
+    if (options.minSampleMs <= 0.0) options.minSampleMs = 1.0;
+
+    if (list)
+    {
+        for (U32 i = 0; i < Bench::getCount(); ++i)
+        {
+            const char* name = Bench::get(i).name;
+            if (!options.filter || strstr(name, options.filter)) printf("%s\n", name);
+        }
+        return 0;
+    }
+
+    if (!Allocator::start(64, 64 * 1024 * 1024)) return 1;
+    Log::init(eWARNING, eFILEOUT, INGA_BENCH_LOG_FOLDER);
+
+    // Hors de la pile : le tableau est gros et ne doit pas passer par l'allocateur
+    static BenchResult results[Bench::MAX_BENCHMARKS];
+    const U32 count = Bench::run(options, results, Bench::MAX_BENCHMARKS);
+
+    int result = 0;
+    if (jsonPath)
+    {
+        if (Bench::writeJson(jsonPath, options, results, count)) printf("\nResultats ecrits dans %s\n", jsonPath);
+        else
+        {
+            fprintf(stderr, "[BENCH] Impossible d'ecrire %s\n", jsonPath);
+            result = 1;
+        }
+    }
+    if (baselinePath && Bench::compare(baselinePath, results, count, threshold / 100.0) > 0) result = 1;
+    if (Bench::getFailureCount() > 0) result = 1;
+
+    Log::terminate();
+    Allocator::stop();
+    return result;
+}
@@ -2,6 +2,7 @@
 #include <InGa/gfx/RenderDevice.h>
 #include <InGa/gfx/Context.h>
 #include <InGa/core/log.h>
+#include <InGa/core/profiler.h>
 #include <InGa/InGa.h>
 
 using namespace Inga;
@@ -25,6 +26,22 @@ I32 main(I32 argc, char** argv)
     ctx2.initialize(&sharedGPU, config2);
     */
     U32 frameCount = 0;
+    ctx1.setClearColor(0.05f, 0.05f, 0.08f);
+    while (ctx1.isOpen())
+    {
+        ctx1.update();
+        ctx1.draw();
+        // Une seule fin de frame profiler par tour de boucle, quel que soit le nombre de contextes
+        INGA_PROFILE_FRAME();
+        ++frameCount;
+    }
+
+    // Attente CPU élevée = GPU (ou vsync) limitant ; proche de zéro = CPU limitant
+    FrameStatsSummary waits = ctx1.getCpuWaitStats().getSummary();
+    INGA_LOG(eINFO, "DEMO", "%u frames, CPU wait p50 %.2f ms / p99 %.2f ms.", frameCount, waits.p50Ms, waits.p99Ms);
+
+    ctx1.cleanup();
+    sharedGPU.shutdown();
 
     INGA_LOG(eINFO, "DEMO", "Shutdown complete. Goodbye.");
     INGA_END()
@@ -0,0 +1,379 @@
+#include <InGa/core/log_format.h>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * inga_logdecode : convertit un log binaire (.ilog, mode eLOG_BINARY) en texte.
+ *
+ *   inga_logdecode inga_2025_01_01_12_00_00.ilog [sortie.log]
+ *
+ * Accepte aussi les fichiers circulaires de MappedRingFileSink : les lignes
+ * sont remises dans l'ordre (la plus ancienne, coupée, est ignorée).
+ *
+ * Le format des lignes reprend celui du fichier texte du moteur, avec le
+ * temps à la milliseconde et l'id du thread émetteur.
+ */
+
+using namespace Inga;
+
+struct Site
+{
+    I32 line;
+    std::string tag;
+    std::string file;
+    std::string func;
+    std::string fmt;
+};
+
+struct Arg
+{
+    U8 type;
+    U64 raw;
+    std::string text;
+};
+
+static const char* LevelStringsPlain[] =
+{
+    "VERBOSE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL"
+};
+
+static bool readExact(FILE* in, void* dst, size_t size)
+{
+    return size == 0 || fread(dst, 1, size, in) == size;
+}
+
+static bool readString(FILE* in, U16 length, std::string& out)
+{
+    out.resize(length);
+    return readExact(in, out.data(), length);
+}
+
+static bool decodeArgs(const U8* payload, U32 size, U8 argCount, std::vector<Arg>& args)
+{
+    args.clear();
+    const U8* cursor = payload;
+    const U8* end = payload + size;
+
+    for (U8 i = 0; i < argCount; ++i)
+    {
+        if (cursor >= end) return false;
+        Arg arg = {};
+        arg.type = *cursor++;
+
+        if (arg.type == eBINARG_STRING)
+        {
+            U16 length;
+            if (cursor + 2 > end) return false;
+            memcpy(&length, cursor, 2);
+            cursor += 2;
+            if (cursor + length > end) return false;
+            arg.text.assign((const char*)cursor, length);
+            cursor += length;
+        }
+        else
+        {
+            if (cursor + 8 > end) return false;
+            memcpy(&arg.raw, cursor, 8);
+            cursor += 8;
+        }
+        args.push_back(std::move(arg));
+    }
+    return true;
+}
+
+// Formate un argument selon sa conversion printf (spec = "%...", sans modificateur de longueur)
+static void formatArg(std::string& out, std::string spec, char conversion, const Arg* arg)
+{
+    char buffer[512];
+    int length = 0;
+
+    if (!arg)
+    {
+        out += "<missing>";
+        return;
+    }
+
+    switch (arg->type)
+    {
+        case eBINARG_STRING:
+            spec += 's';
+            length = snprintf(buffer, sizeof(buffer), spec.c_str(), arg->text.c_str());
+            break;
+
+        case eBINARG_FLOAT:
+        {
+            F64 value;
+            memcpy(&value, &arg->raw, 8);
+            if (!strchr("fFeEgGaA", conversion)) conversion = 'g';
+            spec += conversion;
+            length = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+            break;
+        }
+
+        case eBINARG_POINTER:
+            spec += 'p';
+            length = snprintf(buffer, sizeof(buffer), spec.c_str(), (void*)(uintptr_t)arg->raw);
+            break;
+
+        case eBINARG_INT:
+        case eBINARG_UINT:
+        default:
+            if (conversion == 'c')
+            {
+                spec += 'c';
+                length = snprintf(buffer, sizeof(buffer), spec.c_str(), (int)arg->raw);
+            }
+            else if (strchr("fFeEgGaA", conversion))
+            {
+                spec += conversion;
+                length = snprintf(buffer, sizeof(buffer), spec.c_str(),
+                                  arg->type == eBINARG_INT ? (F64)(I64)arg->raw : (F64)arg->raw);
+            }
+            else
+            {
+                if (!strchr("diouxX", conversion)) conversion = arg->type == eBINARG_INT ? 'd' : 'u';
+                spec += "ll";
+                spec += conversion;
+                length = snprintf(buffer, sizeof(buffer), spec.c_str(), (long long)arg->raw);
+            }
+            break;
+    }
+
+    if (length > 0) out.append(buffer, length < (int)sizeof(buffer) ? (size_t)length : sizeof(buffer) - 1);
+}
+
+// Réapplique le format printf du site aux arguments enregistrés
+static std::string formatMessage(const std::string& fmt, const std::vector<Arg>& args)
+{
+    std::string out;
+    size_t argIndex = 0;
+
+    for (size_t i = 0; i < fmt.size(); ++i)
+    {
+        if (fmt[i] != '%')
+        {
+            out += fmt[i];
+            continue;
+        }
+        if (i + 1 < fmt.size() && fmt[i + 1] == '%')
+        {
+            out += '%';
+            ++i;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion
+        std::string spec = "%";
+        size_t j = i + 1;
+        while (j < fmt.size() && strchr("-+ #0", fmt[j])) spec += fmt[j++];
+        for (int part = 0; part < 2; ++part)
+        {
+            if (part == 1)
+            {
+                if (j >= fmt.size() || fmt[j] != '.') break;
+                spec += fmt[j++];
+            }
+            if (j < fmt.size() && fmt[j] == '*')
+            {
+                const Arg* star = argIndex < args.size() ? &args[argIndex++] : nullptr;
+                spec += std::to_string(star ? (long long)star->raw : 0);
+                ++j;
+            }
+            while (j < fmt.size() && fmt[j] >= '0' && fmt[j] <= '9') spec += fmt[j++];
+        }
+        while (j < fmt.size() && strchr("hlLqjzt", fmt[j])) ++j;
+        if (j >= fmt.size()) break;
+
+        const char conversion = fmt[j];
+        const Arg* arg = argIndex < args.size() ? &args[argIndex++] : nullptr;
+        formatArg(out, spec, conversion, arg);
+        i = j;
+    }
+    return out;
+}
+
+// Fichier de MappedRingFileSink : RingFileHeader + zone circulaire de texte
+static int decodeRingFile(FILE* in, FILE* out, const char* path)
+{
+    RingFileHeader header;
+    if (!readExact(in, &header, sizeof(header)) || header.version != INGA_RINGLOG_VERSION ||
+        header.capacity == 0 || fseek(in, (long)header.headerSize, SEEK_SET) != 0)
+    {
+        fprintf(stderr, "[LOGDECODE] En-tete de fichier circulaire invalide : %s\n", path);
+        return 1;
+    }
+
+    std::vector<char> data((size_t)header.capacity);
+    if (!readExact(in, data.data(), data.size()))
+    {
+        fprintf(stderr, "[LOGDECODE] Fichier circulaire tronque : %s\n", path);
+        return 2;
+    }
+
+    const bool wrapped = header.writeOffset > header.capacity;
+    const U64 start = wrapped ? header.writeOffset % header.capacity : 0;
+    const U64 size = wrapped ? header.capacity : header.writeOffset;
+
+    std::string text;
+    text.reserve((size_t)size);
+    for (U64 i = 0; i < size; ++i) text += data[(size_t)((start + i) % header.capacity)];
+
+    // Après un tour complet, la première ligne a été partiellement écrasée
+    size_t begin = 0;
+    if (wrapped)
+    {
+        size_t newline = text.find('\n');
+        begin = newline == std::string::npos ? text.size() : newline + 1;
+    }
+    fwrite(text.data() + begin, 1, text.size() - begin, out);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <log.ilog> [output.log]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = fopen(argv[1], "rb");
+    if (!in)
+    {
+        fprintf(stderr, "[LOGDECODE] Impossible d'ouvrir %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc >= 3)
+    {
+        out = fopen(argv[2], "wt");
+        if (!out)
+        {
+            fprintf(stderr, "[LOGDECODE] Impossible de creer %s\n", argv[2]);
+            fclose(in);
+            return 1;
+        }
+    }
+
+    char magic[8];
+    if (readExact(in, magic, sizeof(magic)) && memcmp(magic, INGA_RINGLOG_MAGIC, sizeof(magic)) == 0)
+    {
+        rewind(in);
+        int result = decodeRingFile(in, out, argv[1]);
+        fclose(in);
+        if (out != stdout) fclose(out);
+        return result;
+    }
+    rewind(in);
+
+    BinLogFileHeader fileHeader;
+    if (!readExact(in, &fileHeader, sizeof(fileHeader)) ||
+        memcmp(fileHeader.magic, INGA_BINLOG_MAGIC, sizeof(fileHeader.magic)) != 0)
+    {
+        fprintf(stderr, "[LOGDECODE] %s n'est pas un log binaire ou circulaire InGa\n", argv[1]);
+        fclose(in);
+        if (out != stdout) fclose(out);
+        return 1;
+    }
+    if (fileHeader.version != INGA_BINLOG_VERSION)
+    {
+        fprintf(stderr, "[LOGDECODE] Version %u non supportee (attendu %u)\n", fileHeader.version, INGA_BINLOG_VERSION);
+        fclose(in);
+        if (out != stdout) fclose(out);
+        return 1;
+    }
+
+    std::unordered_map<U32, Site> sites;
+    std::vector<U8> payload;
+    std::vector<Arg> args;
+    U64 messageCount = 0;
+    bool truncated = false;
+
+    for (;;)
+    {
+        U8 kind;
+        if (!readExact(in, &kind, 1)) break;
+
+        if (kind == eBINLOG_SITE)
+        {
+            BinLogSiteHeader header;
+            header.kind = kind;
+            Site site;
+            if (!readExact(in, (U8*)&header + 1, sizeof(header) - 1) ||
+                !readString(in, header.tagLength, site.tag) ||
+                !readString(in, header.fileLength, site.file) ||
+                !readString(in, header.funcLength, site.func) ||
+                !readString(in, header.fmtLength, site.fmt))
+            {
+                truncated = true;
+                break;
+            }
+            site.line = header.line;
+            sites[header.siteId] = std::move(site);
+        }
+        else if (kind == eBINLOG_MESSAGE)
+        {
+            BinLogMessageHeader header;
+            header.kind = kind;
+            if (!readExact(in, (U8*)&header + 1, sizeof(header) - 1))
+            {
+                truncated = true;
+                break;
+            }
+            payload.resize(header.payloadSize);
+            if (!readExact(in, payload.data(), header.payloadSize))
+            {
+                truncated = true;
+                break;
+            }
+
+            // Temps : date de départ + délai monotone depuis le démarrage
+            const U64 elapsedNs = header.timestampNs - fileHeader.startTimestampNs;
+            time_t seconds = (time_t)(fileHeader.startWallTimeSec + (I64)(elapsedNs / 1000000000ull));
+            const U32 millis = (U32)((elapsedNs / 1000000ull) % 1000);
+            struct tm* ts = localtime(&seconds);
+            char tBuf[16];
+            strftime(tBuf, sizeof(tBuf), "%H:%M:%S", ts);
+
+            const char* level = header.level < 6 ? LevelStringsPlain[header.level] : "?";
+
+            auto found = sites.find(header.siteId);
+            if (found == sites.end())
+            {
+                fprintf(out, "[%s.%03u][%s][?] (T%u) <site %u inconnu>\n", tBuf, millis, level, header.threadId, header.siteId);
+                ++messageCount;
+                continue;
+            }
+
+            const Site& site = found->second;
+            std::string text = decodeArgs(payload.data(), header.payloadSize, header.argCount, args)
+                             ? formatMessage(site.fmt, args)
+                             : std::string("<arguments corrompus>");
+
+            fprintf(out, "[%s.%03u][%s][%s] (%s | %s:%d | T%u) %s\n",
+                    tBuf, millis, level, site.tag.c_str(), site.func.c_str(), site.file.c_str(),
+                    site.line, header.threadId, text.c_str());
+            ++messageCount;
+        }
+        else
+        {
+            fprintf(stderr, "[LOGDECODE] Enregistrement inconnu (%u) a l'offset %ld\n", kind, ftell(in) - 1);
+            truncated = true;
+            break;
+        }
+    }
+
+    if (truncated)
+    {
+        fprintf(stderr, "[LOGDECODE] Fichier tronque : %llu messages decodes\n", (unsigned long long)messageCount);
+    }
+
+    fclose(in);
+    if (out != stdout) fclose(out);
+    return truncated ? 2 : 0;
+}